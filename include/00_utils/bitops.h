@@ -0,0 +1,132 @@
+#ifndef MINIATURE_STL_BITOPS_H
+#define MINIATURE_STL_BITOPS_H
+
+// 这个头文件包含了一些位运算与编译器内建函数的封装
+// 主要供需要手动优化的算法与容器使用
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace mystl
+{
+
+// 预取：提示 CPU 提前把 addr 所在的缓存行读入缓存，不会产生访存异常
+#if defined(__GNUC__) || defined(__clang__)
+#define MYSTL_PREFETCH(addr) __builtin_prefetch((const void*)(addr))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define MYSTL_PREFETCH(addr) _mm_prefetch((const char*)(addr), _MM_HINT_T0)
+#else
+#define MYSTL_PREFETCH(addr) ((void)(addr))
+#endif
+
+// 缓存行大小
+const size_t cache_line_size = 64;
+
+// 计算末尾连续 0 的个数，x 为 0 时返回 64
+inline int countr_zero64(uint64_t x) noexcept
+{
+    if (x == 0)
+    {
+        return 64;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    int n = 0;
+    while ((x & 1) == 0)
+    {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// 计算末尾连续 1 的个数
+inline int countr_one64(uint64_t x) noexcept
+{
+    return mystl::countr_zero64(~x);
+}
+
+// 计算开头连续 0 的个数，x 为 0 时返回 64
+inline int countl_zero64(uint64_t x) noexcept
+{
+    if (x == 0)
+    {
+        return 64;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return 63 - static_cast<int>(index);
+#else
+    int n = 0;
+    while ((x & (static_cast<uint64_t>(1) << 63)) == 0)
+    {
+        x <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// 计算二进制表示中 1 的个数
+inline int popcount64(uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<int>((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+// 循环左移，r 取 [0, 64)
+inline uint64_t rotl64(uint64_t x, int r) noexcept
+{
+    return (x << (r & 63)) | (x >> ((64 - r) & 63));
+}
+
+// 循环右移，r 取 [0, 64)
+inline uint64_t rotr64(uint64_t x, int r) noexcept
+{
+    return (x >> (r & 63)) | (x << ((64 - r) & 63));
+}
+
+// 64 位乘法的完整 128 位结果，返回低 64 位，高 64 位写入 hi
+inline uint64_t mul64x64_128(uint64_t a, uint64_t b, uint64_t* hi) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    *hi = static_cast<uint64_t>(r >> 64);
+    return static_cast<uint64_t>(r);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, hi);
+#else
+    const uint64_t a_lo = a & 0xffffffffu, a_hi = a >> 32;
+    const uint64_t b_lo = b & 0xffffffffu, b_hi = b >> 32;
+    const uint64_t ll = a_lo * b_lo;
+    const uint64_t lh = a_lo * b_hi;
+    const uint64_t hl = a_hi * b_lo;
+    const uint64_t hh = a_hi * b_hi;
+    const uint64_t mid = (ll >> 32) + (lh & 0xffffffffu) + (hl & 0xffffffffu);
+    *hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    return (mid << 32) | (ll & 0xffffffffu);
+#endif
+}
+
+}  // end namespace mystl
+
+#endif  // end MINIATURE_STL_BITOPS_H
@@ -0,0 +1,194 @@
+#ifndef MINIATURE_STL_PARALLEL_H
+#define MINIATURE_STL_PARALLEL_H
+
+// 这个头文件包含了并行算法使用的执行策略，以及在多个线程上分块执行任务的工具函数
+
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace mystl
+{
+
+// 执行策略：作为算法的第一个参数，seq 表示在当前线程顺序执行，par 表示可以分块在多个线程上执行
+namespace execution
+{
+
+struct sequenced_policy {};
+struct parallel_policy {};
+
+constexpr sequenced_policy seq{};
+constexpr parallel_policy  par{};
+
+}  // end namespace execution
+
+template <class Type>
+struct is_execution_policy : public std::false_type {};
+
+template <>
+struct is_execution_policy<execution::sequenced_policy> : public std::true_type {};
+
+template <>
+struct is_execution_policy<execution::parallel_policy> : public std::true_type {};
+
+// 每个线程至少处理的元素个数，元素更少时多开线程得不偿失
+const size_t parallel_min_grain = 16384;
+
+// 处理 n 个元素应使用的线程数，不超过硬件线程数
+inline size_t parallel_thread_count(size_t n, size_t grain = parallel_min_grain)
+{
+    size_t hw = std::thread::hardware_concurrency();
+    hw = hw != 0 ? hw : 1;
+    const size_t want = grain != 0 ? n / grain : n;
+    return want == 0 ? 1 : (want < hw ? want : hw);
+}
+
+// 自旋等待时提示 CPU 正处于忙等循环，降低功耗，并把执行资源让给同一核心上的另一个超线程
+inline void cpu_relax() noexcept
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#endif
+}
+
+// 将 n 个元素平均分为 parts 块，返回第 t 块的起始下标，第 t 块为 [begin(t), begin(t + 1))
+inline size_t parallel_chunk_begin(size_t n, size_t parts, size_t t)
+{
+    const size_t rem = n % parts;
+    return n / parts * t + (t < rem ? t : rem);
+}
+
+// 在 n 个线程上分别执行 f(t)，t 取 [0, n)，其中 t = 0 在当前线程上执行
+// 等待全部任务结束后返回；若有任务抛出异常，重新抛出编号最小的那一个
+// 线程创建失败时，未能启动的任务改在当前线程上依次执行，保证每个任务都恰好执行一次
+template <class Func>
+void parallel_invoke_n(size_t n, Func f)
+{
+    if (n == 0)
+    {
+        return;
+    }
+    if (n == 1)
+    {
+        f(static_cast<size_t>(0));
+        return;
+    }
+
+    std::exception_ptr* errors = new std::exception_ptr[n];
+    auto work = [&f, errors](size_t t)
+    {
+        try
+        {
+            f(t);
+        }
+        catch (...)
+        {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    std::thread* workers = static_cast<std::thread*>(::operator new(n * sizeof(std::thread), std::nothrow));
+    size_t started = 1;
+    if (workers != nullptr)
+    {
+        try
+        {
+            for (; started < n; ++started)
+            {
+                new (workers + started) std::thread(work, started);
+            }
+        }
+        catch (...)
+        {
+            // 剩下的任务由当前线程执行
+        }
+    }
+    work(0);
+    for (size_t t = started; t < n; ++t)
+    {
+        work(t);
+    }
+    for (size_t t = 1; t < started; ++t)
+    {
+        workers[t].join();
+        workers[t].~thread();
+    }
+    ::operator delete(workers);
+
+    std::exception_ptr error;
+    for (size_t t = 0; t < n && error == nullptr; ++t)
+    {
+        error = errors[t];
+    }
+    delete[] errors;
+    if (error != nullptr)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+// 并行算法中暂存各分块结果的缓冲区，元素由各线程分别构造，析构时只析构已构造的元素
+template <class Type>
+class parallel_buffer
+{
+private:
+    Type*   data_;
+    bool*   built_;
+    size_t  size_;
+
+public:
+    explicit parallel_buffer(size_t n)
+        : data_(static_cast<Type*>(::operator new(n * sizeof(Type)))), built_(nullptr), size_(n)
+    {
+        try
+        {
+            built_ = new bool[n]();
+        }
+        catch (...)
+        {
+            ::operator delete(data_);
+            throw;
+        }
+    }
+
+    parallel_buffer(const parallel_buffer&) = delete;
+    parallel_buffer& operator=(const parallel_buffer&) = delete;
+
+    ~parallel_buffer()
+    {
+        for (size_t i = 0; i < size_; ++i)
+        {
+            if (built_[i])
+            {
+                data_[i].~Type();
+            }
+        }
+        delete[] built_;
+        ::operator delete(data_);
+    }
+
+    // 在第 i 个位置上构造元素，每个位置只能构造一次
+    template <class... Args>
+    void construct(size_t i, Args&&... args)
+    {
+        ::new (data_ + i) Type(static_cast<Args&&>(args)...);
+        built_[i] = true;
+    }
+
+    Type&       operator[](size_t i)       { return data_[i]; }
+    const Type& operator[](size_t i) const { return data_[i]; }
+};
+
+}  // end namespace mystl
+
+#endif  // end MINIATURE_STL_PARALLEL_H
@@ -0,0 +1,256 @@
+#ifndef MINIATURE_STL_RANDOM_H
+#define MINIATURE_STL_RANDOM_H
+
+// 这个头文件包含了 mystl 的伪随机数引擎与随机数工具函数
+//
+// splitmix64    : 状态 64 位，主要用来把一个种子扩展为其他引擎的初始状态
+// xoshiro256ss  : xoshiro256**，状态 256 位，速度最快，提供 jump 用于生成互不重叠的并行序列
+// pcg64         : PCG XSL RR 128/64，状态 128 位，可以用 stream 选择相互独立的序列
+// 三个引擎都满足 UniformRandomBitGenerator 的要求，可以直接用于 mystl::shuffle 等算法
+//
+// bounded_rand 使用 Lemire 的乘法取高位方法生成 [0, range) 内无偏的整数，绝大多数情况下不需要除法
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "bitops.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// splitmix64
+/*****************************************************************************************/
+class splitmix64
+{
+public:
+    typedef uint64_t result_type;
+
+private:
+    uint64_t state_;
+
+public:
+    explicit splitmix64(uint64_t seed = 0) noexcept : state_(seed) {}
+
+    void seed(uint64_t seed) noexcept { state_ = seed; }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+    result_type operator()() noexcept
+    {
+        uint64_t z = (state_ += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+};
+
+/*****************************************************************************************/
+// xoshiro256ss
+/*****************************************************************************************/
+class xoshiro256ss
+{
+public:
+    typedef uint64_t result_type;
+
+private:
+    uint64_t s_[4];
+
+public:
+    explicit xoshiro256ss(uint64_t seed = 0) noexcept { this->seed(seed); }
+
+    // 用 splitmix64 扩展种子，保证状态不会全为 0
+    void seed(uint64_t seed) noexcept
+    {
+        splitmix64 sm(seed);
+        for (int i = 0; i < 4; ++i)
+        {
+            s_[i] = sm();
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+    result_type operator()() noexcept
+    {
+        const uint64_t result = mystl::rotl64(s_[1] * 5, 7) * 9;
+        const uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = mystl::rotl64(s_[3], 45);
+        return result;
+    }
+
+    // 相当于调用 2^128 次 operator()，从同一个种子出发依次 jump 可以得到 2^128 个互不重叠的序列
+    void jump() noexcept
+    {
+        static const uint64_t table[4] = {
+            0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull};
+        uint64_t t[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int b = 0; b < 64; ++b)
+            {
+                if (table[i] & (static_cast<uint64_t>(1) << b))
+                {
+                    t[0] ^= s_[0];
+                    t[1] ^= s_[1];
+                    t[2] ^= s_[2];
+                    t[3] ^= s_[3];
+                }
+                (*this)();
+            }
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+            s_[i] = t[i];
+        }
+    }
+};
+
+/*****************************************************************************************/
+// pcg64
+/*****************************************************************************************/
+class pcg64
+{
+public:
+    typedef uint64_t result_type;
+
+private:
+    // 128 位的状态与增量，增量必须为奇数
+    uint64_t state_hi_;
+    uint64_t state_lo_;
+    uint64_t inc_hi_;
+    uint64_t inc_lo_;
+
+    static const uint64_t mult_hi = 2549297995355413924ull;
+    static const uint64_t mult_lo = 4865540595714422341ull;
+
+public:
+    explicit pcg64(uint64_t seed = 0, uint64_t stream = 0) noexcept { this->seed(seed, stream); }
+
+    void seed(uint64_t seed, uint64_t stream = 0) noexcept
+    {
+        splitmix64 sm(seed);
+        const uint64_t init_hi = sm();
+        const uint64_t init_lo = sm();
+        splitmix64 ss(stream);
+        inc_hi_ = ss();
+        inc_lo_ = ss() | 1;
+        state_hi_ = 0;
+        state_lo_ = 0;
+        step();
+        add(state_hi_, state_lo_, init_hi, init_lo);
+        step();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+    result_type operator()() noexcept
+    {
+        step();
+        return mystl::rotr64(state_hi_ ^ state_lo_, static_cast<int>(state_hi_ >> 58));
+    }
+
+private:
+    static void add(uint64_t& hi, uint64_t& lo, uint64_t b_hi, uint64_t b_lo) noexcept
+    {
+        const uint64_t r = lo + b_lo;
+        hi += b_hi + static_cast<uint64_t>(r < lo);
+        lo = r;
+    }
+
+    // state = state * mult + inc (mod 2^128)
+    void step() noexcept
+    {
+        uint64_t hi;
+        const uint64_t lo = mystl::mul64x64_128(state_lo_, mult_lo, &hi);
+        hi += state_lo_ * mult_hi + state_hi_ * mult_lo;
+        state_hi_ = hi;
+        state_lo_ = lo;
+        add(state_hi_, state_lo_, inc_hi_, inc_lo_);
+    }
+};
+
+/*****************************************************************************************/
+// 随机数工具函数
+/*****************************************************************************************/
+
+// 从引擎得到 64 个均匀的随机位，引擎必须输出完整的 32 位或 64 位
+template <class Engine>
+uint64_t random_bits64_aux(Engine& g, std::true_type)
+{
+    return static_cast<uint64_t>(g());
+}
+
+template <class Engine>
+uint64_t random_bits64_aux(Engine& g, std::false_type)
+{
+    const uint64_t hi = static_cast<uint64_t>(g());
+    return (hi << 32) | static_cast<uint64_t>(g());
+}
+
+template <class Engine>
+uint64_t random_bits64(Engine& g)
+{
+    typedef typename Engine::result_type result_type;
+    static_assert(Engine::min() == 0 &&
+                  (static_cast<uint64_t>(Engine::max()) == 0xffffffffull ||
+                   static_cast<uint64_t>(Engine::max()) == ~static_cast<uint64_t>(0)),
+                  "mystl random algorithms need an engine producing full 32 or 64 bit values");
+    return mystl::random_bits64_aux(g, std::integral_constant<bool, (sizeof(result_type) >= 8 &&
+        static_cast<uint64_t>(Engine::max()) == ~static_cast<uint64_t>(0))>());
+}
+
+// 返回 [0, range) 内均匀分布的整数，range 必须大于 0
+// 取 x * range 的高 64 位作为结果；只有低 64 位小于 2^64 mod range 时才可能有偏，此时才计算取模并拒绝重取
+template <class Engine>
+uint64_t bounded_rand(Engine& g, uint64_t range)
+{
+    uint64_t hi;
+    uint64_t lo = mystl::mul64x64_128(mystl::random_bits64(g), range, &hi);
+    if (lo < range)
+    {
+        const uint64_t threshold = (0 - range) % range;
+        while (lo < threshold)
+        {
+            lo = mystl::mul64x64_128(mystl::random_bits64(g), range, &hi);
+        }
+    }
+    return hi;
+}
+
+// 返回 (0, 1) 内均匀分布的 double，不会取到 0，可以直接取对数
+template <class Engine>
+double uniform_open01(Engine& g)
+{
+    return (static_cast<double>(mystl::random_bits64(g) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+// 每个线程各自拥有的默认引擎，首次使用时以时间、线程局部变量的地址和一个全局计数器混合出种子
+inline xoshiro256ss& thread_random_engine()
+{
+    static std::atomic<uint64_t> counter(0);
+    thread_local xoshiro256ss engine([]
+    {
+        splitmix64 sm(static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count()));
+        uint64_t seed = sm() ^ counter.fetch_add(1, std::memory_order_relaxed);
+        int local = 0;
+        seed ^= splitmix64(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&local)))();
+        return seed;
+    }());
+    return engine;
+}
+
+}  // end namespace mystl
+
+#endif  // end MINIATURE_STL_RANDOM_H
@@ -40,6 +40,9 @@ void construct(T * ptr, Args && ... args)
 
 
 //// destroy 对对象进行析构
+template <typename T>
+void destroy(T * pointer);
+
 template <typename T>
 void destroy_one(T *, std::true_type) {}
 
@@ -0,0 +1,179 @@
+#ifndef MINIATURE_STL_NODE_POOL_H
+#define MINIATURE_STL_NODE_POOL_H
+
+//// 这个头文件包含一个模板类 node_pool，为链式容器的节点提供大小固定的内存块
+//
+// 节点从成块分配的内存中依次切出，释放的节点挂在空闲链表上，下次分配时优先复用。
+// 块的大小从 16 个节点起倍增，最多 4096 个节点，因此大量插入时只有极少数次调用 operator new，
+// 相邻插入的节点在内存中也相邻。整块内存只在 release 或析构时归还
+//
+// node_pool 不是线程安全的，每个容器各自拥有一个
+
+#include <cstddef>
+#include <new>
+
+#include "util.h"
+
+namespace mystl
+{
+
+template <class Type>
+class node_pool
+{
+private:
+    // 空闲的节点上存放指向下一个空闲节点的指针
+    struct free_node
+    {
+        free_node* next;
+    };
+
+    // 每块内存开头的块头，把所有块串成链表
+    struct block
+    {
+        block* next;
+    };
+
+    static constexpr size_t node_align = alignof(Type) > alignof(free_node) ? alignof(Type) : alignof(free_node);
+    static constexpr size_t node_size =
+        ((sizeof(Type) > sizeof(free_node) ? sizeof(Type) : sizeof(free_node)) + node_align - 1) / node_align * node_align;
+    static constexpr size_t header_size = (sizeof(block) + node_align - 1) / node_align * node_align;
+
+    static constexpr size_t min_block_nodes = 16;
+    static constexpr size_t max_block_nodes = 4096;
+
+    block*      blocks_;        // 已分配的块
+    free_node*  free_;          // 空闲链表
+    char*       cur_;           // 当前块中尚未切出的部分
+    char*       end_;
+    size_t      free_count_;    // 空闲链表上的节点数
+    size_t      next_nodes_;    // 下一块的节点数
+
+public:
+    node_pool() noexcept
+        : blocks_(nullptr), free_(nullptr), cur_(nullptr), end_(nullptr), free_count_(0), next_nodes_(min_block_nodes)
+    {
+    }
+
+    node_pool(const node_pool&) = delete;
+    node_pool& operator=(const node_pool&) = delete;
+
+    node_pool(node_pool&& rhs) noexcept
+        : blocks_(rhs.blocks_), free_(rhs.free_), cur_(rhs.cur_), end_(rhs.end_),
+          free_count_(rhs.free_count_), next_nodes_(rhs.next_nodes_)
+    {
+        rhs.reset();
+    }
+
+    node_pool& operator=(node_pool&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            release();
+            blocks_ = rhs.blocks_;
+            free_ = rhs.free_;
+            cur_ = rhs.cur_;
+            end_ = rhs.end_;
+            free_count_ = rhs.free_count_;
+            next_nodes_ = rhs.next_nodes_;
+            rhs.reset();
+        }
+        return *this;
+    }
+
+    ~node_pool()
+    {
+        release();
+    }
+
+    // 返回一个节点大小的未初始化内存
+    Type* allocate()
+    {
+        if (free_ != nullptr)
+        {
+            free_node* p = free_;
+            free_ = p->next;
+            --free_count_;
+            return reinterpret_cast<Type*>(p);
+        }
+        if (cur_ == end_)
+        {
+            add_block(next_nodes_);
+            next_nodes_ = next_nodes_ * 2 < max_block_nodes ? next_nodes_ * 2 : max_block_nodes;
+        }
+        Type* p = reinterpret_cast<Type*>(cur_);
+        cur_ += node_size;
+        return p;
+    }
+
+    // 归还一个由 allocate 得到的节点，其上的对象必须已经析构
+    void deallocate(Type* p) noexcept
+    {
+        free_node* node = reinterpret_cast<free_node*>(p);
+        node->next = free_;
+        free_ = node;
+        ++free_count_;
+    }
+
+    // 保证之后的 n 次 allocate 都不必再分配内存
+    void reserve(size_t n)
+    {
+        const size_t available = free_count_ + static_cast<size_t>(end_ - cur_) / node_size;
+        if (available < n)
+        {
+            const size_t need = n - available;
+            add_block(need > min_block_nodes ? need : static_cast<size_t>(min_block_nodes));
+        }
+    }
+
+    // 释放所有的块，之前分配出的节点全部失效
+    void release() noexcept
+    {
+        while (blocks_ != nullptr)
+        {
+            block* next = blocks_->next;
+            ::operator delete(blocks_);
+            blocks_ = next;
+        }
+        reset();
+    }
+
+    void swap(node_pool& rhs) noexcept
+    {
+        mystl::swap(blocks_, rhs.blocks_);
+        mystl::swap(free_, rhs.free_);
+        mystl::swap(cur_, rhs.cur_);
+        mystl::swap(end_, rhs.end_);
+        mystl::swap(free_count_, rhs.free_count_);
+        mystl::swap(next_nodes_, rhs.next_nodes_);
+    }
+
+private:
+    // 分配一块能容纳 n 个节点的内存，当前块剩下的部分先挂到空闲链表上
+    void add_block(size_t n)
+    {
+        block* b = static_cast<block*>(::operator new(header_size + n * node_size));
+        while (cur_ != end_)
+        {
+            deallocate(reinterpret_cast<Type*>(cur_));
+            cur_ += node_size;
+        }
+        b->next = blocks_;
+        blocks_ = b;
+        cur_ = reinterpret_cast<char*>(b) + header_size;
+        end_ = cur_ + n * node_size;
+    }
+
+    void reset() noexcept
+    {
+        blocks_ = nullptr;
+        free_ = nullptr;
+        cur_ = nullptr;
+        end_ = nullptr;
+        free_count_ = 0;
+        next_nodes_ = min_block_nodes;
+    }
+};
+
+}  // end namespace mystl
+
+#endif  // end MINIATURE_STL_NODE_POOL_H
@@ -16,20 +16,20 @@ namespace mystl
 
 // move 将一个左值强制转化为右值引用，继而可以通过右值引用使用该值，以用于移动语义。
 template <typename T>
-typename std::remove_reference<T>::type && move(T && arg) noexcept
+constexpr typename std::remove_reference<T>::type && move(T && arg) noexcept
 {
     return static_cast<typename std::remove_reference<T>::type &&>(arg);
 }
 
 // forward 将输入的参数原封不动地传递到下一个函数中，这个“原封不动”指的是，如果输入的参数是左值，那么传递给下一个函数的参数的也是左值；如果输入的参数是右值，那么传递给下一个函数的参数的也是右值。
 template <typename T>
-T && forward(typename std::remove_reference<T>::type & arg) noexcept
+constexpr T && forward(typename std::remove_reference<T>::type & arg) noexcept
 {
     return static_cast<T &&>(arg);
 }
 
 template <typename T>
-T && forward(typename std::remove_reference<T>::type && arg) noexcept
+constexpr T && forward(typename std::remove_reference<T>::type && arg) noexcept
 {
     static_assert(!std::is_lvalue_reference<T>::value, "bad forward");
     return static_cast<T &&>(arg);
@@ -46,7 +46,7 @@ void swap(T & lhs, T & rhs)
 
 // swap_range 交换两个序列。这个算法需要 3 个正向迭代器作为参数。前两个参数分别是第一个序列的开始和结束迭代器，第三个参数是第二个序列的开始迭代器。显然，这两个序列的长度必须相同。这个算法会返回一个迭代器，它指向第二个序列的最后一个被交换元素的下一个位置。
 template <typename ForwardIterator1, typename ForwardIterator2>
-ForwardIterator2 swap_range(ForwardIterator1 first1, ForwardIterator2 last1, ForwardIterator2 first2)
+ForwardIterator2 swap_range(ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2)
 {
     for (; first1 != last1; ++ first1, (void) ++ first2)
         mystl::swap(*first1, *first2);
@@ -191,7 +191,7 @@ struct pair
     // 重载赋值运算符
     pair & operator=(const pair & rhs)
     {
-        if (this != rhs)
+        if (this != &rhs)
         {
             first = rhs.first;
             second = rhs.second;
@@ -201,7 +201,7 @@ struct pair
 
     pair & operator=(pair && rhs)
     {
-        if (this != rhs)
+        if (this != &rhs)
         {
             first = mystl::move(rhs.first);
             second = mystl::move(rhs.second);
@@ -230,7 +230,7 @@ struct pair
 
     void swap(pair & other)
     {
-        if (this != other)
+        if (this != &other)
         {
             mystl::swap(first, other.first);
             mystl::swap(second, other.second);
@@ -149,6 +149,44 @@ typename iterator_traits<Iterator>::value_type * value_type(const Iterator &)
     return static_cast<typename iterator_traits<Iterator>::value_type *>(nullptr);
 }
 
+//// 分段迭代器
+// 分段迭代器所指的序列由若干段连续内存组成（如 deque 的缓冲区），逐个元素前进时每一步都要检查是否越过了段尾。
+// 容器为自己的迭代器特化 segmented_iterator_traits 后，copy / fill / find / for_each / accumulate 等算法
+// 会把区间拆成若干段，在每一段的原生指针上执行内层循环，从而可以使用 memmove 与 SIMD 版本。特化需要提供：
+//   segment_iterator            : 在各段之间移动的迭代器
+//   local_iterator              : 段内的迭代器（原生指针）
+//   segment(it) / local(it)     : it 所在的段，以及 it 在段内的位置
+//   begin(seg) / end(seg)       : 一段的起止位置
+//   compose(seg, local)         : 由段和段内位置得到原迭代器，local 必须位于 [begin(seg), end(seg)) 内
+template <typename Iterator>
+struct segmented_iterator_traits
+{
+    typedef std::false_type is_segmented_iterator;
+};
+
+template <typename Iterator>
+struct is_segmented_iterator : public segmented_iterator_traits<Iterator>::is_segmented_iterator {};
+
+// 把分段迭代器区间 [first, last) 拆成若干段连续区间，依次调用 f(local_first, local_last)
+template <typename SegmentedIter, typename Function>
+void segmented_for_each_block(SegmentedIter first, SegmentedIter last, Function f)
+{
+    typedef segmented_iterator_traits<SegmentedIter> traits;
+    typename traits::segment_iterator sfirst = traits::segment(first);
+    const typename traits::segment_iterator slast = traits::segment(last);
+    if (sfirst == slast)
+    {
+        f(traits::local(first), traits::local(last));
+        return;
+    }
+    f(traits::local(first), traits::end(sfirst));
+    for (++sfirst; sfirst != slast; ++sfirst)
+    {
+        f(traits::begin(sfirst), traits::end(sfirst));
+    }
+    f(traits::begin(slast), traits::local(last));
+}
+
 //// 以下函数用于计算迭代器间的距离
 
 // distance 函数
@@ -184,7 +222,7 @@ typename iterator_traits<RandomIterator>::difference_type distance_dispatch(Rand
 template <typename InputIterator, typename Distance>
 void advance(InputIterator & i, Distance n)
 {
-    advance(i, n, mystl::iterator_category(i));
+    advance_dispatch(i, n, mystl::iterator_category(i));
 }
 
 
@@ -3,14 +3,19 @@
 
 // 这个头文件包含了 mystl 的一系列算法
 
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 
 #include "algobase.h"
+#include "../00_utils/parallel.h"
+#include "../00_utils/random.h"
 #include "../01_allocators/memory.h"
 #include "../03_algorithms/functional.h"
 #include "../03_algorithms/heap_algo.h"
+#include "../03_algorithms/simd_algo.h"
 
 namespace mystl
 {
@@ -229,9 +234,27 @@ ForwardIter search_n(ForwardIter first, ForwardIter last, Diff count, const Type
 }
 
 /*****************************************************************************************/
+// find
+// 在[first, last)区间内找到第一个等于 value 的元素并返回指向该元素的迭代器
+// 原生指针上的整数类型使用 simd_find，分段迭代器（如 deque 的迭代器）逐段在原生指针上查找
 /*****************************************************************************************/
+// 判断能否用 simd_find 查找：指向整数的指针，value 与元素类型相同
+template <class InputIter, class Type>
+struct is_simd_find : public std::integral_constant<bool,
+    std::is_pointer<InputIter>::value &&
+    std::is_integral<typename iterator_traits<InputIter>::value_type>::value &&
+    !std::is_same<typename iterator_traits<InputIter>::value_type, bool>::value &&
+    std::is_same<typename iterator_traits<InputIter>::value_type, typename std::remove_cv<Type>::type>::value &&
+    (sizeof(Type) == 1 || sizeof(Type) == 2 || sizeof(Type) == 4 || sizeof(Type) == 8)> {};
+
 template <typename InputIter, typename Type>
-InputIter find(InputIter first, InputIter last, const Type & value)
+InputIter find_simd_aux(InputIter first, InputIter last, const Type & value, std::true_type)
+{
+    return first + mystl::simd_find<sizeof(Type)>(first, static_cast<size_t>(last - first), &value);
+}
+
+template <typename InputIter, typename Type>
+InputIter find_simd_aux(InputIter first, InputIter last, const Type & value, std::false_type)
 {
     for (; first != last; ++first)
     {
@@ -243,6 +266,49 @@ InputIter find(InputIter first, InputIter last, const Type & value)
     return first;
 }
 
+template <typename InputIter, typename Type>
+InputIter find_segmented_aux(InputIter first, InputIter last, const Type & value, std::true_type)
+{
+    typedef segmented_iterator_traits<InputIter>     traits;
+    typedef typename traits::local_iterator          local_iterator;
+    typedef is_simd_find<local_iterator, Type>       use_simd;
+    typename traits::segment_iterator sfirst = traits::segment(first);
+    const typename traits::segment_iterator slast = traits::segment(last);
+    if (sfirst == slast)
+    {
+        const local_iterator l = traits::local(last);
+        const local_iterator p = mystl::find_simd_aux(traits::local(first), l, value, use_simd());
+        return p == l ? last : traits::compose(sfirst, p);
+    }
+    local_iterator b = traits::local(first);
+    while (sfirst != slast)
+    {
+        const local_iterator e = traits::end(sfirst);
+        const local_iterator p = mystl::find_simd_aux(b, e, value, use_simd());
+        if (p != e)
+        {
+            return traits::compose(sfirst, p);
+        }
+        ++sfirst;
+        b = traits::begin(sfirst);
+    }
+    const local_iterator l = traits::local(last);
+    const local_iterator p = mystl::find_simd_aux(b, l, value, use_simd());
+    return p == l ? last : traits::compose(slast, p);
+}
+
+template <typename InputIter, typename Type>
+InputIter find_segmented_aux(InputIter first, InputIter last, const Type & value, std::false_type)
+{
+    return mystl::find_simd_aux(first, last, value, is_simd_find<InputIter, Type>());
+}
+
+template <typename InputIter, typename Type>
+InputIter find(InputIter first, InputIter last, const Type & value)
+{
+    return mystl::find_segmented_aux(first, last, value, mystl::is_segmented_iterator<InputIter>());
+}
+
 /*****************************************************************************************/
 // find_if
 // 在[first, last)区间内找到第一个令一元操作 unary_pred 为 true 的元素并返回指向该元素的迭代器
@@ -484,15 +550,34 @@ ForwardIter adjacent_find(ForwardIter first, ForwardIter last, BinaryPredicate p
 // for_each
 // 使用一个汉书对象 f 对 [first, last) 区间内每个元素执行一个 operator() 操作，但不能改变元素的内容
 // f() 可以返回一个值，但该值会被忽略
+// 分段迭代器逐段在原生指针上执行
 /*****************************************************************************************/
 template <typename InputIter, typename Function>
-Function for_each(InputIter first, InputIter last, Function func)
+void for_each_aux(InputIter first, InputIter last, Function& func, std::true_type)
 {
-    while (first != last)
+    typedef typename segmented_iterator_traits<InputIter>::local_iterator local_iterator;
+    mystl::segmented_for_each_block(first, last, [&func](local_iterator f, local_iterator l)
     {
-        *first = func(*first);
-        ++first;
+        for (; f != l; ++f)
+        {
+            func(*f);
+        }
+    });
+}
+
+template <typename InputIter, typename Function>
+void for_each_aux(InputIter first, InputIter last, Function& func, std::false_type)
+{
+    for (; first != last; ++first)
+    {
+        func(*first);
     }
+}
+
+template <typename InputIter, typename Function>
+Function for_each(InputIter first, InputIter last, Function func)
+{
+    mystl::for_each_aux(first, last, func, mystl::is_segmented_iterator<InputIter>());
     return func;
 }
 
@@ -572,9 +657,10 @@ ForwardIter lower_bound_dispatch(ForwardIter first, ForwardIter last, const Type
     while (len > 0)
     {
         half = len >> 1;
+        middle = first;
         mystl::advance(middle, half);
         
-        if (!prd(*middle, value))
+        if (pred(*middle, value))
         {
             first = middle;
             ++first;
@@ -601,9 +687,9 @@ RandomIter lower_bound_dispatch(RandomIter first, RandomIter last, const Type &
     while (len > 0)
     {
         half = len >> 1;
-        middle = first + len;
+        middle = first + half;
         
-        if (!pred(*middle, value))
+        if (pred(*middle, value))
         {
             first = middle + 1;
             len = len - half - 1;
@@ -616,9 +702,9 @@ RandomIter lower_bound_dispatch(RandomIter first, RandomIter last, const Type &
 }
 
 template <typename ForwardIter, typename Type, typename BinaryPredicate>
-ForwardIter lower_bound(ForwardIter first, ForwardIter last, const Type & value)
+ForwardIter lower_bound(ForwardIter first, ForwardIter last, const Type & value, BinaryPredicate pred)
 {
-    return lower_bound_dispatch(first, last, value, mystl::iterator_category(first));
+    return lower_bound_dispatch(first, last, value, pred, mystl::iterator_category(first));
 }
 
 /*****************************************************************************************/
@@ -1008,6 +1094,380 @@ bool includes(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2
     return first2 == last2;
 }
 
+/*****************************************************************************************/
+// gallop_lower_bound
+// 在已排序的 [first, last) 中从 first 开始以 1, 3, 7, 15... 的步长向后试探，
+// 再在最后一段内二分，找到第一个不满足 comp(*iter, value) 的位置
+// 目标离 first 的距离为 d 时只需要 O(log d) 次比较，适合两个序列长度悬殊时逐个定位
+/*****************************************************************************************/
+template <typename RandomIter, typename Type, typename Compare>
+RandomIter gallop_lower_bound(RandomIter first, RandomIter last, const Type & value, Compare comp)
+{
+    typedef typename mystl::iterator_traits<RandomIter>::difference_type diff_type;
+
+    const diff_type len = last - first;
+    if (len == 0 || !comp(*first, value))
+    {
+        return first;
+    }
+    diff_type lo = 0;           // 始终满足 comp(first[lo], value)
+    diff_type hi = 1;
+    while (hi < len && comp(first[hi], value))
+    {
+        lo = hi;
+        hi = 2 * hi + 1;
+    }
+    if (hi > len)
+    {
+        hi = len;
+    }
+    return mystl::lower_bound(first + lo + 1, first + hi, value, comp);
+}
+
+// 两个序列长度之比超过该值时，set_intersection 与 set_difference 改用逐个试探的方式
+const int SetGallopRatio = 32;
+
+/*****************************************************************************************/
+// set_union
+// 计算 S1∪S2 的结果并保存到 result 中，返回一个迭代器指向输出结果的尾部
+// 某个元素在 S1 中出现 m 次、在 S2 中出现 n 次时，结果中出现 max(m, n) 次
+/*****************************************************************************************/
+template <typename InputIter1, typename InputIter2, typename OutputIter>
+OutputIter set_union(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result)
+{
+    while (first1 != last1 && first2 != last2)
+    {
+        if (*first1 < *first2)
+        {
+            *result = *first1;
+            ++first1;
+        }
+        else if (*first2 < *first1)
+        {
+            *result = *first2;
+            ++first2;
+        }
+        else 
+        {
+            *result = *first1;
+            ++first1;
+            ++first2;
+        }
+        ++result;
+    }
+    // 将剩余元素拷贝到 result
+    return mystl::copy(first2, last2, mystl::copy(first1, last1, result));
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compare>
+OutputIter set_union(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compare comp)
+{
+    while (first1 != last1 && first2 != last2)
+    {
+        if (comp(*first1, *first2))
+        {
+            *result = *first1;
+            ++first1;
+        }
+        else if (comp(*first2, *first1))
+        {
+            *result = *first2;
+            ++first2;
+        }
+        else 
+        {
+            *result = *first1;
+            ++first1;
+            ++first2;
+        }
+        ++result;
+    }
+    return mystl::copy(first2, last2, mystl::copy(first1, last1, result));
+}
+
+/*****************************************************************************************/
+// set_intersection
+// 计算 S1∩S2 的结果并保存到 result 中，返回一个迭代器指向输出结果的尾部
+// 某个元素在 S1 中出现 m 次、在 S2 中出现 n 次时，结果中出现 min(m, n) 次，元素取自 S1
+// 两个序列都支持随机访问且长度相差 SetGallopRatio 倍以上时，对短序列的每个元素在长序列中倍增试探
+/*****************************************************************************************/
+// set_intersection_dispatch 的 input_iterator_tag 版本：线性归并
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compare>
+OutputIter set_intersection_dispatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compare comp,
+                                     mystl::input_iterator_tag, mystl::input_iterator_tag)
+{
+    while (first1 != last1 && first2 != last2)
+    {
+        if (comp(*first1, *first2))
+        {
+            ++first1;
+        }
+        else if (comp(*first2, *first1))
+        {
+            ++first2;
+        }
+        else 
+        {
+            *result = *first1;
+            ++first1;
+            ++first2;
+            ++result;
+        }
+    }
+    return result;
+}
+
+// set_intersection_dispatch 的 random_access_iterator_tag 版本
+template <typename RandomIter1, typename RandomIter2, typename OutputIter, typename Compare>
+OutputIter set_intersection_dispatch(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2, OutputIter result, Compare comp,
+                                     mystl::random_access_iterator_tag, mystl::random_access_iterator_tag)
+{
+    const auto len1 = last1 - first1;
+    const auto len2 = last2 - first2;
+    if (len1 * SetGallopRatio < len2)
+    {
+        // S1 很短：对 S1 的每个元素在 S2 中试探
+        for (; first1 != last1; ++first1)
+        {
+            first2 = mystl::gallop_lower_bound(first2, last2, *first1, comp);
+            if (first2 == last2)
+            {
+                break;
+            }
+            if (!comp(*first1, *first2))
+            {
+                *result = *first1;
+                ++result;
+                ++first2;
+            }
+        }
+        return result;
+    }
+    if (len2 * SetGallopRatio < len1)
+    {
+        // S2 很短：对 S2 的每个元素在 S1 中试探
+        for (; first2 != last2; ++first2)
+        {
+            first1 = mystl::gallop_lower_bound(first1, last1, *first2, comp);
+            if (first1 == last1)
+            {
+                break;
+            }
+            if (!comp(*first2, *first1))
+            {
+                *result = *first1;
+                ++result;
+                ++first1;
+            }
+        }
+        return result;
+    }
+    return mystl::set_intersection_dispatch(first1, last1, first2, last2, result, comp,
+                                            mystl::input_iterator_tag(), mystl::input_iterator_tag());
+}
+
+template <typename InputIter1, typename InputIter2, typename OutputIter>
+OutputIter set_intersection(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result)
+{
+    typedef typename mystl::iterator_traits<InputIter1>::value_type value_type;
+    return mystl::set_intersection_dispatch(first1, last1, first2, last2, result, mystl::less<value_type>(),
+                                            mystl::iterator_category(first1), mystl::iterator_category(first2));
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compare>
+OutputIter set_intersection(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compare comp)
+{
+    return mystl::set_intersection_dispatch(first1, last1, first2, last2, result, comp,
+                                            mystl::iterator_category(first1), mystl::iterator_category(first2));
+}
+
+/*****************************************************************************************/
+// set_intersection_strict
+// 求两个严格递增（无重复元素）的 uint32_t / uint64_t 数组的交集，返回一个指针指向输出结果的尾部
+// result 至少需要容纳 min(last1 - first1, last2 - first2) 个元素
+// 长度相近时使用 SIMD 全配对比较，长度悬殊时在长数组中倍增试探
+/*****************************************************************************************/
+template <typename Type>
+Type* set_intersection_strict_aux(const Type* first1, const Type* last1, const Type* first2, const Type* last2, Type* result)
+{
+    const size_t len1 = static_cast<size_t>(last1 - first1);
+    const size_t len2 = static_cast<size_t>(last2 - first2);
+    if (len1 * SetGallopRatio < len2 || len2 * SetGallopRatio < len1)
+    {
+        return mystl::set_intersection_dispatch(first1, last1, first2, last2, result, mystl::less<Type>(),
+                                                mystl::random_access_iterator_tag(), mystl::random_access_iterator_tag());
+    }
+    return result + mystl::simd_set_intersection(first1, len1, first2, len2, result);
+}
+
+inline uint32_t* set_intersection_strict(const uint32_t* first1, const uint32_t* last1,
+                                         const uint32_t* first2, const uint32_t* last2, uint32_t* result)
+{
+    return mystl::set_intersection_strict_aux(first1, last1, first2, last2, result);
+}
+
+inline uint64_t* set_intersection_strict(const uint64_t* first1, const uint64_t* last1,
+                                         const uint64_t* first2, const uint64_t* last2, uint64_t* result)
+{
+    return mystl::set_intersection_strict_aux(first1, last1, first2, last2, result);
+}
+
+/*****************************************************************************************/
+// set_difference
+// 计算 S1-S2 的结果并保存到 result 中，返回一个迭代器指向输出结果的尾部
+// 某个元素在 S1 中出现 m 次、在 S2 中出现 n 次时，结果中出现 max(m - n, 0) 次
+// 两个序列都支持随机访问且长度相差 SetGallopRatio 倍以上时，使用倍增试探跳过整段元素
+/*****************************************************************************************/
+// set_difference_dispatch 的 input_iterator_tag 版本：线性归并
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compare>
+OutputIter set_difference_dispatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compare comp,
+                                   mystl::input_iterator_tag, mystl::input_iterator_tag)
+{
+    while (first1 != last1 && first2 != last2)
+    {
+        if (comp(*first1, *first2))
+        {
+            *result = *first1;
+            ++first1;
+            ++result;
+        }
+        else if (comp(*first2, *first1))
+        {
+            ++first2;
+        }
+        else 
+        {
+            ++first1;
+            ++first2;
+        }
+    }
+    return mystl::copy(first1, last1, result);
+}
+
+// set_difference_dispatch 的 random_access_iterator_tag 版本
+template <typename RandomIter1, typename RandomIter2, typename OutputIter, typename Compare>
+OutputIter set_difference_dispatch(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2, OutputIter result, Compare comp,
+                                   mystl::random_access_iterator_tag, mystl::random_access_iterator_tag)
+{
+    const auto len1 = last1 - first1;
+    const auto len2 = last2 - first2;
+    if (len1 * SetGallopRatio < len2)
+    {
+        // S1 很短：逐个检查 S1 的元素是否出现在 S2 中
+        for (; first1 != last1; ++first1)
+        {
+            first2 = mystl::gallop_lower_bound(first2, last2, *first1, comp);
+            if (first2 == last2)
+            {
+                break;
+            }
+            if (comp(*first1, *first2))
+            {
+                *result = *first1;
+                ++result;
+            }
+            else 
+            {
+                ++first2;
+            }
+        }
+        return mystl::copy(first1, last1, result);
+    }
+    if (len2 * SetGallopRatio < len1)
+    {
+        // S2 很短：成段拷贝 S1 中小于 S2 当前元素的部分，再去掉一个与之相等的元素
+        for (; first2 != last2 && first1 != last1; ++first2)
+        {
+            auto middle = mystl::gallop_lower_bound(first1, last1, *first2, comp);
+            result = mystl::copy(first1, middle, result);
+            first1 = middle;
+            if (first1 != last1 && !comp(*first2, *first1))
+            {
+                ++first1;
+            }
+        }
+        return mystl::copy(first1, last1, result);
+    }
+    return mystl::set_difference_dispatch(first1, last1, first2, last2, result, comp,
+                                          mystl::input_iterator_tag(), mystl::input_iterator_tag());
+}
+
+template <typename InputIter1, typename InputIter2, typename OutputIter>
+OutputIter set_difference(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result)
+{
+    typedef typename mystl::iterator_traits<InputIter1>::value_type value_type;
+    return mystl::set_difference_dispatch(first1, last1, first2, last2, result, mystl::less<value_type>(),
+                                          mystl::iterator_category(first1), mystl::iterator_category(first2));
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compare>
+OutputIter set_difference(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compare comp)
+{
+    return mystl::set_difference_dispatch(first1, last1, first2, last2, result, comp,
+                                          mystl::iterator_category(first1), mystl::iterator_category(first2));
+}
+
+/*****************************************************************************************/
+// set_symmetric_difference
+// 计算 (S1-S2)∪(S2-S1) 的结果并保存到 result 中，返回一个迭代器指向输出结果的尾部
+// 某个元素在 S1 中出现 m 次、在 S2 中出现 n 次时，结果中出现 |m - n| 次
+/*****************************************************************************************/
+template <typename InputIter1, typename InputIter2, typename OutputIter>
+OutputIter set_symmetric_difference(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result)
+{
+    while (first1 != last1 && first2 != last2)
+    {
+        if (*first1 < *first2)
+        {
+            *result = *first1;
+            ++first1;
+            ++result;
+        }
+        else if (*first2 < *first1)
+        {
+            *result = *first2;
+            ++first2;
+            ++result;
+        }
+        else 
+        {
+            ++first1;
+            ++first2;
+        }
+    }
+    return mystl::copy(first2, last2, mystl::copy(first1, last1, result));
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compare>
+OutputIter set_symmetric_difference(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compare comp)
+{
+    while (first1 != last1 && first2 != last2)
+    {
+        if (comp(*first1, *first2))
+        {
+            *result = *first1;
+            ++first1;
+            ++result;
+        }
+        else if (comp(*first2, *first1))
+        {
+            *result = *first2;
+            ++first2;
+            ++result;
+        }
+        else 
+        {
+            ++first1;
+            ++first2;
+        }
+    }
+    return mystl::copy(first2, last2, mystl::copy(first1, last1, result));
+}
+
 /*****************************************************************************************/
 // is_heap
 // 检查 [first, last) 内元素是否为一个堆，若是返回 true， 反之返回 false
@@ -1263,20 +1723,11 @@ ForwardIter min_element(ForwardIter first, ForwardIter last, Compare pred)
 // 将[first1, last1)从 first2 开始，交换相同个数元素
 // 交换的区间长度必须相同，两个序列不能互相重叠，返回一个迭代器指向序列二最后一个被交换元素的下一位置
 /*****************************************************************************************/
+// 逐个交换的 swap_range 定义在 util.h 中
 template <typename ForwardIter1, typename ForwardIter2>
-ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2)
+ForwardIter2 swap_ranges(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2)
 {
-    auto temp = mystl::move(*first1);
-    while (first1 != last1)
-    {
-        temp = mystl::move(*first1);
-        *first1 = mystl::move(*first2);
-        *first2 = mystl::move(temp);
-
-        ++first1;
-        ++first2;
-    }
-    return first2;
+    return mystl::swap_range(first1, last1, first2);
 }
 
 /*****************************************************************************************/
@@ -1318,7 +1769,7 @@ OutputIter remove_copy(InputIter first, InputIter last, OutputIter result, const
 {
     while (first != last)
     {
-        if (value == *first)
+        if (!(*first == value))
         {
             *result = *first;
             ++result;
@@ -1344,9 +1795,10 @@ ForwardIter remove(ForwardIter first, ForwardIter last, const Type & value)
 /*****************************************************************************************/
 // remove_copy_if
 // 移除区间内所有令一元操作 unary_pred 为 true 的元素，并将结果复制到以 result 为起始位置的容器上
+// 两端都是指向同一平凡可复制类型的指针时按块求掩码后压缩写出，见 copy_if
 /*****************************************************************************************/
 template <typename InputIter, typename OutputIter, typename UnaryPredicate>
-OutputIter remove_copy_if(InputIter first, InputIter last, OutputIter result, UnaryPredicate pred)
+OutputIter remove_copy_if_aux(InputIter first, InputIter last, OutputIter result, UnaryPredicate& pred, std::false_type)
 {
     while (first != last)
     {
@@ -1360,16 +1812,53 @@ OutputIter remove_copy_if(InputIter first, InputIter last, OutputIter result, Un
     return result;
 }
 
+template <typename InputIter, typename OutputIter, typename UnaryPredicate>
+OutputIter remove_copy_if_aux(InputIter first, InputIter last, OutputIter result, UnaryPredicate& pred, std::true_type)
+{
+    return mystl::compress_if<false>(first, last, result, pred);
+}
+
+template <typename InputIter, typename OutputIter, typename UnaryPredicate>
+OutputIter remove_copy_if(InputIter first, InputIter last, OutputIter result, UnaryPredicate pred)
+{
+    return mystl::remove_copy_if_aux(first, last, result, pred,
+                                     mystl::is_trivial_compress_range<InputIter, OutputIter>());
+}
+
 /*****************************************************************************************/
 // remove_if
 // 移除区间内所有令一元操作 unary_pred 为 true 的元素
+// 指向平凡可复制类型的指针原地按块压缩，其他情况把保留的元素依次移动到前面
 /*****************************************************************************************/
 template <typename ForwardIter, typename UnaryPredicate>
-ForwardIter remove_if(ForwardIter first, ForwardIter last, UnaryPredicate pred)
+ForwardIter remove_if_aux(ForwardIter first, ForwardIter last, UnaryPredicate& pred, std::false_type)
 {
     first = mystl::find_if(first, last, pred);
-    auto next = first;
-    first == last ? first : mystl::remove_copy_if(++next, last, first, pred);
+    if (first == last)
+    {
+        return first;
+    }
+    for (auto i = first; ++i != last; )
+    {
+        if (!pred(*i))
+        {
+            *first = mystl::move(*i);
+            ++first;
+        }
+    }
+    return first;
+}
+
+template <typename ForwardIter, typename UnaryPredicate>
+ForwardIter remove_if_aux(ForwardIter first, ForwardIter last, UnaryPredicate& pred, std::true_type)
+{
+    return mystl::compress_if<false>(first, last, first, pred);
+}
+
+template <typename ForwardIter, typename UnaryPredicate>
+ForwardIter remove_if(ForwardIter first, ForwardIter last, UnaryPredicate pred)
+{
+    return mystl::remove_if_aux(first, last, pred, mystl::is_trivial_contiguous_iterator<ForwardIter>());
 }
 
 /*****************************************************************************************/
@@ -1462,22 +1951,44 @@ void reverse_dispatch(BidirectioalIter first, BidirectioalIter last, mystl::bidi
             return;
         }
         mystl::iter_swap(first, last);
+        ++first;
     }
 }
 // reverse_dispatch 的 random_access_iterator_tag 版本
+// 指向 1、2、4、8 字节平凡可复制类型的指针交给 SIMD 内核，在寄存器内反转整个向量
 template <typename RandomIter>
-void reverse_dispatch(RandomIter first, RandomIter last, mystl::random_access_iterator_tag)
+void reverse_random(RandomIter first, RandomIter last, std::false_type)
 {
-    while (first < last)
+    if (first == last)
+    {
+        return;
+    }
+    for (--last; first < last; ++first, --last)
     {
         mystl::iter_swap(first, last);
     }
 }
 
+template <typename RandomIter>
+void reverse_random(RandomIter first, RandomIter last, std::true_type)
+{
+    typedef typename mystl::iterator_traits<RandomIter>::value_type value_type;
+    mystl::simd_reverse<sizeof(value_type)>(first, static_cast<size_t>(last - first));
+}
+
+template <typename RandomIter>
+void reverse_dispatch(RandomIter first, RandomIter last, mystl::random_access_iterator_tag)
+{
+    typedef typename mystl::iterator_traits<RandomIter>::value_type value_type;
+    mystl::reverse_random(first, last, std::integral_constant<bool,
+        mystl::is_trivial_contiguous_iterator<RandomIter>::value &&
+        (sizeof(value_type) == 1 || sizeof(value_type) == 2 || sizeof(value_type) == 4 || sizeof(value_type) == 8)>());
+}
+
 template <typename BidirectioalIter>
 void reverse(BidirectioalIter first, BidirectioalIter last)
 {
-    reverse_dispatch(first, last, mystl::iterator_category(first));
+    mystl::reverse_dispatch(first, last, mystl::iterator_category(first));
 }
 
 /*****************************************************************************************/
@@ -1497,23 +2008,216 @@ OutputIter reverse_copy(BidirectioalIter first, BidirectioalIter last, OutputIte
 }
 
 /*****************************************************************************************/
-// random_shuffle
-// 将[first, last)内的元素次序随机重排
-// 重载版本使用一个产生随机数的函数对象 rand
+// shuffle
+// 用随机数引擎 g 将[first, last)内的元素次序随机重排，每种排列出现的概率相同
+// g 必须输出完整的 32 位或 64 位随机数，例如 mystl::xoshiro256ss
 /*****************************************************************************************/
-template <typename RandomIter>
-void random_shuffle(RandomIter first, RandomIter last)
+template <typename RandomIter, typename UniformRandomBitGenerator>
+void shuffle(RandomIter first, RandomIter last, UniformRandomBitGenerator && g)
 {
     if (first == last)
     {
         return;
     }
-    srand(time(NULL));
-    for (auto iter = first + 1; iter != last; ++iter)
+    // Fisher-Yates：从后往前，每个位置与它前面（含自身）的一个随机位置交换
+    for (auto i = last - first - 1; i > 0; --i)
+    {
+        mystl::iter_swap(first + i, first + static_cast<decltype(i)>(mystl::bounded_rand(g, static_cast<uint64_t>(i) + 1)));
+    }
+}
+
+/*****************************************************************************************/
+// parallel_shuffle
+// 以 seed 为种子将[first, last)内的元素次序随机重排，每种排列出现的概率相同，结果只取决于 seed 与元素个数，
+// 与线程数无关；适合远大于缓存的数组
+//
+// 直接做 Fisher-Yates 时几乎每次交换都是一次缓存未命中。这里先给每个元素一个均匀随机的桶号，
+// 把元素按桶分散到辅助数组中（每个分块只向各桶的末尾顺序写入），再对每个放得进缓存的桶单独做 Fisher-Yates 并写回原位置。
+// 各桶大小服从多项分布、桶内排列均匀，拼接起来恰好是均匀的随机排列。
+// 分块与桶的个数都只由元素个数决定，每个分块、每个桶使用由 seed 派生的独立引擎，多个线程并行处理不同的分块或桶；
+// 桶号在计数与分散两趟中由同一个引擎重新生成，不需要额外保存
+// 元素的移动操作可能抛出异常，或者辅助数组申请失败时，退化为顺序的 shuffle
+/*****************************************************************************************/
+const size_t ParallelShuffleBucketBytes = 1 << 20;     // 每个桶的目标大小
+const size_t ParallelShuffleMaxBuckets = 1024;          // 桶的个数上限，同时也是每个分块的写入流个数
+const size_t ParallelShuffleChunkSize = 1 << 16;        // 分块的最小元素个数
+const size_t ParallelShuffleMaxChunks = 256;
+
+// 第 stream 个分块或桶使用的引擎
+// 先把 seed 打散再加上 stream，交换 seed 与 stream 不会得到同一个引擎
+inline xoshiro256ss parallel_shuffle_engine(uint64_t seed, uint64_t stream)
+{
+    return xoshiro256ss(mystl::splitmix64(mystl::splitmix64(seed)() + stream)());
+}
+
+// 把每个 64 位随机数切成若干个 bits 位的桶号，桶的个数为 2 的幂，高位切片是无偏的
+class parallel_shuffle_bucket_source
+{
+private:
+    xoshiro256ss engine_;
+    uint64_t     word_;
+    int          bits_;
+    int          left_;
+
+public:
+    parallel_shuffle_bucket_source(const xoshiro256ss& engine, int bits)
+        : engine_(engine), word_(0), bits_(bits), left_(0) {}
+
+    size_t next()
+    {
+        if (left_ == 0)
+        {
+            word_ = engine_();
+            left_ = 64 / bits_;
+        }
+        const size_t bucket = static_cast<size_t>(word_ >> (64 - bits_));
+        word_ <<= bits_;
+        --left_;
+        return bucket;
+    }
+};
+
+template <typename RandomIter>
+void parallel_shuffle_aux(RandomIter first, RandomIter last, uint64_t seed, std::false_type)
+{
+    mystl::shuffle(first, last, mystl::parallel_shuffle_engine(seed, 0));
+}
+
+template <typename RandomIter>
+void parallel_shuffle_aux(RandomIter first, RandomIter last, uint64_t seed, std::true_type)
+{
+    typedef typename mystl::iterator_traits<RandomIter>::value_type value_type;
+
+    const size_t n = static_cast<size_t>(last - first);
+    int bits = 0;
+    while ((static_cast<size_t>(1) << bits) < ParallelShuffleMaxBuckets &&
+           (static_cast<size_t>(1) << bits) * ParallelShuffleBucketBytes < n * sizeof(value_type))
+    {
+        ++bits;
+    }
+    value_type* buf = bits == 0 ? nullptr
+                                : static_cast<value_type*>(::operator new(n * sizeof(value_type), std::nothrow));
+    if (buf == nullptr)
+    {
+        // 整个数组放得进一个桶，或者申请不到辅助数组
+        mystl::shuffle(first, last, mystl::parallel_shuffle_engine(seed, 0));
+        return;
+    }
+
+    const size_t buckets = static_cast<size_t>(1) << bits;
+    size_t chunks = n / ParallelShuffleChunkSize;
+    chunks = chunks == 0 ? 1 : (chunks < ParallelShuffleMaxChunks ? chunks : ParallelShuffleMaxChunks);
+    size_t* pos = new (std::nothrow) size_t[chunks * buckets + buckets + 1]();
+    if (pos == nullptr)
+    {
+        ::operator delete(buf);
+        mystl::shuffle(first, last, mystl::parallel_shuffle_engine(seed, 0));
+        return;
+    }
+    size_t* bucket_begin = pos + chunks * buckets;     // 第 b 个桶为 buf[bucket_begin[b], bucket_begin[b + 1])
+
+    const size_t chunk_parts = mystl::parallel_thread_count(n) < chunks ? mystl::parallel_thread_count(n) : chunks;
+
+    // 第一趟：统计每个分块落入各桶的元素个数
+    mystl::parallel_invoke_n(chunk_parts, [&](size_t t)
+    {
+        const size_t c_end = mystl::parallel_chunk_begin(chunks, chunk_parts, t + 1);
+        for (size_t c = mystl::parallel_chunk_begin(chunks, chunk_parts, t); c != c_end; ++c)
+        {
+            parallel_shuffle_bucket_source src(mystl::parallel_shuffle_engine(seed, c), bits);
+            size_t* count = pos + c * buckets;
+            const size_t len = mystl::parallel_chunk_begin(n, chunks, c + 1) - mystl::parallel_chunk_begin(n, chunks, c);
+            for (size_t i = 0; i < len; ++i)
+            {
+                ++count[src.next()];
+            }
+        }
+    });
+
+    // 按桶优先、分块其次的顺序求出每个分块在每个桶中的写入位置
+    size_t offset = 0;
+    for (size_t b = 0; b < buckets; ++b)
     {
-        mystl::iter_swap(iter, first + (rand() % (iter - first + 1)));
+        bucket_begin[b] = offset;
+        for (size_t c = 0; c < chunks; ++c)
+        {
+            const size_t count = pos[c * buckets + b];
+            pos[c * buckets + b] = offset;
+            offset += count;
+        }
     }
+    bucket_begin[buckets] = offset;
+
+    // 第二趟：重新生成同样的桶号，把元素移动到辅助数组中
+    mystl::parallel_invoke_n(chunk_parts, [&](size_t t)
+    {
+        const size_t c_end = mystl::parallel_chunk_begin(chunks, chunk_parts, t + 1);
+        for (size_t c = mystl::parallel_chunk_begin(chunks, chunk_parts, t); c != c_end; ++c)
+        {
+            parallel_shuffle_bucket_source src(mystl::parallel_shuffle_engine(seed, c), bits);
+            size_t* next = pos + c * buckets;
+            const size_t b = mystl::parallel_chunk_begin(n, chunks, c);
+            const size_t e = mystl::parallel_chunk_begin(n, chunks, c + 1);
+            for (size_t i = b; i != e; ++i)
+            {
+                ::new (buf + next[src.next()]++) value_type(mystl::move(*(first + i)));
+            }
+        }
+    });
+
+    // 第三趟：每个桶内做 inside-out Fisher-Yates，边打乱边写回原数组的同一段位置
+    const size_t bucket_parts = mystl::parallel_thread_count(n) < buckets ? mystl::parallel_thread_count(n) : buckets;
+    mystl::parallel_invoke_n(bucket_parts, [&](size_t t)
+    {
+        const size_t b_end = mystl::parallel_chunk_begin(buckets, bucket_parts, t + 1);
+        for (size_t b = mystl::parallel_chunk_begin(buckets, bucket_parts, t); b != b_end; ++b)
+        {
+            xoshiro256ss g = mystl::parallel_shuffle_engine(seed, chunks + b);
+            RandomIter dest = first + bucket_begin[b];
+            value_type* src = buf + bucket_begin[b];
+            const size_t len = bucket_begin[b + 1] - bucket_begin[b];
+            for (size_t i = 0; i < len; ++i)
+            {
+                const size_t j = static_cast<size_t>(mystl::bounded_rand(g, static_cast<uint64_t>(i) + 1));
+                if (j != i)
+                {
+                    *(dest + i) = mystl::move(*(dest + j));
+                }
+                *(dest + j) = mystl::move(src[i]);
+                src[i].~value_type();
+            }
+        }
+    });
+
+    delete[] pos;
+    ::operator delete(buf);
+}
+
+template <typename RandomIter>
+void parallel_shuffle(RandomIter first, RandomIter last, uint64_t seed)
+{
+    typedef typename mystl::iterator_traits<RandomIter>::value_type value_type;
+    mystl::parallel_shuffle_aux(first, last, seed, std::integral_constant<bool,
+        std::is_nothrow_move_constructible<value_type>::value && std::is_nothrow_move_assignable<value_type>::value>());
+}
+
+template <typename RandomIter>
+void parallel_shuffle(RandomIter first, RandomIter last)
+{
+    mystl::parallel_shuffle(first, last, mystl::thread_random_engine()());
+}
+
+/*****************************************************************************************/
+// random_shuffle
+// 将[first, last)内的元素次序随机重排
+// 重载版本使用一个产生随机数的函数对象 rand，rand(n) 返回 [0, n) 内的随机数
+/*****************************************************************************************/
+template <typename RandomIter>
+void random_shuffle(RandomIter first, RandomIter last)
+{
+    mystl::shuffle(first, last, mystl::thread_random_engine());
 }
+
 // 重载版本使用一个产生随机数的函数对象 rand
 template <typename RandomIter, typename RandomNumberGenerator>
 void random_shuffle(RandomIter first, RandomIter last, RandomNumberGenerator & rand)
@@ -1522,11 +2226,80 @@ void random_shuffle(RandomIter first, RandomIter last, RandomNumberGenerator & r
     {
         return;
     }
-    auto len = mystl::distance(first, last);
     for (auto iter = first + 1; iter != last; ++iter)
     {
-        mystl::iter_swap(iter, first + (rand(iter - first + 1) % len));
+        mystl::iter_swap(iter, first + rand(iter - first + 1));
+    }
+}
+
+/*****************************************************************************************/
+// sample
+// 从[first, last)中等概率地选出 n 个元素（不足 n 个时全部选出）复制到 result，返回输出结果的尾部
+// 输入为前向迭代器时按选择抽样，结果保持原来的相对次序；
+// 输入只是输入迭代器时用蓄水池抽样，result 必须支持随机访问，结果的次序是随机的
+/*****************************************************************************************/
+// sample_dispatch 的 forward_iterator_tag 版本
+template <typename ForwardIter, typename OutputIter, typename Distance, typename UniformRandomBitGenerator>
+OutputIter sample_dispatch(ForwardIter first, ForwardIter last, OutputIter result, Distance n,
+                           UniformRandomBitGenerator & g, mystl::forward_iterator_tag)
+{
+    // 剩余 remain 个元素中还需要选 n 个，当前元素以 n / remain 的概率被选中
+    auto remain = mystl::distance(first, last);
+    for (; n > 0 && first != last; ++first, --remain)
+    {
+        if (mystl::bounded_rand(g, static_cast<uint64_t>(remain)) < static_cast<uint64_t>(n))
+        {
+            *result = *first;
+            ++result;
+            --n;
+        }
+    }
+    return result;
+}
+
+// sample_dispatch 的 input_iterator_tag 版本
+template <typename InputIter, typename RandomIter, typename Distance, typename UniformRandomBitGenerator>
+RandomIter sample_dispatch(InputIter first, InputIter last, RandomIter result, Distance n,
+                           UniformRandomBitGenerator & g, mystl::input_iterator_tag)
+{
+    // 先放满蓄水池
+    Distance k = 0;
+    for (; k < n && first != last; ++first, ++k)
+    {
+        result[k] = *first;
+    }
+    if (k < n)
+    {
+        return result + k;
+    }
+    // Li 的 Algorithm L：直接算出下一个被选中的元素前要跳过多少个，随机数的个数只与 k * log(N / k) 成正比
+    double w = std::exp(std::log(mystl::uniform_open01(g)) / static_cast<double>(k));
+    while (true)
+    {
+        double skip = std::floor(std::log(mystl::uniform_open01(g)) / std::log1p(-w));
+        for (; skip > 0 && first != last; skip -= 1)
+        {
+            ++first;
+        }
+        if (first == last)
+        {
+            break;
+        }
+        result[static_cast<Distance>(mystl::bounded_rand(g, static_cast<uint64_t>(k)))] = *first;
+        ++first;
+        w *= std::exp(std::log(mystl::uniform_open01(g)) / static_cast<double>(k));
+    }
+    return result + k;
+}
+
+template <typename InputIter, typename OutputIter, typename Distance, typename UniformRandomBitGenerator>
+OutputIter sample(InputIter first, InputIter last, OutputIter result, Distance n, UniformRandomBitGenerator && g)
+{
+    if (n <= 0)
+    {
+        return result;
     }
+    return mystl::sample_dispatch(first, last, result, n, g, mystl::iterator_category(first));
 }
 
 /*****************************************************************************************/
@@ -1536,7 +2309,7 @@ void random_shuffle(RandomIter first, RandomIter last, RandomNumberGenerator & r
 /*****************************************************************************************/
 // rotate_dispatch 的 forward_iterator_tag 版本
 template <typename ForwardIter>
-void rotate_dispatch(ForwardIter first, ForwardIter middle, ForwardIter lastk, mystl::forward_iterator_tag)
+ForwardIter rotate_dispatch(ForwardIter first, ForwardIter middle, ForwardIter last, mystl::forward_iterator_tag)
 {
     auto first2 = middle;
     do
@@ -1566,7 +2339,7 @@ void rotate_dispatch(ForwardIter first, ForwardIter middle, ForwardIter lastk, m
 }
 // rotate_dispatch 的 bidirectional_iterator_tag 版本
 template <typename BidirectionalIter>
-void rotate_dispatch(BidirectionalIter first, BidirectionalIter middle, BidirectionalIter last, mystl::bidirectional_iterator_tag)
+BidirectionalIter rotate_dispatch(BidirectionalIter first, BidirectionalIter middle, BidirectionalIter last, mystl::bidirectional_iterator_tag)
 {
     mystl::reverse_dispatch(first, middle, mystl::bidirectional_iterator_tag());
     mystl::reverse_dispatch(middle, last, mystl::bidirectional_iterator_tag());
@@ -1599,59 +2372,82 @@ Type rgcd(Type m, Type n)
     return m;
 }
 
+// 较短一侧不超过这个字节数时，rotate 借助栈上的缓冲区整体搬移
+const size_t RotateBufferBytes = 4096;
 
-// rotate_dispatch 的 random_access_iterator_tag 版本
+// 一般的随机访问迭代器：把元素分成 gcd(n, l) 个环，每个环沿步长 l 依次前移
 template <typename RandomIter>
-RandomIter rotate_dispatch(RandomIter first, RandomIter middle, RandomIter last, mystl::random_access_iterator_tag)
+RandomIter rotate_random(RandomIter first, RandomIter middle, RandomIter last, std::false_type)
 {
     auto n = last - first;
     auto l = middle - first;
-    auto r = n - l;
-    auto result = first + (last - middle);
+    auto r = last - middle;
+    auto result = first + r;
     if (l == r)
     {
         mystl::swap_range(first, middle, middle);
         return result;
     }
-    auto cycle_time = rgcd(n, l);
-    for (auto i = 0; i < cycle_time; ++i)
+    const auto cycle_times = mystl::rgcd(n, l);
+    for (decltype(n) i = 0; i < cycle_times; ++i)
     {
-        auto temp = *first;
-        auto p = first;
-        if (l < r)
+        auto start = first + i;
+        auto temp = mystl::move(*start);
+        auto p = start;
+        auto next = p + l;
+        while (next != start)
         {
-            for (auto j = 0; j < r / cycle_time; ++j)
-            {
-                if (p > first + r)
-                {
-                    *p = *(p - r);
-                    p -= r;
-                }
-                *p = *(p + l);
-                    p += l;
-            }
+            *p = mystl::move(*next);
+            p = next;
+            next = last - next > l ? next + l : first + (l - (last - next));
         }
-        else 
+        *p = mystl::move(temp);
+    }
+    return result;
+}
+
+// 指向平凡可复制类型的指针：gcd 环的访问是跳跃的，改为按顺序整块搬移
+// 较短的一侧放得进缓冲区时先复制出来，memmove 较长的一侧，再把缓冲区写回，每个元素只搬移一到两次；
+// 否则做三次 SIMD 反转，全部是顺序访问，不需要额外的内存
+template <typename Type>
+Type* rotate_random(Type* first, Type* middle, Type* last, std::true_type)
+{
+    const size_t l = static_cast<size_t>(middle - first);
+    const size_t r = static_cast<size_t>(last - middle);
+    if ((l < r ? l : r) * sizeof(Type) <= RotateBufferBytes)
+    {
+        alignas(Type) unsigned char buf[RotateBufferBytes];
+        if (l <= r)
         {
-            for (auto j = 0; j < l / cycle_time - 1; ++j)
-            {
-                if (p < last - l)
-                {
-                    *p = *(p + l);
-                    p += l;
-                }
-                *p = *(p - r);
-                p -= r;
-            }
+            std::memcpy(buf, first, l * sizeof(Type));
+            std::memmove(first, middle, r * sizeof(Type));
+            std::memcpy(first + r, buf, l * sizeof(Type));
+        }
+        else
+        {
+            std::memcpy(buf, middle, r * sizeof(Type));
+            std::memmove(first + r, first, l * sizeof(Type));
+            std::memcpy(first, buf, r * sizeof(Type));
         }
-        *p = temp;
-        ++first;
     }
-    return result;
+    else
+    {
+        mystl::reverse(first, middle);
+        mystl::reverse(middle, last);
+        mystl::reverse(first, last);
+    }
+    return first + r;
+}
+
+// rotate_dispatch 的 random_access_iterator_tag 版本
+template <typename RandomIter>
+RandomIter rotate_dispatch(RandomIter first, RandomIter middle, RandomIter last, mystl::random_access_iterator_tag)
+{
+    return mystl::rotate_random(first, middle, last, mystl::is_trivial_contiguous_iterator<RandomIter>());
 }
 
 template <typename ForwardIter>
-ForwardIter retate(ForwardIter first, ForwardIter middle, ForwardIter last)
+ForwardIter rotate(ForwardIter first, ForwardIter middle, ForwardIter last)
 {
     if (first == middle) 
     {
@@ -1669,79 +2465,242 @@ ForwardIter retate(ForwardIter first, ForwardIter middle, ForwardIter last)
 // 行为与 rotate 类似，不同的是将结果复制到 result 所指的容器中
 /*****************************************************************************************/
 template <typename ForwardIter, typename OutputIter>
-ForwardIter rotate_copy(ForwardIter first, ForwardIter middle, ForwardIter last, OutputIter result)
+OutputIter rotate_copy(ForwardIter first, ForwardIter middle, ForwardIter last, OutputIter result)
 {
     return mystl::copy(first, middle, mystl::copy(middle, last, result));
 }
 
 /*****************************************************************************************/
-// is_permutation  !!!!
-// 判断[first1,last1)是否为[first2, last2)的排列组合
+// partition
+// 对区间内的元素重排，令一元操作 unary_pred 为 true 的元素都放在区间的前段，返回第一个令其为 false 的位置
+// 不保证保持元素原有的相对次序
 /*****************************************************************************************/
-template <class ForwardIter1, class ForwardIter2, class BinaryPred>
-bool is_permutation_aux(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2, BinaryPred pred)
+// partition_dispatch 的 forward_iterator_tag 版本
+template <typename ForwardIter, typename UnaryPredicate>
+ForwardIter partition_dispatch(ForwardIter first, ForwardIter last, UnaryPredicate& pred, mystl::forward_iterator_tag)
 {
-    constexpr bool is_ra_it = mystl::is_random_access_iterator<ForwardIter1>::value && mystl::is_random_access_iterator<ForwardIter2>::value;
-    if (is_ra_it)
-    {
-        auto len1 = last1 - first1;
-        auto len2 = last2 - first2;
-        if (len1 != len2)
-            return false;
-    }
-
-  // 先找出相同的前缀段
-    for (; first1 != last1 && first2 != last2; ++first1, (void) ++first2)
-    {
-        if (!pred(*first1, *first2))
-            break;
-    }
-    if (is_ra_it)
+    first = mystl::find_if_not(first, last, pred);
+    if (first == last)
     {
-        if (first1 == last1)
-            return true;
+        return first;
     }
-    else
+    for (auto i = first; ++i != last; )
     {
-        auto len1 = mystl::distance(first1, last1);
-        auto len2 = mystl::distance(first2, last2);
-        if (len1 == 0 && len2 == 0)
-            return true;
-        if (len1 != len2)
-            return false;
+        if (pred(*i))
+        {
+            mystl::iter_swap(i, first);
+            ++first;
+        }
     }
+    return first;
+}
 
-    // 判断剩余部分
-    for (auto i = first1; i != last1; ++i)
+// partition_dispatch 的 bidirectional_iterator_tag 版本：从两端向中间寻找放错位置的元素并交换
+template <typename BidirectionalIter, typename UnaryPredicate>
+BidirectionalIter partition_dispatch(BidirectionalIter first, BidirectionalIter last, UnaryPredicate& pred,
+                                     mystl::bidirectional_iterator_tag)
+{
+    while (true)
     {
-        bool is_repeated = false;
-        for (auto j = first1; j != i; ++j)
+        while (first != last && pred(*first))
         {
-            if (pred(*j, *i))
-            {
-                is_repeated = true;
-                break;
-            }
+            ++first;
         }
-
-        if (!is_repeated)
+        if (first == last)
         {
-            // 计算 *i 在 [first2, last2) 的数目
-            auto c2 = 0;
-            for (auto j = first2; j != last2; ++j)
-            {
-                if (pred(*i, *j))
-                    ++c2;
-            }
-            if (c2 == 0)
-                return false;
-
-            // 计算 *i 在 [first1, last1) 的数目
-            auto c1 = 1;
-            auto j = i;
-            for (++j; j != last1; ++j)
-            {
-                if (pred(*i, *j))
+            return first;
+        }
+        --last;
+        while (first != last && !pred(*last))
+        {
+            --last;
+        }
+        if (first == last)
+        {
+            return first;
+        }
+        mystl::iter_swap(first, last);
+        ++first;
+    }
+}
+
+// 指向平凡可复制类型的指针：[first, k) 为 true，[k, i) 为 false，
+// 每个元素都与 *k 交换，再按 pred 的结果决定 k 是否前移；元素为 false 时交换的是两个 false 元素，不影响结果
+template <typename Type, typename UnaryPredicate>
+Type* partition_branchless(Type* first, Type* last, UnaryPredicate& pred)
+{
+    Type* k = first;
+    for (; first != last; ++first)
+    {
+        const bool keep = static_cast<bool>(pred(*first));
+        const Type temp = *first;
+        *first = *k;
+        *k = temp;
+        k += keep;
+    }
+    return k;
+}
+
+template <typename BidirectionalIter, typename UnaryPredicate>
+BidirectionalIter partition_aux(BidirectionalIter first, BidirectionalIter last, UnaryPredicate& pred, std::false_type)
+{
+    return mystl::partition_dispatch(first, last, pred, mystl::iterator_category(first));
+}
+
+template <typename BidirectionalIter, typename UnaryPredicate>
+BidirectionalIter partition_aux(BidirectionalIter first, BidirectionalIter last, UnaryPredicate& pred, std::true_type)
+{
+    return mystl::partition_branchless(first, last, pred);
+}
+
+template <typename BidirectionalIter, typename UnaryPredicate>
+BidirectionalIter partition(BidirectionalIter first, BidirectionalIter last, UnaryPredicate pred)
+{
+    return mystl::partition_aux(first, last, pred, mystl::is_trivial_contiguous_iterator<BidirectionalIter>());
+}
+
+/*****************************************************************************************/
+// stable_partition
+// 与 partition 相同，但保持两部分中元素原有的相对次序
+// 能申请到缓冲区时 O(n)：令 pred 为 true 的元素依次前移，其余元素暂存到缓冲区，最后接在后面；
+// 否则二分后分别处理，再用 rotate 合并，O(n log n)
+/*****************************************************************************************/
+template <typename ForwardIter, typename UnaryPredicate, typename Distance>
+ForwardIter stable_partition_no_buffer(ForwardIter first, ForwardIter last, UnaryPredicate& pred, Distance len)
+{
+    if (len == 1)
+    {
+        return pred(*first) ? last : first;
+    }
+    auto middle = first;
+    mystl::advance(middle, len / 2);
+    auto left = mystl::stable_partition_no_buffer(first, middle, pred, len / 2);
+    auto right = mystl::stable_partition_no_buffer(middle, last, pred, len - len / 2);
+    return mystl::rotate(left, middle, right);
+}
+
+template <typename ForwardIter, typename Type, typename UnaryPredicate>
+ForwardIter stable_partition_buffer(ForwardIter first, ForwardIter last, Type* buf, UnaryPredicate& pred, std::false_type)
+{
+    auto result = first;
+    auto p = buf;
+    for (; first != last; ++first)
+    {
+        if (pred(*first))
+        {
+            *result = mystl::move(*first);
+            ++result;
+        }
+        else
+        {
+            *p = mystl::move(*first);
+            ++p;
+        }
+    }
+    mystl::move(buf, p, result);
+    return result;
+}
+
+// 指向平凡可复制类型的指针：同一个掩码分别压缩出两部分
+template <typename Type, typename UnaryPredicate>
+Type* stable_partition_buffer(Type* first, Type* last, Type* buf, UnaryPredicate& pred, std::true_type)
+{
+    Type* result = first;
+    Type* p = buf;
+    while (first != last)
+    {
+        const size_t len = static_cast<size_t>(last - first) < CompressBlockSize
+                         ? static_cast<size_t>(last - first) : CompressBlockSize;
+        uint64_t mask = 0;
+        for (size_t i = 0; i < len; ++i)
+        {
+            mask |= static_cast<uint64_t>(static_cast<bool>(pred(first[i]))) << i;
+        }
+        p += mystl::simd_compress<sizeof(Type)>(first, len, ~mask, p);
+        result += mystl::simd_compress<sizeof(Type)>(first, len, mask, result);
+        first += len;
+    }
+    std::memcpy(result, buf, static_cast<size_t>(p - buf) * sizeof(Type));
+    return result;
+}
+
+template <typename ForwardIter, typename UnaryPredicate>
+ForwardIter stable_partition(ForwardIter first, ForwardIter last, UnaryPredicate pred)
+{
+    typedef typename mystl::iterator_traits<ForwardIter>::value_type value_type;
+    first = mystl::find_if_not(first, last, pred);
+    if (first == last)
+    {
+        return first;
+    }
+    mystl::temporary_buffer<ForwardIter, value_type> buf(first, last);
+    if (buf.size() == buf.requested_size())
+    {
+        return mystl::stable_partition_buffer(first, last, buf.begin(), pred,
+                                              mystl::is_trivial_contiguous_iterator<ForwardIter>());
+    }
+    return mystl::stable_partition_no_buffer(first, last, pred, mystl::distance(first, last));
+}
+
+/*****************************************************************************************/
+// is_permutation
+// 判断[first1,last1)是否为[first2, last2)的排列组合
+// 使用 operator== 比较时按元素类型自动选择算法：
+// 可以用 mystl::hash 哈希的类型在哈希表中计数，O(n)；
+// 否则若支持 operator<，复制两个区间排序后逐个比较，O(n log n)；
+// 只支持判等的类型以及自定义 pred 的版本逐个统计出现次数，O(n^2)
+/*****************************************************************************************/
+// sort 的定义见下文，is_permutation 排序比较时使用
+template <typename RandomIter>
+void sort(RandomIter first, RandomIter last);
+
+template <class ForwardIter1, class ForwardIter2, class BinaryPred>
+bool is_permutation_aux(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2, BinaryPred pred)
+{
+    // 先找出相同的前缀段，再比较剩余部分的长度
+    for (; first1 != last1 && first2 != last2; ++first1, (void) ++first2)
+    {
+        if (!pred(*first1, *first2))
+            break;
+    }
+    auto len1 = mystl::distance(first1, last1);
+    auto len2 = mystl::distance(first2, last2);
+    if (len1 == 0 && len2 == 0)
+        return true;
+    if (len1 != len2)
+        return false;
+
+    // 判断剩余部分
+    for (auto i = first1; i != last1; ++i)
+    {
+        bool is_repeated = false;
+        for (auto j = first1; j != i; ++j)
+        {
+            if (pred(*j, *i))
+            {
+                is_repeated = true;
+                break;
+            }
+        }
+
+        if (!is_repeated)
+        {
+            // 计算 *i 在 [first2, last2) 的数目
+            auto c2 = 0;
+            for (auto j = first2; j != last2; ++j)
+            {
+                if (pred(*i, *j))
+                    ++c2;
+            }
+            if (c2 == 0)
+                return false;
+
+            // 计算 *i 在 [first1, last1) 的数目
+            auto c1 = 1;
+            auto j = i;
+            for (++j; j != last1; ++j)
+            {
+                if (pred(*i, *j))
                     ++c1;
             }
             if (c1 != c2)
@@ -1757,13 +2716,206 @@ bool is_permutation(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2
     return is_permutation_aux(first1, last1, first2, last2, pred);
 }
 
+// 剩余部分不超过这个长度时直接逐个统计，不值得申请额外的空间
+const size_t IsPermutationQuadraticLimit = 16;
+
+// 判断 Type 是否支持 operator<
+template <class Type, class = void>
+struct has_less_operator : public std::false_type {};
+
+template <class Type>
+struct has_less_operator<Type, typename std::enable_if<std::is_convertible<
+    decltype(std::declval<const Type&>() < std::declval<const Type&>()), bool>::value>::type>
+    : public std::true_type {};
+
+// 开放定址、线性探测的计数表，每个槽位记录第一个区间中某个值第一次出现的位置以及尚未抵消的个数
+// 用哈希值的低位选槽位，Hash 的结果需要充分混合（如 mixed_hash）
+template <class ForwardIter, class Hash>
+class is_permutation_counter
+{
+private:
+    struct slot
+    {
+        ForwardIter iter;
+        size_t      count;
+    };
+
+    slot*           slots_;
+    bool*           used_;
+    size_t          mask_;
+    Hash            hash_;
+
+public:
+    // 表的大小为不小于 2n 的 2 的幂，申请失败时 valid() 返回 false
+    explicit is_permutation_counter(size_t n)
+        : slots_(nullptr), used_(nullptr), mask_(0), hash_()
+    {
+        size_t cap = 16;
+        while (cap < n * 2)
+        {
+            cap <<= 1;
+        }
+        slots_ = static_cast<slot*>(::operator new(cap * sizeof(slot), std::nothrow));
+        used_ = new (std::nothrow) bool[cap]();
+        if (slots_ == nullptr || used_ == nullptr)
+        {
+            ::operator delete(slots_);
+            delete[] used_;
+            slots_ = nullptr;
+            used_ = nullptr;
+            return;
+        }
+        mask_ = cap - 1;
+    }
+
+    is_permutation_counter(const is_permutation_counter&) = delete;
+    is_permutation_counter& operator=(const is_permutation_counter&) = delete;
+
+    ~is_permutation_counter()
+    {
+        if (slots_ != nullptr)
+        {
+            for (size_t i = 0; i <= mask_; ++i)
+            {
+                if (used_[i])
+                {
+                    mystl::destroy(slots_ + i);
+                }
+            }
+        }
+        ::operator delete(slots_);
+        delete[] used_;
+    }
+
+    bool valid() const noexcept { return slots_ != nullptr; }
+
+    // 第一个区间中的元素 *iter 计数加一
+    void add(ForwardIter iter)
+    {
+        size_t i = find(*iter);
+        if (used_[i])
+        {
+            ++slots_[i].count;
+            return;
+        }
+        mystl::construct(slots_ + i, slot{iter, 1});
+        used_[i] = true;
+    }
+
+    // 第二个区间中的元素 value 抵消一次，没有可以抵消的同值元素时返回 false
+    template <class Type>
+    bool remove(const Type& value)
+    {
+        const size_t i = find(value);
+        if (!used_[i] || slots_[i].count == 0)
+        {
+            return false;
+        }
+        --slots_[i].count;
+        return true;
+    }
+
+private:
+    // 返回 value 所在的槽位，不存在时返回探测到的第一个空槽位
+    template <class Type>
+    size_t find(const Type& value)
+    {
+        size_t i = hash_(value) & mask_;
+        while (used_[i] && !(*slots_[i].iter == value))
+        {
+            i = (i + 1) & mask_;
+        }
+        return i;
+    }
+};
+
+template <class ForwardIter1, class ForwardIter2>
+bool is_permutation_quadratic(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2)
+{
+    typedef typename iterator_traits<ForwardIter1>::value_type value_type;
+    return mystl::is_permutation_aux(first1, last1, first2, last2, mystl::equal_to<value_type>());
+}
+
+// 排序后比较，需要把两个区间分别复制到临时缓冲区中
+template <class ForwardIter1, class ForwardIter2>
+bool is_permutation_sorted(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2,
+                           std::true_type)
+{
+    typedef typename iterator_traits<ForwardIter1>::value_type value_type;
+    mystl::temporary_buffer<ForwardIter1, value_type> buf1(first1, last1);
+    mystl::temporary_buffer<ForwardIter2, value_type> buf2(first2, last2);
+    if (buf1.size() != buf1.requested_size() || buf2.size() != buf2.requested_size())
+    {
+        return mystl::is_permutation_quadratic(first1, last1, first2, last2);
+    }
+    mystl::copy(first1, last1, buf1.begin());
+    mystl::copy(first2, last2, buf2.begin());
+    mystl::sort(buf1.begin(), buf1.end());
+    mystl::sort(buf2.begin(), buf2.end());
+    return mystl::equal(buf1.begin(), buf1.end(), buf2.begin());
+}
+
+template <class ForwardIter1, class ForwardIter2>
+bool is_permutation_sorted(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2,
+                           std::false_type)
+{
+    return mystl::is_permutation_quadratic(first1, last1, first2, last2);
+}
+
+template <class ForwardIter1, class ForwardIter2>
+bool is_permutation_hashed(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2,
+                           size_t n, std::true_type)
+{
+    typedef typename iterator_traits<ForwardIter1>::value_type value_type;
+    mystl::is_permutation_counter<ForwardIter1, mystl::mixed_hash<value_type>> counter(n);
+    if (!counter.valid())
+    {
+        return mystl::is_permutation_sorted(first1, last1, first2, last2, mystl::has_less_operator<value_type>());
+    }
+    for (; first1 != last1; ++first1)
+    {
+        counter.add(first1);
+    }
+    // 两个区间长度相同，第二个区间的每个元素都能抵消时计数恰好全部归零
+    for (; first2 != last2; ++first2)
+    {
+        if (!counter.remove(*first2))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class ForwardIter1, class ForwardIter2>
+bool is_permutation_hashed(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2,
+                           size_t, std::false_type)
+{
+    typedef typename iterator_traits<ForwardIter1>::value_type value_type;
+    return mystl::is_permutation_sorted(first1, last1, first2, last2, mystl::has_less_operator<value_type>());
+}
+
 template <class ForwardIter1, class ForwardIter2>
 bool is_permutation(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2)
 {
     typedef typename iterator_traits<ForwardIter1>::value_type v1;
     typedef typename iterator_traits<ForwardIter2>::value_type v2;
     static_assert(std::is_same<v1, v2>::value, "the type should be same in mystl::is_permutation");
-    return is_permutation_aux(first1, last1, first2, last2, mystl::equal_to<v1>());
+
+    // 跳过相同的前缀段，只处理剩余部分
+    for (; first1 != last1 && first2 != last2 && *first1 == *first2; ++first1, (void) ++first2) {}
+    const auto len1 = mystl::distance(first1, last1);
+    const auto len2 = mystl::distance(first2, last2);
+    if (len1 != len2)
+    {
+        return false;
+    }
+    if (static_cast<size_t>(len1) <= IsPermutationQuadraticLimit)
+    {
+        return mystl::is_permutation_quadratic(first1, last1, first2, last2);
+    }
+    return mystl::is_permutation_hashed(first1, last1, first2, last2, static_cast<size_t>(len1),
+                                        mystl::is_hashable<v1>());
 }
 
 /*****************************************************************************************/
@@ -1897,6 +3049,576 @@ bool prev_permutation(BidirectionalIter first, BidirectionalIter last, Compared
 
 
 
+/*****************************************************************************************/
+// sort
+// 将[first, last)内的元素以递增的方式排序，不保证相等元素的相对次序
+// 采用内省式排序：以三点中值快速排序为主，递归过深时改用堆排序，区间足够小时留给最后一趟插入排序
+/*****************************************************************************************/
+const size_t SortThreshold = 16;     // 小于等于该长度的子区间不再分割
+
+// 求 floor(log2(n))，用于控制递归深度
+template <typename Size>
+Size slg2(Size n)
+{
+    Size k = 0;
+    for (; n > 1; n >>= 1)
+    {
+        ++k;
+    }
+    return k;
+}
+
+// 以 pivot 分割 [first, last)，pivot 取自区间内部，两侧的循环不需要越界检查
+template <typename RandomIter, typename Type, typename Compare>
+RandomIter unchecked_partition(RandomIter first, RandomIter last, const Type & pivot, Compare comp)
+{
+    while (true)
+    {
+        while (comp(*first, pivot))
+        {
+            ++first;
+        }
+        --last;
+        while (comp(pivot, *last))
+        {
+            --last;
+        }
+        if (!(first < last))
+        {
+            return first;
+        }
+        mystl::iter_swap(first, last);
+        ++first;
+    }
+}
+
+template <typename RandomIter, typename Size, typename Compare>
+void intro_sort(RandomIter first, RandomIter last, Size depth_limit, Compare comp)
+{
+    while (static_cast<size_t>(last - first) > SortThreshold)
+    {
+        if (depth_limit == 0)
+        {
+            // 分割不均匀，改用堆排序保证 O(NlogN)
+            mystl::make_heap(first, last, comp);
+            mystl::sort_heap(first, last, comp);
+            return;
+        }
+        --depth_limit;
+        auto mid = first + (last - first) / 2;
+        auto pivot = mystl::median(*first, *mid, *(last - 1), comp);
+        auto cut = mystl::unchecked_partition(first, last, pivot, comp);
+        mystl::intro_sort(cut, last, depth_limit, comp);
+        last = cut;
+    }
+}
+
+// 向前插入 *last，前方一定存在不大于它的元素，不需要检查边界
+template <typename RandomIter, typename Compare>
+void unchecked_linear_insert(RandomIter last, Compare comp)
+{
+    auto value = mystl::move(*last);
+    auto next = last;
+    --next;
+    while (comp(value, *next))
+    {
+        *last = mystl::move(*next);
+        last = next;
+        --next;
+    }
+    *last = mystl::move(value);
+}
+
+template <typename RandomIter, typename Compare>
+void insertion_sort(RandomIter first, RandomIter last, Compare comp)
+{
+    if (first == last)
+    {
+        return;
+    }
+    for (auto i = first + 1; i != last; ++i)
+    {
+        if (comp(*i, *first))
+        {
+            auto value = mystl::move(*i);
+            mystl::move_backward(first, i, i + 1);
+            *first = mystl::move(value);
+        }
+        else
+        {
+            mystl::unchecked_linear_insert(i, comp);
+        }
+    }
+}
+
+// 内省式排序之后，每个子区间内的元素都不小于前面子区间的元素，且最小值位于前 SortThreshold 个元素中
+template <typename RandomIter, typename Compare>
+void final_insertion_sort(RandomIter first, RandomIter last, Compare comp)
+{
+    if (static_cast<size_t>(last - first) > SortThreshold)
+    {
+        mystl::insertion_sort(first, first + SortThreshold, comp);
+        for (auto i = first + SortThreshold; i != last; ++i)
+        {
+            mystl::unchecked_linear_insert(i, comp);
+        }
+    }
+    else
+    {
+        mystl::insertion_sort(first, last, comp);
+    }
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <typename RandomIter, typename Compare>
+void sort(RandomIter first, RandomIter last, Compare comp)
+{
+    if (first != last)
+    {
+        mystl::intro_sort(first, last, mystl::slg2(last - first) * 2, comp);
+        mystl::final_insertion_sort(first, last, comp);
+    }
+}
+
+template <typename RandomIter>
+void sort(RandomIter first, RandomIter last)
+{
+    typedef typename mystl::iterator_traits<RandomIter>::value_type value_type;
+    mystl::sort(first, last, mystl::less<value_type>());
+}
+
+/*****************************************************************************************/
+// unique
+// 移除[first, last)内相邻的重复元素，每一组相邻的重复元素只保留第一个，返回新区间的尾部
+// 指向平凡可复制类型的指针：每个元素都无条件写到最后保留的元素之后，再按是否重复决定是否前移，循环中没有分支
+/*****************************************************************************************/
+template <typename ForwardIter, typename BinaryPredicate>
+ForwardIter unique_aux(ForwardIter first, ForwardIter last, BinaryPredicate& pred, std::false_type)
+{
+    first = mystl::adjacent_find(first, last, pred);
+    if (first == last)
+    {
+        return last;
+    }
+    auto i = first;
+    for (++i; ++i != last; )
+    {
+        if (!pred(*first, *i))
+        {
+            *++first = mystl::move(*i);
+        }
+    }
+    return ++first;
+}
+
+// result 始终位于 i 之前，写入 result + 1 不会覆盖尚未读取的元素
+template <typename Type, typename BinaryPredicate>
+Type* unique_aux(Type* first, Type* last, BinaryPredicate& pred, std::true_type)
+{
+    if (first == last)
+    {
+        return last;
+    }
+    Type* result = first;
+    for (Type* i = first + 1; i != last; ++i)
+    {
+        const Type x = *i;
+        const bool keep = !pred(*result, x);
+        result[1] = x;
+        result += keep;
+    }
+    return result + 1;
+}
+
+template <typename ForwardIter, typename BinaryPredicate>
+ForwardIter unique(ForwardIter first, ForwardIter last, BinaryPredicate pred)
+{
+    return mystl::unique_aux(first, last, pred, mystl::is_trivial_contiguous_iterator<ForwardIter>());
+}
+
+template <typename ForwardIter>
+ForwardIter unique(ForwardIter first, ForwardIter last)
+{
+    typedef typename mystl::iterator_traits<ForwardIter>::value_type value_type;
+    return mystl::unique(first, last, mystl::equal_to<value_type>());
+}
+
+/*****************************************************************************************/
+// unique_copy
+// 与 unique 相同，但把结果复制到以 result 为起始的位置上，返回输出结果的尾部
+/*****************************************************************************************/
+// unique_copy_dispatch 的 forward_iterator_tag 版本：与上一个输入位置比较
+template <typename ForwardIter, typename OutputIter, typename BinaryPredicate>
+OutputIter unique_copy_dispatch(ForwardIter first, ForwardIter last, OutputIter result, BinaryPredicate& pred,
+                                mystl::forward_iterator_tag)
+{
+    if (first == last)
+    {
+        return result;
+    }
+    *result = *first;
+    ++result;
+    for (auto prev = first; ++first != last; prev = first)
+    {
+        if (!pred(*prev, *first))
+        {
+            *result = *first;
+            ++result;
+        }
+    }
+    return result;
+}
+
+// unique_copy_dispatch 的 input_iterator_tag 版本：输入只能读一次，保存上一个输出的元素
+template <typename InputIter, typename OutputIter, typename BinaryPredicate>
+OutputIter unique_copy_dispatch(InputIter first, InputIter last, OutputIter result, BinaryPredicate& pred,
+                                mystl::input_iterator_tag)
+{
+    if (first == last)
+    {
+        return result;
+    }
+    auto value = *first;
+    *result = value;
+    ++result;
+    while (++first != last)
+    {
+        if (!pred(value, *first))
+        {
+            value = *first;
+            *result = value;
+            ++result;
+        }
+    }
+    return result;
+}
+
+template <typename InputIter, typename OutputIter, typename BinaryPredicate>
+OutputIter unique_copy(InputIter first, InputIter last, OutputIter result, BinaryPredicate pred)
+{
+    return mystl::unique_copy_dispatch(first, last, result, pred, mystl::iterator_category(first));
+}
+
+template <typename InputIter, typename OutputIter>
+OutputIter unique_copy(InputIter first, InputIter last, OutputIter result)
+{
+    typedef typename mystl::iterator_traits<InputIter>::value_type value_type;
+    return mystl::unique_copy(first, last, result, mystl::equal_to<value_type>());
+}
+
+/*****************************************************************************************/
+// sort_unique
+// 将[first, last)内的元素排序并移除重复的元素，返回新区间的尾部，!comp(a, b) && !comp(b, a) 的元素视为重复
+/*****************************************************************************************/
+template <typename RandomIter, typename Compare>
+RandomIter sort_unique(RandomIter first, RandomIter last, Compare comp)
+{
+    mystl::sort(first, last, comp);
+    // 已经有序，相邻两个元素 a <= b 重复当且仅当 !comp(a, b)
+    auto same = [&comp](const typename mystl::iterator_traits<RandomIter>::value_type& a,
+                        const typename mystl::iterator_traits<RandomIter>::value_type& b)
+    {
+        return !comp(a, b);
+    };
+    return mystl::unique(first, last, same);
+}
+
+template <typename RandomIter>
+RandomIter sort_unique(RandomIter first, RandomIter last)
+{
+    typedef typename mystl::iterator_traits<RandomIter>::value_type value_type;
+    return mystl::sort_unique(first, last, mystl::less<value_type>());
+}
+
+/*****************************************************************************************/
+// distinct
+// 把[first, last)中每个不同的元素按第一次出现的次序复制到以 result 为起始的位置上，返回输出结果的尾部
+// 输入不需要有序，用 operator== 判断元素是否相同，按输入的长度与元素类型选择算法：
+// 不超过 DistinctLinearLimit 个元素时逐个与前面的元素比较，不申请内存；
+// 可以用 mystl::hash 哈希的类型一趟扫描，用开放定址的哈希集合记录见过的元素，O(n)；
+// 否则若支持 operator<，按 (元素, 位置) 排序找出每组的第一个元素，O(n log n)；只支持判等的类型 O(n^2)
+// 输入迭代器只能读一次，要求元素可以哈希，哈希集合中保存元素的副本；其他迭代器只保存迭代器
+/*****************************************************************************************/
+const size_t DistinctLinearLimit = 16;
+
+// 哈希集合中保存迭代器时取出所指的元素
+struct distinct_deref
+{
+    template <class Iter>
+    auto operator()(const Iter& iter) const -> decltype(*iter) { return *iter; }
+};
+
+// 哈希集合中保存元素的副本时直接返回
+struct distinct_identity
+{
+    template <class Type>
+    const Type& operator()(const Type& value) const { return value; }
+};
+
+// 开放定址、线性探测的哈希集合，负载超过一半时容量翻倍；槽位中保存 Slot，get(slot) 为它所代表的元素
+// 用哈希值的低位选槽位，Hash 的结果需要充分混合（如 mixed_hash）
+template <class Slot, class Hash, class Get>
+class distinct_hash_set
+{
+private:
+    Slot*   slots_;
+    bool*   used_;
+    size_t  mask_;
+    size_t  size_;
+    Hash    hash_;
+    Get     get_;
+
+public:
+    explicit distinct_hash_set(size_t n)
+        : slots_(nullptr), used_(nullptr), mask_(0), size_(0), hash_(), get_()
+    {
+        size_t cap = 16;
+        while (cap < n * 2)
+        {
+            cap <<= 1;
+        }
+        allocate(cap);
+    }
+
+    distinct_hash_set(const distinct_hash_set&) = delete;
+    distinct_hash_set& operator=(const distinct_hash_set&) = delete;
+
+    ~distinct_hash_set()
+    {
+        release(slots_, used_, mask_ + 1);
+    }
+
+    // 插入 slot，value 为它所代表的元素；已有相同的元素时不插入并返回 false
+    template <class Value>
+    bool insert(const Slot& slot, const Value& value)
+    {
+        size_t i = bucket(value);
+        while (used_[i])
+        {
+            if (get_(slots_[i]) == value)
+            {
+                return false;
+            }
+            i = (i + 1) & mask_;
+        }
+        mystl::construct(slots_ + i, slot);
+        used_[i] = true;
+        if (++size_ * 2 > mask_ + 1)
+        {
+            grow();
+        }
+        return true;
+    }
+
+private:
+    template <class Value>
+    size_t bucket(const Value& value)
+    {
+        return hash_(value) & mask_;
+    }
+
+    // 申请失败时抛出 std::bad_alloc，原有的表保持不变
+    void allocate(size_t cap)
+    {
+        Slot* slots = static_cast<Slot*>(::operator new(cap * sizeof(Slot)));
+        try
+        {
+            used_ = new bool[cap]();
+        }
+        catch (...)
+        {
+            ::operator delete(slots);
+            throw;
+        }
+        slots_ = slots;
+        mask_ = cap - 1;
+    }
+
+    static void release(Slot* slots, bool* used, size_t cap)
+    {
+        for (size_t i = 0; i < cap; ++i)
+        {
+            if (used[i])
+            {
+                mystl::destroy(slots + i);
+            }
+        }
+        delete[] used;
+        ::operator delete(slots);
+    }
+
+    // 容量翻倍，把原有的槽位移动到新表中
+    void grow()
+    {
+        Slot* old_slots = slots_;
+        bool* old_used = used_;
+        const size_t old_cap = mask_ + 1;
+        allocate(old_cap * 2);
+        for (size_t j = 0; j < old_cap; ++j)
+        {
+            if (old_used[j])
+            {
+                size_t i = bucket(get_(old_slots[j]));
+                while (used_[i])
+                {
+                    i = (i + 1) & mask_;
+                }
+                mystl::construct(slots_ + i, mystl::move(old_slots[j]));
+                used_[i] = true;
+            }
+        }
+        release(old_slots, old_used, old_cap);
+    }
+};
+
+// 逐个与前面的元素比较
+template <typename ForwardIter, typename OutputIter>
+OutputIter distinct_linear(ForwardIter first, ForwardIter last, OutputIter result)
+{
+    for (auto i = first; i != last; ++i)
+    {
+        auto j = first;
+        while (j != i && !(*j == *i))
+        {
+            ++j;
+        }
+        if (j == i)
+        {
+            *result = *i;
+            ++result;
+        }
+    }
+    return result;
+}
+
+// 排序时记录每个元素原来的位置
+template <typename ForwardIter>
+struct distinct_entry
+{
+    ForwardIter iter;
+    size_t      pos;
+};
+
+template <typename ForwardIter, typename OutputIter>
+OutputIter distinct_sorted(ForwardIter first, ForwardIter last, OutputIter result, size_t n, std::true_type)
+{
+    typedef mystl::distinct_entry<ForwardIter> entry;
+    entry* entries = static_cast<entry*>(::operator new(n * sizeof(entry), std::nothrow));
+    bool* keep = new (std::nothrow) bool[n]();
+    if (entries == nullptr || keep == nullptr)
+    {
+        ::operator delete(entries);
+        delete[] keep;
+        return mystl::distinct_linear(first, last, result);
+    }
+    size_t pos = 0;
+    for (auto i = first; i != last; ++i, ++pos)
+    {
+        mystl::construct(entries + pos, entry{i, pos});
+    }
+    try
+    {
+        // 相同的元素按位置排列，每组的第一个就是第一次出现的位置
+        mystl::sort(entries, entries + n, [](const entry& a, const entry& b)
+        {
+            return *a.iter < *b.iter || (!(*b.iter < *a.iter) && a.pos < b.pos);
+        });
+        keep[entries[0].pos] = true;
+        for (size_t k = 1; k < n; ++k)
+        {
+            keep[entries[k].pos] = *entries[k - 1].iter < *entries[k].iter;
+        }
+        pos = 0;
+        for (; first != last; ++first, ++pos)
+        {
+            if (keep[pos])
+            {
+                *result = *first;
+                ++result;
+            }
+        }
+    }
+    catch (...)
+    {
+        mystl::destroy(entries, entries + n);
+        ::operator delete(entries);
+        delete[] keep;
+        throw;
+    }
+    mystl::destroy(entries, entries + n);
+    ::operator delete(entries);
+    delete[] keep;
+    return result;
+}
+
+template <typename ForwardIter, typename OutputIter>
+OutputIter distinct_sorted(ForwardIter first, ForwardIter last, OutputIter result, size_t, std::false_type)
+{
+    return mystl::distinct_linear(first, last, result);
+}
+
+template <typename ForwardIter, typename OutputIter>
+OutputIter distinct_hashed(ForwardIter first, ForwardIter last, OutputIter result, size_t n, std::true_type)
+{
+    typedef typename mystl::iterator_traits<ForwardIter>::value_type value_type;
+    mystl::distinct_hash_set<ForwardIter, mystl::mixed_hash<value_type>, mystl::distinct_deref> seen(n);
+    for (; first != last; ++first)
+    {
+        if (seen.insert(first, *first))
+        {
+            *result = *first;
+            ++result;
+        }
+    }
+    return result;
+}
+
+template <typename ForwardIter, typename OutputIter>
+OutputIter distinct_hashed(ForwardIter first, ForwardIter last, OutputIter result, size_t n, std::false_type)
+{
+    typedef typename mystl::iterator_traits<ForwardIter>::value_type value_type;
+    return mystl::distinct_sorted(first, last, result, n, mystl::has_less_operator<value_type>());
+}
+
+// distinct_dispatch 的 forward_iterator_tag 版本
+template <typename ForwardIter, typename OutputIter>
+OutputIter distinct_dispatch(ForwardIter first, ForwardIter last, OutputIter result, mystl::forward_iterator_tag)
+{
+    typedef typename mystl::iterator_traits<ForwardIter>::value_type value_type;
+    const size_t n = static_cast<size_t>(mystl::distance(first, last));
+    if (n <= DistinctLinearLimit)
+    {
+        return mystl::distinct_linear(first, last, result);
+    }
+    return mystl::distinct_hashed(first, last, result, n, mystl::is_hashable<value_type>());
+}
+
+// distinct_dispatch 的 input_iterator_tag 版本
+template <typename InputIter, typename OutputIter>
+OutputIter distinct_dispatch(InputIter first, InputIter last, OutputIter result, mystl::input_iterator_tag)
+{
+    typedef typename mystl::iterator_traits<InputIter>::value_type value_type;
+    static_assert(mystl::is_hashable<value_type>::value,
+                  "mystl::distinct on input iterators needs a mystl::hash specialization");
+    mystl::distinct_hash_set<value_type, mystl::mixed_hash<value_type>, mystl::distinct_identity> seen(DistinctLinearLimit);
+    for (; first != last; ++first)
+    {
+        value_type value = *first;
+        if (seen.insert(value, value))
+        {
+            *result = mystl::move(value);
+            ++result;
+        }
+    }
+    return result;
+}
+
+template <typename InputIter, typename OutputIter>
+OutputIter distinct(InputIter first, InputIter last, OutputIter result)
+{
+    return mystl::distinct_dispatch(first, last, result, mystl::iterator_category(first));
+}
+
 }   // end namespace mystl
 
 #endif  // end MINIATURE_STL_ALGO_H
@@ -7,10 +7,13 @@
 
 //// 这个头文件包含了 mystl 的基本算法
 
+#include <cstdint>
 #include <cstring>
+#include <type_traits>
 
 #include "../02_iterators/iterator.h"
 #include "../01_allocators/util.h"
+#include "../03_algorithms/simd_algo.h"
 
 namespace mystl
 {
@@ -116,10 +119,93 @@ OutputIter unchecked_copy_cat(InputIter first, InputIter last, OutputIter desBeg
     return desBeg;
 }
 
+// 判断 Iter 是否为指向平凡可复制类型的指针，可以按字节搬移其元素
+template <class Iter>
+struct is_trivial_contiguous_iterator : public std::integral_constant<bool,
+    std::is_pointer<Iter>::value &&
+    !std::is_const<typename std::remove_pointer<Iter>::type>::value &&
+    std::is_trivially_copyable<typename std::remove_pointer<Iter>::type>::value> {};
+
+// 判断能否把 InputIter 所指的元素按字节复制到 OutputIter
+template <class InputIter, class OutputIter>
+struct is_trivial_copy_range : public std::integral_constant<bool,
+    std::is_pointer<InputIter>::value &&
+    mystl::is_trivial_contiguous_iterator<OutputIter>::value &&
+    std::is_same<typename std::remove_cv<typename std::remove_pointer<InputIter>::type>::type,
+                 typename std::remove_pointer<OutputIter>::type>::value> {};
+
+template <typename InputIter, typename OutputIter>
+OutputIter copy(InputIter first, InputIter last, OutputIter desBeg);
+
+// 连续内存上的平凡可复制类型直接使用 memmove
+template <typename InputIter, typename OutputIter>
+OutputIter copy_contiguous_aux(InputIter first, InputIter last, OutputIter desBeg, std::true_type)
+{
+    const size_t n = static_cast<size_t>(last - first);
+    if (n != 0)
+    {
+        std::memmove(desBeg, first, n * sizeof(*first));
+    }
+    return desBeg + n;
+}
+
+template <typename InputIter, typename OutputIter>
+OutputIter copy_contiguous_aux(InputIter first, InputIter last, OutputIter desBeg, std::false_type)
+{
+    return mystl::unchecked_copy_cat(first, last, desBeg, mystl::iterator_category(first));
+}
+
+// 输出为分段迭代器、输入可以随机访问时，按输出的段切块，每块复制到一段连续内存中
+template <typename InputIter, typename OutputIter>
+OutputIter copy_segmented_out_aux(InputIter first, InputIter last, OutputIter desBeg, std::true_type)
+{
+    typedef segmented_iterator_traits<OutputIter> traits;
+    typename traits::segment_iterator seg = traits::segment(desBeg);
+    typename traits::local_iterator   pos = traits::local(desBeg);
+    while (true)
+    {
+        const auto room = traits::end(seg) - pos;
+        if (last - first < room)
+        {
+            return traits::compose(seg, mystl::copy(first, last, pos));
+        }
+        mystl::copy(first, first + room, pos);
+        first += room;
+        ++seg;
+        pos = traits::begin(seg);
+    }
+}
+
+template <typename InputIter, typename OutputIter>
+OutputIter copy_segmented_out_aux(InputIter first, InputIter last, OutputIter desBeg, std::false_type)
+{
+    return mystl::copy_contiguous_aux(first, last, desBeg, mystl::is_trivial_copy_range<InputIter, OutputIter>());
+}
+
+// 输入为分段迭代器时逐段复制
+template <typename InputIter, typename OutputIter>
+OutputIter copy_segmented_in_aux(InputIter first, InputIter last, OutputIter desBeg, std::true_type)
+{
+    typedef typename segmented_iterator_traits<InputIter>::local_iterator local_iterator;
+    mystl::segmented_for_each_block(first, last, [&desBeg](local_iterator f, local_iterator l)
+    {
+        desBeg = mystl::copy(f, l, desBeg);
+    });
+    return desBeg;
+}
+
+template <typename InputIter, typename OutputIter>
+OutputIter copy_segmented_in_aux(InputIter first, InputIter last, OutputIter desBeg, std::false_type)
+{
+    return mystl::copy_segmented_out_aux(first, last, desBeg, std::integral_constant<bool,
+        mystl::is_segmented_iterator<OutputIter>::value && mystl::is_random_access_iterator<InputIter>::value>());
+}
+
+// 分段迭代器（如 deque 的迭代器）逐段在原生指针上复制，指向平凡可复制类型的指针使用 memmove
 template <typename InputIter, typename OutputIter>
 OutputIter copy(InputIter first, InputIter last, OutputIter desBeg)
 {
-    unchecked_copy_cat(first, last, desBeg, mystl::iterator_category(first));
+    return mystl::copy_segmented_in_aux(first, last, desBeg, mystl::is_segmented_iterator<InputIter>());
 }
 
 
@@ -153,19 +239,48 @@ BidirectionalIterator2 unchecked_copy_backward_cat(BidirectionalIterator1 first,
 template <typename BidirectionalIter1, typename BidirectionalIter2>
 BidirectionalIter2 copy_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 desEnd)
 {
-    unchecked_copy_backward_cat(first, last, desEnd, mystl::iterator_category(first));
+    return unchecked_copy_backward_cat(first, last, desEnd, mystl::iterator_category(first));
 }
 
 /*****************************************************************************************/
 // copy_if
 // 把[first, last)内满足一元操作 unary_pred 的元素拷贝到以 result 为起始的位置上
+// 两端都是指向同一平凡可复制类型的指针时，每 CompressBlockSize 个元素先求出 pred 的结果掩码，
+// 再用 simd_compress 一次写出选中的元素，循环中没有依赖 pred 结果的分支
 /*****************************************************************************************/
+// 判断能否把 InputIter 所指的元素按字节压缩写入 OutputIter
+template <class InputIter, class OutputIter>
+struct is_trivial_compress_range : public mystl::is_trivial_copy_range<InputIter, OutputIter> {};
+
+// 每次求掩码的元素个数，与 simd_compress 一次能处理的上限相同
+const size_t CompressBlockSize = 64;
+
+// Keep 为 true 时保留令 pred 为 true 的元素，否则保留令 pred 为 false 的元素，返回输出的尾部
+// result 可以与 first 相同（原地压缩）
+template <bool Keep, typename InputPtr, typename Type, typename UnaryPredicate>
+Type* compress_if(InputPtr first, InputPtr last, Type* result, UnaryPredicate& pred)
+{
+    while (first != last)
+    {
+        const size_t len = static_cast<size_t>(last - first) < CompressBlockSize
+                         ? static_cast<size_t>(last - first) : CompressBlockSize;
+        uint64_t mask = 0;
+        for (size_t i = 0; i < len; ++i)
+        {
+            mask |= static_cast<uint64_t>(static_cast<bool>(pred(first[i])) == Keep) << i;
+        }
+        result += mystl::simd_compress<sizeof(Type)>(first, len, mask, result);
+        first += len;
+    }
+    return result;
+}
+
 template <typename InputIter, typename OutputIter, typename UnaryPredicate>
-OutputIter copy_if(InputIter first, InputIter last, OutputIter dest, UnaryPredicate pred)
+OutputIter copy_if_aux(InputIter first, InputIter last, OutputIter dest, UnaryPredicate& pred, std::false_type)
 {
     while (first != last)
     {
-        if (pred(*first) == true)
+        if (pred(*first))
         {
             *dest = *first;
             ++dest;
@@ -175,6 +290,18 @@ OutputIter copy_if(InputIter first, InputIter last, OutputIter dest, UnaryPredic
     return dest;
 }
 
+template <typename InputIter, typename OutputIter, typename UnaryPredicate>
+OutputIter copy_if_aux(InputIter first, InputIter last, OutputIter dest, UnaryPredicate& pred, std::true_type)
+{
+    return mystl::compress_if<true>(first, last, dest, pred);
+}
+
+template <typename InputIter, typename OutputIter, typename UnaryPredicate>
+OutputIter copy_if(InputIter first, InputIter last, OutputIter dest, UnaryPredicate pred)
+{
+    return mystl::copy_if_aux(first, last, dest, pred, mystl::is_trivial_compress_range<InputIter, OutputIter>());
+}
+
 /*****************************************************************************************/
 // copy_n
 // 复制指定数量的元素。
@@ -226,7 +353,7 @@ OutputIter unchecked_move_cat(RandomIter first, RandomIter last, OutputIter dest
 template <typename InputIter, typename OutputIter>
 OutputIter move(InputIter first, InputIter last, OutputIter dest)
 {
-    unchecked_move_cat(first, last, dest, mystl::iterator_category(first));
+    return unchecked_move_cat(first, last, dest, mystl::iterator_category(first));
 }
 
 /*****************************************************************************************/
@@ -260,7 +387,7 @@ RandomIter2 unchecked_move_backward_cat(RandomIter1 first, RandomIter1 last, Ran
 template <typename BidirectionalIter1, typename BidirectionalIter2>
 BidirectionalIter2 move_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 destEnd)
 {
-    unchecked_move_backward_cat(first, last, destEnd, mystl::iterator_category(first));
+    return unchecked_move_backward_cat(first, last, destEnd, mystl::iterator_category(first));
 }
 
 /*****************************************************************************************/
@@ -274,7 +401,7 @@ bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2)
 {
     for (; first1 != last1; ++first1, ++first2)
     {
-        if (mystl::move(*first1) != *mystl::move(*first2))
+        if (!(*first1 == *first2))
         {
             return false;
         }
@@ -313,7 +440,7 @@ OutputIter unchecked_fill_n(OutputIter first, Size count, const Type & value)
 template <typename OutputIter, typename Size, typename Type>
 OutputIter fill_n(OutputIter first, Size n, const Type & value)
 {
-    unchecked_fill_n(first, n, value);
+    return unchecked_fill_n(first, n, value);
 }
 
 /*****************************************************************************************/
@@ -322,7 +449,7 @@ OutputIter fill_n(OutputIter first, Size n, const Type & value)
 /*****************************************************************************************/
 // forward_iterator_tag 版本
 template <typename ForwardIter, typename Type>
-void unchicked_fill_cat(ForwardIter first, ForwardIter last, const Type & value, mystl::forward_iterator_tag)
+void unchecked_fill_cat(ForwardIter first, ForwardIter last, const Type & value, mystl::forward_iterator_tag)
 {
     while (first != last)
     {
@@ -341,10 +468,29 @@ void unchecked_fill_cat(RandomIter first, RandomIter last, const Type & value, m
     }
 }
 
+// 分段迭代器逐段填充，标量值先复制到局部变量，避免与被写入的元素别名而无法向量化
+template <typename ForwardIter, typename Type>
+void fill_segmented_aux(ForwardIter first, ForwardIter last, const Type & value, std::true_type)
+{
+    typedef typename segmented_iterator_traits<ForwardIter>::local_iterator local_iterator;
+    typedef typename std::conditional<std::is_scalar<Type>::value, const Type, const Type&>::type value_holder;
+    value_holder v = value;
+    mystl::segmented_for_each_block(first, last, [&v](local_iterator f, local_iterator l)
+    {
+        mystl::unchecked_fill_cat(f, l, v, mystl::random_access_iterator_tag());
+    });
+}
+
+template <typename ForwardIter, typename Type>
+void fill_segmented_aux(ForwardIter first, ForwardIter last, const Type & value, std::false_type)
+{
+    mystl::unchecked_fill_cat(first, last, value, mystl::iterator_category(first));
+}
+
 template <typename ForwardIter, typename Type>
 void fill(ForwardIter first, ForwardIter last, const Type & value)
 {
-    unchecked_fill_cat(first, last, value, mystl::iterator_category(first));
+    mystl::fill_segmented_aux(first, last, value, mystl::is_segmented_iterator<ForwardIter>());
 }
 
 /*****************************************************************************************/
@@ -0,0 +1,541 @@
+#ifndef MINIATURE_STL_EXTERNAL_SORT_H
+#define MINIATURE_STL_EXTERNAL_SORT_H
+
+// 这个头文件包含外部排序算法 external_sort，用于排序超出内存容量的数据
+//
+// 分两个阶段进行：
+//   1. 生成顺串：按内存预算分块读入数据，在内存中排序后整块写入临时文件，可以多个线程同时排序各自的块
+//   2. 归并：用败者树对各顺串做 k 路归并，每一路只保留一个 io 缓冲区，顺序地读写文件；
+//      顺串个数超过内存允许的路数时，先分组归并成较少的顺串，再做最后一趟归并
+// 元素类型必须是可平凡复制的，临时文件中按原始字节保存
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+#if !defined(_WIN32)
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+#include "../00_utils/exceptdef.h"
+#include "../00_utils/parallel.h"
+#include "../02_iterators/iterator.h"
+#include "../03_algorithms/algo.h"
+#include "../03_algorithms/functional.h"
+#include "../03_algorithms/merge_algo.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// external_sort_options
+// 外部排序的参数
+/*****************************************************************************************/
+struct external_sort_options
+{
+    size_t      memory_budget = 256 * 1024 * 1024;  // 排序与归并时使用的内存上限（字节）
+    const char* temp_dir = nullptr;                 // 临时文件所在目录，为空时使用系统默认的临时文件
+    size_t      threads = 1;                        // 生成顺串的线程数，为 0 时使用硬件线程数
+    size_t      io_buffer_size = 1024 * 1024;       // 归并时每一路读写缓冲区的大小（字节）
+};
+
+// 创建一个读写模式的临时文件，文件名在创建后立即删除，关闭文件时由系统回收空间
+inline std::FILE* external_sort_tmpfile(const char* dir)
+{
+    std::FILE* file = nullptr;
+#if !defined(_WIN32)
+    if (dir != nullptr && *dir != '\0')
+    {
+        static const char name[] = "/mystl_sort_XXXXXX";
+        const size_t len = std::strlen(dir);
+        char* path = new char[len + sizeof(name)];
+        std::memcpy(path, dir, len);
+        std::memcpy(path + len, name, sizeof(name));
+        const int fd = ::mkstemp(path);
+        if (fd != -1)
+        {
+            ::unlink(path);
+            file = ::fdopen(fd, "w+b");
+            if (file == nullptr)
+            {
+                ::close(fd);
+            }
+        }
+        delete[] path;
+    }
+    else
+#endif
+    {
+        (void)dir;
+        file = std::tmpfile();
+    }
+    THROW_RUNTIME_ERROR_IF(file == nullptr, "external_sort: cannot create temporary file");
+    return file;
+}
+
+/*****************************************************************************************/
+// external_reader / external_input_iterator
+// 带缓冲区的顺序读取，以输入迭代器的形式提供给败者树
+/*****************************************************************************************/
+template <class Type>
+class external_reader
+{
+private:
+    std::FILE*  file_;
+    Type*       buf_;
+    size_t      cap_;
+    size_t      pos_;
+    size_t      size_;
+
+public:
+    external_reader() : file_(nullptr), buf_(nullptr), cap_(0), pos_(0), size_(0) {}
+
+    external_reader(const external_reader&) = delete;
+    external_reader& operator=(const external_reader&) = delete;
+
+    ~external_reader() { ::operator delete(buf_); }
+
+    // 从 file 的当前位置开始读取，缓冲区可容纳 cap 个元素
+    void open(std::FILE* file, size_t cap)
+    {
+        if (buf_ == nullptr || cap_ != cap)
+        {
+            ::operator delete(buf_);
+            buf_ = nullptr;
+            buf_ = static_cast<Type*>(::operator new(cap * sizeof(Type)));
+            cap_ = cap;
+        }
+        file_ = file;
+        fill();
+    }
+
+    bool        done() const { return pos_ == size_; }
+    const Type& get()  const { return buf_[pos_]; }
+
+    void advance()
+    {
+        if (++pos_ == size_)
+        {
+            fill();
+        }
+    }
+
+private:
+    void fill()
+    {
+        pos_ = 0;
+        size_ = std::fread(buf_, sizeof(Type), cap_, file_);
+        THROW_RUNTIME_ERROR_IF(size_ < cap_ && std::ferror(file_), "external_sort: read error");
+    }
+};
+
+template <class Type>
+class external_input_iterator : public mystl::iterator<mystl::input_iterator_tag, Type, ptrdiff_t, const Type*, const Type&>
+{
+private:
+    external_reader<Type>* reader_;   // 为空表示尾后迭代器
+
+public:
+    external_input_iterator() : reader_(nullptr) {}
+    explicit external_input_iterator(external_reader<Type>* reader) : reader_(reader) {}
+
+    const Type& operator*()  const { return reader_->get(); }
+    const Type* operator->() const { return &reader_->get(); }
+
+    external_input_iterator& operator++()
+    {
+        reader_->advance();
+        return *this;
+    }
+
+    // 读完的迭代器与尾后迭代器相等
+    bool at_end() const { return reader_ == nullptr || reader_->done(); }
+
+    bool operator==(const external_input_iterator& rhs) const { return at_end() == rhs.at_end(); }
+    bool operator!=(const external_input_iterator& rhs) const { return at_end() != rhs.at_end(); }
+};
+
+/*****************************************************************************************/
+// external_writer / external_output_iterator
+// 带缓冲区的顺序写入
+/*****************************************************************************************/
+template <class Type>
+class external_writer
+{
+private:
+    std::FILE*  file_;
+    Type*       buf_;
+    size_t      cap_;
+    size_t      size_;
+
+public:
+    external_writer(std::FILE* file, size_t cap)
+        : file_(file), buf_(static_cast<Type*>(::operator new(cap * sizeof(Type)))), cap_(cap), size_(0) {}
+
+    external_writer(const external_writer&) = delete;
+    external_writer& operator=(const external_writer&) = delete;
+
+    ~external_writer() { ::operator delete(buf_); }
+
+    void push(const Type& value)
+    {
+        buf_[size_++] = value;
+        if (size_ == cap_)
+        {
+            write_buffer();
+        }
+    }
+
+    // 写出缓冲区中剩余的元素
+    void flush()
+    {
+        write_buffer();
+        THROW_RUNTIME_ERROR_IF(std::fflush(file_) != 0, "external_sort: write error");
+    }
+
+private:
+    void write_buffer()
+    {
+        THROW_RUNTIME_ERROR_IF(size_ != 0 && std::fwrite(buf_, sizeof(Type), size_, file_) != size_,
+                               "external_sort: write error");
+        size_ = 0;
+    }
+};
+
+template <class Type>
+class external_output_iterator : public mystl::iterator<mystl::output_iterator_tag, void, void, void, void>
+{
+private:
+    external_writer<Type>* writer_;
+
+public:
+    explicit external_output_iterator(external_writer<Type>* writer) : writer_(writer) {}
+
+    external_output_iterator& operator=(const Type& value)
+    {
+        writer_->push(value);
+        return *this;
+    }
+
+    external_output_iterator& operator*()     { return *this; }
+    external_output_iterator& operator++()    { return *this; }
+    external_output_iterator& operator++(int) { return *this; }
+};
+
+/*****************************************************************************************/
+// external_sorter
+// 外部排序的状态：保存已生成的顺串，先调用 make_runs 读入全部输入，再调用 merge_to 输出结果
+/*****************************************************************************************/
+template <class Type, class Compare>
+class external_sorter
+{
+    static_assert(std::is_trivially_copyable<Type>::value, "external_sort requires a trivially copyable type");
+
+private:
+    Compare     comp_;
+    size_t      threads_;
+    size_t      chunk_;         // 每个线程一次排序的元素个数
+    size_t      io_;            // 每一路缓冲区的元素个数
+    size_t      fan_in_;        // 一趟归并最多的路数
+    const char* temp_dir_;
+
+    std::FILE** runs_;          // 顺串文件，[head_, size_) 为尚未归并的顺串
+    size_t      head_;
+    size_t      size_;
+    size_t      cap_;
+
+    Type*       buf_;           // threads_ 个分块的缓冲区
+    size_t      mem_size_;      // 输入只有一块时，排好序的数据直接留在 buf_ 中
+
+public:
+    external_sorter(const external_sort_options& options, Compare comp)
+        : comp_(comp), temp_dir_(options.temp_dir),
+          runs_(nullptr), head_(0), size_(0), cap_(0), buf_(nullptr), mem_size_(0)
+    {
+        threads_ = options.threads != 0 ? options.threads : std::thread::hardware_concurrency();
+        threads_ = threads_ != 0 ? threads_ : 1;
+        chunk_ = options.memory_budget / threads_ / sizeof(Type);
+        chunk_ = chunk_ != 0 ? chunk_ : 1;
+        io_ = options.io_buffer_size / sizeof(Type);
+        io_ = io_ != 0 ? io_ : 1;
+        // 输入缓冲区 fan_in_ 个，输出缓冲区 1 个
+        fan_in_ = options.memory_budget / (io_ * sizeof(Type));
+        fan_in_ = fan_in_ > 3 ? fan_in_ - 1 : 2;
+    }
+
+    external_sorter(const external_sorter&) = delete;
+    external_sorter& operator=(const external_sorter&) = delete;
+
+    ~external_sorter()
+    {
+        close_runs(0, size_);
+        ::operator delete(runs_);
+        ::operator delete(buf_);
+    }
+
+public:
+    // 读入 [first, last)，生成有序的顺串
+    template <class InputIter>
+    void make_runs(InputIter first, InputIter last);
+
+    // 将全部数据按顺序输出到以 result 起始的位置上
+    template <class OutputIter>
+    OutputIter merge_to(OutputIter result);
+
+private:
+    void sort_chunks(size_t* counts, size_t n);
+
+    template <class OutputIter>
+    OutputIter merge_runs(size_t first, size_t n, OutputIter result);
+
+    void push_run(std::FILE* file);
+
+    void close_runs(size_t first, size_t last)
+    {
+        for (; first != last; ++first)
+        {
+            if (runs_[first] != nullptr)
+            {
+                std::fclose(runs_[first]);
+                runs_[first] = nullptr;
+            }
+        }
+    }
+};
+
+template <class Type, class Compare>
+template <class InputIter>
+void external_sorter<Type, Compare>::make_runs(InputIter first, InputIter last)
+{
+    buf_ = static_cast<Type*>(::operator new(threads_ * chunk_ * sizeof(Type)));
+    size_t* counts = new size_t[threads_];
+    try
+    {
+        while (first != last)
+        {
+            // 顺序地读满各线程的分块
+            size_t n = 0;
+            for (; n < threads_ && first != last; ++n)
+            {
+                Type* p = buf_ + n * chunk_;
+                size_t count = 0;
+                for (; count < chunk_ && first != last; ++first, ++count)
+                {
+                    p[count] = *first;
+                }
+                counts[n] = count;
+            }
+            if (size_ == 0 && n == 1 && !(first != last))
+            {
+                // 输入能一次放进内存，不需要写临时文件
+                mystl::sort(buf_, buf_ + counts[0], comp_);
+                mem_size_ = counts[0];
+                break;
+            }
+            sort_chunks(counts, n);
+        }
+    }
+    catch (...)
+    {
+        delete[] counts;
+        throw;
+    }
+    delete[] counts;
+}
+
+// 各分块在不同的线程中排序并写入各自的临时文件
+template <class Type, class Compare>
+void external_sorter<Type, Compare>::sort_chunks(size_t* counts, size_t n)
+{
+    const size_t base = size_;
+    for (size_t t = 0; t < n; ++t)
+    {
+        push_run(mystl::external_sort_tmpfile(temp_dir_));
+    }
+
+    mystl::parallel_invoke_n(n, [this, counts, base](size_t t)
+    {
+        Type* p = buf_ + t * chunk_;
+        mystl::sort(p, p + counts[t], comp_);
+        std::FILE* file = runs_[base + t];
+        THROW_RUNTIME_ERROR_IF(std::fwrite(p, sizeof(Type), counts[t], file) != counts[t] || std::fflush(file) != 0,
+                               "external_sort: write error");
+    });
+}
+
+template <class Type, class Compare>
+template <class OutputIter>
+OutputIter external_sorter<Type, Compare>::merge_to(OutputIter result)
+{
+    if (size_ == 0)
+    {
+        result = mystl::copy(buf_, buf_ + mem_size_, result);
+        ::operator delete(buf_);
+        buf_ = nullptr;
+        mem_size_ = 0;
+        return result;
+    }
+    // 归并阶段不再需要分块缓冲区，先归还内存
+    ::operator delete(buf_);
+    buf_ = nullptr;
+
+    // 顺串太多时每次取最前面的 fan_in_ 个归并成一个新的顺串，追加到末尾
+    while (size_ - head_ > fan_in_)
+    {
+        push_run(mystl::external_sort_tmpfile(temp_dir_));
+        std::FILE* file = runs_[size_ - 1];
+        external_writer<Type> writer(file, io_);
+        merge_runs(head_, fan_in_, external_output_iterator<Type>(&writer));
+        writer.flush();
+        close_runs(head_, head_ + fan_in_);
+        head_ += fan_in_;
+    }
+    result = merge_runs(head_, size_ - head_, result);
+    close_runs(head_, size_);
+    head_ = size_;
+    return result;
+}
+
+// 将 runs_[first, first + n) 归并到 result
+template <class Type, class Compare>
+template <class OutputIter>
+OutputIter external_sorter<Type, Compare>::merge_runs(size_t first, size_t n, OutputIter result)
+{
+    typedef external_input_iterator<Type> input_iter;
+
+    external_reader<Type>* readers = new external_reader<Type>[n];
+    try
+    {
+        mystl::loser_tree<input_iter, Compare> tree(n, comp_);
+        for (size_t i = 0; i < n; ++i)
+        {
+            std::FILE* file = runs_[first + i];
+            THROW_RUNTIME_ERROR_IF(std::fseek(file, 0, SEEK_SET) != 0, "external_sort: seek error");
+            readers[i].open(file, io_);
+            tree.set_run(i, input_iter(readers + i), input_iter());
+        }
+        tree.build();
+        while (!tree.empty())
+        {
+            *result = tree.top();
+            ++result;
+            tree.pop();
+        }
+    }
+    catch (...)
+    {
+        delete[] readers;
+        throw;
+    }
+    delete[] readers;
+    return result;
+}
+
+template <class Type, class Compare>
+void external_sorter<Type, Compare>::push_run(std::FILE* file)
+{
+    if (size_ == cap_)
+    {
+        const size_t new_cap = cap_ != 0 ? cap_ * 2 : 16;
+        std::FILE** new_runs = nullptr;
+        try
+        {
+            new_runs = static_cast<std::FILE**>(::operator new(new_cap * sizeof(std::FILE*)));
+        }
+        catch (...)
+        {
+            std::fclose(file);
+            throw;
+        }
+        if (size_ != 0)
+        {
+            std::memcpy(new_runs, runs_, size_ * sizeof(std::FILE*));
+        }
+        ::operator delete(runs_);
+        runs_ = new_runs;
+        cap_ = new_cap;
+    }
+    runs_[size_++] = file;
+}
+
+/*****************************************************************************************/
+// external_sort
+// 版本一：对 [first, last) 排序，结果输出到以 result 起始的位置上，返回一个迭代器指向输出结果的尾部
+//         输入只会被顺序地读取一次，全部读完之后才开始输出
+// 版本二：对文件 input_path 中按原始字节保存的 Type 数组排序，结果写入文件 output_path
+//         输入读完之后才创建输出文件，两者可以是同一个文件
+// 不保证相等元素的相对次序
+/*****************************************************************************************/
+template <class InputIter, class OutputIter, class Compare,
+          typename std::enable_if<mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+OutputIter external_sort(InputIter first, InputIter last, OutputIter result,
+                         const external_sort_options& options, Compare comp)
+{
+    typedef typename mystl::iterator_traits<InputIter>::value_type value_type;
+
+    external_sorter<value_type, Compare> sorter(options, comp);
+    sorter.make_runs(first, last);
+    return sorter.merge_to(result);
+}
+
+template <class InputIter, class OutputIter,
+          typename std::enable_if<mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+OutputIter external_sort(InputIter first, InputIter last, OutputIter result,
+                         const external_sort_options& options = external_sort_options())
+{
+    typedef typename mystl::iterator_traits<InputIter>::value_type value_type;
+    return mystl::external_sort(first, last, result, options, mystl::less<value_type>());
+}
+
+template <class Type, class Compare>
+void external_sort(const char* input_path, const char* output_path,
+                   const external_sort_options& options, Compare comp)
+{
+    external_sorter<Type, Compare> sorter(options, comp);
+    {
+        std::FILE* in = std::fopen(input_path, "rb");
+        THROW_RUNTIME_ERROR_IF(in == nullptr, "external_sort: cannot open input file");
+        try
+        {
+            external_reader<Type> reader;
+            reader.open(in, options.io_buffer_size / sizeof(Type) != 0 ? options.io_buffer_size / sizeof(Type) : 1);
+            sorter.make_runs(external_input_iterator<Type>(&reader), external_input_iterator<Type>());
+        }
+        catch (...)
+        {
+            std::fclose(in);
+            throw;
+        }
+        std::fclose(in);
+    }
+
+    std::FILE* out = std::fopen(output_path, "wb");
+    THROW_RUNTIME_ERROR_IF(out == nullptr, "external_sort: cannot open output file");
+    try
+    {
+        external_writer<Type> writer(out, options.io_buffer_size / sizeof(Type) != 0 ? options.io_buffer_size / sizeof(Type) : 1);
+        sorter.merge_to(external_output_iterator<Type>(&writer));
+        writer.flush();
+    }
+    catch (...)
+    {
+        std::fclose(out);
+        throw;
+    }
+    THROW_RUNTIME_ERROR_IF(std::fclose(out) != 0, "external_sort: write error");
+}
+
+template <class Type>
+void external_sort(const char* input_path, const char* output_path,
+                   const external_sort_options& options = external_sort_options())
+{
+    mystl::external_sort<Type>(input_path, output_path, options, mystl::less<Type>());
+}
+
+}  // end namespace mystl
+
+#endif  // end MINIATURE_STL_EXTERNAL_SORT_H
@@ -4,6 +4,18 @@
 // 这个头文件包含了 mystl 的函数对象与哈希函数
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../00_utils/bitops.h"
+#include "../00_utils/random.h"
+#include "../01_allocators/util.h"
+#include "../03_algorithms/simd_algo.h"
 
 namespace mystl
 {
@@ -132,10 +144,10 @@ struct greater : public binary_function<Type, Type, bool>
 template <typename Type>
 struct less : public binary_function<Type, Type, bool>
 {
-  bool operator()(const Type & x, const Type & y) 
-  {
-    return x < y;
-  }
+    bool operator()(const Type & x, const Type & y) const 
+    {
+        return x < y;
+    }
 };
 
 // 函数对象：大于等于
@@ -296,53 +308,543 @@ MYSTL_TRIVIAL_HASH_FCN(unsigned long long)
 
 #undef MYSTL_TRIVIAL_HASH_FCN
 
-// 对于浮点数，逐位哈希
+/*****************************************************************************************/
+// hash_bytes
+// 计算 [p, p + len) 的 64 位哈希值，seed 不同时得到互不相关的哈希函数
+//
+// 不超过 16 字节时读取首尾两个（可能重叠的）片段，只做两次 128 位乘法；
+// 更长的输入按 wyhash 的方式每步把 16 字节混合进状态，超过 48 字节时三路交错、每步 48 字节；
+// 超过 HashBytesLongThreshold 字节的输入改按 xxh3 的方式使用 8 个累加器，由 simd_hash_stripes 每步处理 64 字节，
+// 开启 AVX2 时向量化，否则使用逐位相同的标量版本
+//
+// 同一个种子下哈希值与编译时开启的指令集无关，但按本机字节序读取输入，在大小端不同的平台间不相同
+// 键可能来自外部输入（例如网络请求中的字符串）时，应当使用 hash_random_seed() 作为种子，防止 HashDoS 攻击
+/*****************************************************************************************/
+// 默认种子
+const uint64_t hash_default_seed = 0x2d358dccaa6c78a5ull;
+
+// 使用 simd_hash_stripes 的最小长度
+const size_t HashBytesLongThreshold = 256;
+
+// 每处理 HashBytesBlockStripes 条 stripe 打乱一次累加器
+const size_t HashBytesBlockStripes = 16;
+
+// 每个进程第一次调用时随机生成、此后保持不变的种子
+inline uint64_t hash_random_seed()
+{
+    static const uint64_t seed = mystl::thread_random_engine()();
+    return seed;
+}
+
+// 128 位乘积的高低两半异或
+inline uint64_t hash_bytes_mix(uint64_t a, uint64_t b) noexcept
+{
+    uint64_t hi;
+    const uint64_t lo = mystl::mul64x64_128(a, b, &hi);
+    return lo ^ hi;
+}
+
+inline uint64_t hash_bytes_read64(const unsigned char* p) noexcept
+{
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+inline uint64_t hash_bytes_read32(const unsigned char* p) noexcept
+{
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+// 长输入使用的密钥：第 j 条 stripe 使用第 [j, j + 8) 个字，打乱累加器与合并结果时使用第 [16, 24) 与 [8, 16) 个字
+inline const uint64_t* hash_bytes_secret() noexcept
+{
+    static const uint64_t secret[24] = {
+        0x4816cbeea44e1165ull, 0x39ce5d7d822fa7dbull, 0x25985ef5085ffdf4ull, 0x65f717d77b83194eull,
+        0x4c0540617ac9beb8ull, 0xccb8fbffa48b1189ull, 0x3a749101eb9fb7deull, 0xe0520cc647945499ull,
+        0x48de63c00cf9b100ull, 0x3afba813ee4dcb68ull, 0xb6182fccbbb1e1a1ull, 0x90ebc52f56c13c78ull,
+        0x09e1a77508595e5bull, 0xe663b44472d4be19ull, 0xf6fa0777690f39a6ull, 0x69f0c5fb093ce646ull,
+        0xc77f0caa54f21117ull, 0xc6293dba20389282ull, 0x25a28a152ea747c3ull, 0x2fe8290efef0efd5ull,
+        0x5c96a7e9221fd4b9ull, 0x2813bb977e050033ull, 0x9e5f3950b016a615ull, 0x7a4b186eccd82239ull};
+    return secret;
+}
+
+// 长输入：8 个累加器，每 HashBytesBlockStripes 条 stripe 打乱一次，最后一条 stripe 与前面的部分可能重叠
+inline uint64_t hash_bytes_long(const unsigned char* p, size_t len, uint64_t seed) noexcept
+{
+    const uint64_t* key = mystl::hash_bytes_secret();
+    uint64_t acc[8] = {0x00000000c2b2ae3dull, 0x9e3779b185ebca87ull, 0xc2b2ae3d27d4eb4full, 0x165667b19e3779f9ull,
+                       0x85ebca77c2b2ae63ull, 0x0000000085ebca77ull, 0x27d4eb2f165667c5ull, 0x000000009e3779b1ull};
+    const size_t stripes = (len - 1) / 64;
+    const size_t blocks = stripes / HashBytesBlockStripes;
+    for (size_t b = 0; b < blocks; ++b, p += HashBytesBlockStripes * 64)
+    {
+        mystl::simd_hash_stripes(acc, p, HashBytesBlockStripes, key, seed);
+        for (size_t i = 0; i < 8; ++i)
+        {
+            acc[i] = (acc[i] ^ (acc[i] >> 47) ^ (key[16 + i] + seed)) * 0x9e3779b1u;
+        }
+    }
+    const size_t rest = stripes - blocks * HashBytesBlockStripes;
+    mystl::simd_hash_stripes(acc, p, rest, key, seed);
+    p += rest * 64;
+    const size_t tail = len - blocks * HashBytesBlockStripes * 64 - rest * 64;
+    mystl::simd_hash_stripes(acc, p + tail - 64, 1, key + 7, seed);
+
+    uint64_t h = static_cast<uint64_t>(len) * 0x9e3779b185ebca87ull;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        h += mystl::hash_bytes_mix(acc[2 * i] ^ (key[8 + 2 * i] + seed), acc[2 * i + 1] ^ (key[9 + 2 * i] - seed));
+    }
+    h ^= h >> 37;
+    h *= 0x165667919e3779f9ull;
+    return h ^ (h >> 32);
+}
+
+inline size_t hash_bytes(const void* ptr, size_t len, uint64_t seed = hash_default_seed) noexcept
+{
+    static const uint64_t s0 = 0xa0761d6478bd642full;
+    static const uint64_t s1 = 0xe7037ed1a0b428dbull;
+    static const uint64_t s2 = 0x8ebc6af09c88c6e3ull;
+    static const uint64_t s3 = 0x589965cc75374cc3ull;
+
+    const unsigned char* p = static_cast<const unsigned char*>(ptr);
+    if (len > HashBytesLongThreshold)
+    {
+        return static_cast<size_t>(mystl::hash_bytes_long(p, len, seed));
+    }
+    seed ^= mystl::hash_bytes_mix(seed ^ s0, s1);
+    uint64_t a, b;
+    if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            // 4 到 16 字节：首尾各取两个 32 位片段，覆盖全部字节
+            const size_t mid = (len >> 3) << 2;
+            a = (mystl::hash_bytes_read32(p) << 32) | mystl::hash_bytes_read32(p + mid);
+            b = (mystl::hash_bytes_read32(p + len - 4) << 32) | mystl::hash_bytes_read32(p + len - 4 - mid);
+        }
+        else if (len > 0)
+        {
+            a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
+    }
+    else
+    {
+        size_t i = len;
+        if (i > 48)
+        {
+            uint64_t see1 = seed, see2 = seed;
+            do
+            {
+                seed = mystl::hash_bytes_mix(mystl::hash_bytes_read64(p) ^ s1, mystl::hash_bytes_read64(p + 8) ^ seed);
+                see1 = mystl::hash_bytes_mix(mystl::hash_bytes_read64(p + 16) ^ s2, mystl::hash_bytes_read64(p + 24) ^ see1);
+                see2 = mystl::hash_bytes_mix(mystl::hash_bytes_read64(p + 32) ^ s3, mystl::hash_bytes_read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16)
+        {
+            seed = mystl::hash_bytes_mix(mystl::hash_bytes_read64(p) ^ s1, mystl::hash_bytes_read64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = mystl::hash_bytes_read64(p + i - 16);
+        b = mystl::hash_bytes_read64(p + i - 8);
+    }
+    a ^= s1;
+    b ^= seed;
+    a = mystl::mul64x64_128(a, b, &b);
+    return static_cast<size_t>(mystl::hash_bytes_mix(a ^ s0 ^ len, b ^ s1));
+}
+
+// 逐字节哈希，保留旧的接口
 inline size_t bitwise_hash(const unsigned char* first, size_t count)
 {
-#if (_MSC_VER && _WIN64) || ((__GNUC__ || __clang__) &&__SIZEOF_POINTER__ == 8)
-    const size_t fnv_offset = 14695981039346656037ull;
-    const size_t fnv_prime = 1099511628211ull;
-#else
-    const size_t fnv_offset = 2166136261u;
-    const size_t fnv_prime = 16777619u;
-#endif
-    size_t result = fnv_offset;
-    for (size_t i = 0; i < count; ++i)
+    return mystl::hash_bytes(first, count);
+}
+
+// 对于浮点数，按对象表示哈希；+0 与 -0 相等，因此都映射为 0
+// long double 只哈希有效的字节，x87 扩展精度格式后面的填充字节的内容是不确定的
+template <class Type>
+struct float_hash
+{
+    static const size_t value_bytes = std::numeric_limits<Type>::digits == 64 && sizeof(Type) > 10 ? 10 : sizeof(Type);
+
+    size_t operator()(const Type& val) const noexcept
     {
-        result ^= (size_t)first[i];
-        result *= fnv_prime;
+        return val == Type(0) ? 0 : mystl::hash_bytes(&val, value_bytes);
     }
-    return result;
+};
+
+template <>
+struct hash<float> : public float_hash<float> {};
+
+template <>
+struct hash<double> : public float_hash<double> {};
+
+template <>
+struct hash<long double> : public float_hash<long double> {};
+
+/*****************************************************************************************/
+// mixed_hash
+// mystl::hash 对整数与指针直接返回原值。键都是 64 的倍数时（对齐的指针、按步长分配的 ID），
+// 在容量为 2 的幂、按低位选桶的哈希表中只会落在 1/64 的桶里
+// mixed_hash 在 Hash 的结果上再做一次 splitmix64 的最终混合（两次乘法、三次移位异或），
+// 它是 64 位上的双射，每个输入位以接近 1/2 的概率影响每个输出位
+// 只做一次 128 位乘法再把高低两半异或的方法更快，但对 i << 32 这类只有高位变化的键，低位的分布很差
+//
+// 哈希表通过 Hash 模板参数选择 mystl::hash 或 mixed_hash，开放定址的哈希表默认使用 mixed_hash
+// is_avalanching_hash 标记结果已经充分混合的哈希函数，mixed_hash 对这类 Hash 不再重复混合
+/*****************************************************************************************/
+inline uint64_t hash_mix64(uint64_t z) noexcept
+{
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// size_t 只有 32 位时截断 hash_mix64 的结果，需要 64 位哈希值的容器直接使用 hash_mix64
+inline size_t hash_mix(size_t h) noexcept
+{
+    return static_cast<size_t>(mystl::hash_mix64(static_cast<uint64_t>(h)));
 }
 
+template <class Hash>
+struct is_avalanching_hash : public std::false_type {};
+
+template <>
+struct is_avalanching_hash<hash<float>> : public std::true_type {};
+
 template <>
-struct hash<float>
+struct is_avalanching_hash<hash<double>> : public std::true_type {};
+
+template <>
+struct is_avalanching_hash<hash<long double>> : public std::true_type {};
+
+template <class Key, class Hash = mystl::hash<Key>>
+struct mixed_hash
 {
-    size_t operator()(const float& val)
-    { 
-        return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(float));
+    Hash hash_fcn;
+
+    size_t operator()(const Key& key) const noexcept(noexcept(std::declval<const Hash&>()(key)))
+    {
+        return mix(hash_fcn(key), is_avalanching_hash<Hash>());
     }
+
+private:
+    static size_t mix(size_t h, std::true_type) noexcept { return h; }
+    static size_t mix(size_t h, std::false_type) noexcept { return mystl::hash_mix(h); }
 };
 
-template <>
-struct hash<double>
+template <class Key, class Hash>
+struct is_avalanching_hash<mixed_hash<Key, Hash>> : public std::true_type {};
+
+// 判断 mystl::hash<Key> 是否可用：只有特化过的类型才能对 const Key& 调用并得到 size_t
+template <class Key, class = void>
+struct is_hashable : public std::false_type {};
+
+template <class Key>
+struct is_hashable<Key, typename std::enable_if<std::is_convertible<
+    decltype(std::declval<mystl::hash<Key>&>()(std::declval<const Key&>())), size_t>::value>::type>
+    : public std::true_type {};
+
+/*****************************************************************************************/
+// hash_combine
+// 把 mystl::hash<Type> 的结果并入 seed，结果与并入的顺序有关
+// 每个字段单独哈希后再混合，组合多个字段时优先使用下面的 hash_append
+/*****************************************************************************************/
+template <class Type>
+void hash_combine(size_t& seed, const Type& value)
+{
+    seed = mystl::hash_mix(seed + 0x9e3779b97f4a7c15ull + mystl::hash<Type>()(value));
+}
+
+/*****************************************************************************************/
+// hash_append
+// 组合键把各个字段依次写入同一个哈希状态，最后只做一次最终混合，
+// 不必先对每个字段求出完整的哈希值再两两混合
+//
+// 哈希状态需要提供 append_word(uint64_t) 与 append_bytes(const void*, size_t)，hash_state 是默认的实现：
+// 每凑齐两个 64 位字做一次 128 位乘法，字节序列交给 hash_bytes，以当前状态作为种子
+//
+// 已经支持的类型：
+//   is_contiguously_hashable 的类型（整数、枚举、指针）按对象表示写入，浮点数把 +0 与 -0 视为相同
+//   mystl::pair、std::tuple、std::array 与内建数组依次写入各个元素
+//   其他可以用 mystl::hash 哈希的类型写入其哈希值
+// 自定义的键可以用两种方式接入：
+//   没有填充字节、按位比较相等的聚合类型，特化 is_contiguously_hashable<Key> 为 true_type，整个对象一次写入
+//   其他类型在键所在的命名空间中定义
+//     template <class HashState> void hash_append(HashState& h, const Key& k) { mystl::hash_append(h, k.a, k.b); }
+// 再以 append_hash<Key> 作为哈希函数，或令 mystl::hash<Key> 继承 append_hash<Key>
+/*****************************************************************************************/
+class hash_state
 {
-    size_t operator()(const double& val)
+private:
+    uint64_t seed_;
+    uint64_t pending_;  // 还没有凑成一对的字
+    uint64_t count_;    // 已写入的字数，一段字节序列按两个字计
+
+public:
+    explicit hash_state(uint64_t seed = hash_default_seed) noexcept
+        : seed_(seed), pending_(0), count_(0) {}
+
+    void append_word(uint64_t word) noexcept
     {
-        return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(double));
+        if (count_ & 1)
+        {
+            seed_ = mystl::hash_bytes_mix(pending_ ^ 0xe7037ed1a0b428dbull, word ^ seed_);
+            pending_ = 0;
+        }
+        else
+        {
+            pending_ = word;
+        }
+        ++count_;
+    }
+
+    void append_bytes(const void* ptr, size_t len) noexcept
+    {
+        if (count_ & 1)
+        {
+            seed_ = mystl::hash_bytes_mix(pending_ ^ 0xe7037ed1a0b428dbull, seed_ ^ 0x8ebc6af09c88c6e3ull);
+            pending_ = 0;
+            ++count_;
+        }
+        seed_ = mystl::hash_bytes(ptr, len, seed_);
+        count_ += 2;
+    }
+
+    size_t finish() const noexcept
+    {
+        return static_cast<size_t>(mystl::hash_bytes_mix(seed_ ^ 0xa0761d6478bd642full ^ count_,
+                                                         pending_ ^ 0xe7037ed1a0b428dbull));
     }
 };
 
-template <>
-struct hash<long double>
+// 判断 Type 能否按对象表示哈希：相等的值的对象表示逐字节相同，且没有填充字节
+template <class Type>
+struct is_contiguously_hashable : public std::integral_constant<bool,
+    std::is_integral<Type>::value || std::is_enum<Type>::value || std::is_pointer<Type>::value> {};
+
+template <class Type, size_t N>
+struct is_contiguously_hashable<Type[N]> : public is_contiguously_hashable<Type> {};
+
+// 判断能否对 Type 调用 hash_append，在下面的重载都声明之后定义
+template <class Type, class = void>
+struct is_hash_appendable;
+
+template <class... Types>
+struct is_all_hash_appendable : public std::true_type {};
+
+template <class Type, class... Types>
+struct is_all_hash_appendable<Type, Types...> : public std::integral_constant<bool,
+    is_hash_appendable<Type>::value && is_all_hash_appendable<Types...>::value> {};
+
+template <class HashState, class Type>
+typename std::enable_if<is_contiguously_hashable<Type>::value || std::is_floating_point<Type>::value ||
+                        is_hashable<Type>::value>::type
+hash_append(HashState& h, const Type& value);
+
+template <class HashState, class Type, size_t N>
+typename std::enable_if<!is_contiguously_hashable<Type>::value && is_hash_appendable<Type>::value>::type
+hash_append(HashState& h, const Type (&value)[N]);
+
+template <class HashState, class Ty1, class Ty2>
+typename std::enable_if<is_hash_appendable<Ty1>::value && is_hash_appendable<Ty2>::value>::type
+hash_append(HashState& h, const mystl::pair<Ty1, Ty2>& value);
+
+template <class HashState, class... Types>
+typename std::enable_if<is_all_hash_appendable<Types...>::value>::type
+hash_append(HashState& h, const std::tuple<Types...>& value);
+
+template <class HashState, class Type, size_t N>
+typename std::enable_if<is_hash_appendable<Type>::value>::type
+hash_append(HashState& h, const std::array<Type, N>& value);
+
+template <class HashState, class Type1, class Type2, class... Types>
+void hash_append(HashState& h, const Type1& value1, const Type2& value2, const Types&... values);
+
+template <class Type, class>
+struct is_hash_appendable : public std::false_type {};
+
+template <class Type>
+struct is_hash_appendable<Type, decltype(hash_append(std::declval<hash_state&>(), std::declval<const Type&>()))>
+    : public std::true_type {};
+
+// 按对象表示写入，不超过一个字的对象补零后作为一个字写入
+template <class HashState, class Type>
+void hash_append_scalar(HashState& h, const Type& value, std::true_type)
+{
+    uint64_t word = 0;
+    std::memcpy(&word, &value, sizeof(Type));
+    h.append_word(word);
+}
+
+template <class HashState, class Type>
+void hash_append_scalar(HashState& h, const Type& value, std::false_type)
 {
-    size_t operator()(const long double& val)
+    h.append_bytes(&value, sizeof(Type));
+}
+
+// 浮点数只写入值所占的字节，与 float_hash 一致；x87 的 long double 有 6 个不确定的填充字节
+template <class HashState, class Type>
+void hash_append_float(HashState& h, const Type& value, std::true_type)
+{
+    mystl::hash_append_scalar(h, value, std::true_type());
+}
+
+template <class HashState, class Type>
+void hash_append_float(HashState& h, const Type& value, std::false_type)
+{
+    h.append_bytes(&value, float_hash<Type>::value_bytes);
+}
+
+template <class HashState, class Type>
+void hash_append_aux(HashState& h, const Type& value, std::true_type, std::false_type)
+{
+    mystl::hash_append_scalar(h, value, std::integral_constant<bool, sizeof(Type) <= sizeof(uint64_t)>());
+}
+
+template <class HashState, class Type>
+void hash_append_aux(HashState& h, const Type& value, std::false_type, std::true_type)
+{
+    if (value == Type(0))
     {
-        return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(long double));
+        h.append_word(0);
+    }
+    else
+    {
+        mystl::hash_append_float(h, value, std::integral_constant<bool, sizeof(Type) <= sizeof(uint64_t)>());
+    }
+}
+
+template <class HashState, class Type>
+void hash_append_aux(HashState& h, const Type& value, std::false_type, std::false_type)
+{
+    h.append_word(static_cast<uint64_t>(mystl::hash<Type>()(value)));
+}
+
+template <class HashState, class Type>
+typename std::enable_if<is_contiguously_hashable<Type>::value || std::is_floating_point<Type>::value ||
+                        is_hashable<Type>::value>::type
+hash_append(HashState& h, const Type& value)
+{
+    mystl::hash_append_aux(h, value, is_contiguously_hashable<Type>(),
+        std::integral_constant<bool, std::is_floating_point<Type>::value &&
+                                     !is_contiguously_hashable<Type>::value>());
+}
+
+template <class HashState, class Type, size_t N>
+typename std::enable_if<!is_contiguously_hashable<Type>::value && is_hash_appendable<Type>::value>::type
+hash_append(HashState& h, const Type (&value)[N])
+{
+    for (size_t i = 0; i < N; ++i)
+    {
+        hash_append(h, value[i]);
+    }
+}
+
+template <class HashState, class Ty1, class Ty2>
+typename std::enable_if<is_hash_appendable<Ty1>::value && is_hash_appendable<Ty2>::value>::type
+hash_append(HashState& h, const mystl::pair<Ty1, Ty2>& value)
+{
+    hash_append(h, value.first);
+    hash_append(h, value.second);
+}
+
+template <size_t I, size_t N>
+struct hash_append_tuple
+{
+    template <class HashState, class Tuple>
+    static void apply(HashState& h, const Tuple& value)
+    {
+        hash_append(h, std::get<I>(value));
+        hash_append_tuple<I + 1, N>::apply(h, value);
     }
 };
 
+template <size_t N>
+struct hash_append_tuple<N, N>
+{
+    template <class HashState, class Tuple>
+    static void apply(HashState&, const Tuple&) {}
+};
+
+template <class HashState, class... Types>
+typename std::enable_if<is_all_hash_appendable<Types...>::value>::type
+hash_append(HashState& h, const std::tuple<Types...>& value)
+{
+    hash_append_tuple<0, sizeof...(Types)>::apply(h, value);
+}
+
+template <class HashState, class Type, size_t N>
+typename std::enable_if<is_hash_appendable<Type>::value>::type
+hash_append(HashState& h, const std::array<Type, N>& value)
+{
+    hash_append_tuple<0, N>::apply(h, value);
+}
+
+// 依次写入多个字段，供自定义类型的 hash_append 使用
+template <class HashState, class Type1, class Type2, class... Types>
+void hash_append(HashState& h, const Type1& value1, const Type2& value2, const Types&... values)
+{
+    hash_append(h, value1);
+    hash_append(h, value2, values...);
+}
+
+// 用 hash_append 实现的哈希函数对象，结果已经充分混合
+template <class Key, class HashState = hash_state>
+struct append_hash
+{
+    size_t operator()(const Key& key) const noexcept
+    {
+        HashState h;
+        hash_append(h, key);
+        return h.finish();
+    }
+};
+
+template <class Key, class HashState>
+struct is_avalanching_hash<append_hash<Key, HashState>> : public std::true_type {};
+
+// 组合键的 mystl::hash：只有各个元素都能 hash_append 时才可用，否则与未特化的 hash 一样为空
+template <class Key, bool>
+struct composite_hash {};
+
+template <class Key>
+struct composite_hash<Key, true> : public append_hash<Key> {};
+
+template <class Ty1, class Ty2>
+struct hash<mystl::pair<Ty1, Ty2>>
+    : public composite_hash<mystl::pair<Ty1, Ty2>,
+                            is_hash_appendable<Ty1>::value && is_hash_appendable<Ty2>::value> {};
+
+template <class... Types>
+struct hash<std::tuple<Types...>>
+    : public composite_hash<std::tuple<Types...>, is_all_hash_appendable<Types...>::value> {};
+
+template <class Type, size_t N>
+struct hash<std::array<Type, N>>
+    : public composite_hash<std::array<Type, N>, is_hash_appendable<Type>::value> {};
+
+template <class Ty1, class Ty2>
+struct is_avalanching_hash<hash<mystl::pair<Ty1, Ty2>>> : public std::true_type {};
+
+template <class... Types>
+struct is_avalanching_hash<hash<std::tuple<Types...>>> : public std::true_type {};
 
+template <class Type, size_t N>
+struct is_avalanching_hash<hash<std::array<Type, N>>> : public std::true_type {};
 
 }  // end namespace mystl
 
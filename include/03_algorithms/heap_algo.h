@@ -2,8 +2,14 @@
 #define MINIATURE_STL_HEAP_ALGO_H
 
 // 这个头文件包含 heap 的四个算法 : push_heap, pop_heap, sort_heap, make_heap
+// 以及它们的 d 叉堆版本，以 push_heap<4>(first, last) 的形式指定每个节点的子节点个数
 
+#include <cstddef>
+
+#include "../00_utils/bitops.h"
 #include "../02_iterators/iterator.h"
+#include "../01_allocators/util.h"
+#include "../03_algorithms/functional.h"
 
 namespace mystl
 {
@@ -39,7 +45,7 @@ void push_heap_d(RandomIter first, RandomIter last, Distance *)
 }
 
 template <typename RandomIter>
-void push_head(RandomIter first, RandomIter last)
+void push_heap(RandomIter first, RandomIter last)
 {
     mystl::push_heap_d(first, last, distance_type(first));
 }
@@ -168,7 +174,7 @@ void sort_heap(RandomIter first, RandomIter last)
     // 每执行一次 pop_heap，最大的元素都被放到尾部，直到容器最多只有一个元素，完成排序
     while (last - first > 1)
     {
-        mystl::pop_heap_aux(first, last);
+        mystl::pop_heap(first, last);
         --last;
     }
 }
@@ -245,6 +251,183 @@ void make_heap(RandomIter first, RandomIter last, BinaryPredicate pred)
     mystl::make_heap_aux(first, last, distance_type(first), pred);
 }
 
+/*****************************************************************************************/
+// d 叉堆：push_heap<Arity>, pop_heap<Arity>, sort_heap<Arity>, make_heap<Arity>
+// 节点 i 的子节点为 Arity * i + 1 ~ Arity * i + Arity，父节点为 (i - 1) / Arity
+// 树高只有二叉堆的 1 / log2(Arity)，Arity 为 4 或 8 时一个节点的子节点通常落在同一条缓存行中，
+// 大堆的下溯每层只有一次缓存未命中；代价是每层要在 Arity 个子节点中选出最大者
+//
+// 下溯采用 Floyd 的自底向上方法：空洞只与子节点比较，一直下移到叶子，再把待放置的元素从叶子上溯；
+// 待放置的元素取自堆的末尾，通常很小，上溯不了几层，省去了每层与它比较的一次
+/*****************************************************************************************/
+template <size_t Arity, typename RandomIter, typename Distance, typename Type, typename Compare>
+void dary_push_heap_aux(RandomIter first, Distance holeIndex, Distance topIndex, Type value, Compare& comp)
+{
+    while (holeIndex > topIndex)
+    {
+        const Distance parent = (holeIndex - 1) / static_cast<Distance>(Arity);
+        if (!comp(*(first + parent), value))
+        {
+            break;
+        }
+        *(first + holeIndex) = mystl::move(*(first + parent));
+        holeIndex = parent;
+    }
+    *(first + holeIndex) = mystl::move(value);
+}
+
+// 在 [child, child + N) 中选出最大的子节点：两两比较的锦标赛，比较结果只参与下标的算术运算，不产生跳转
+template <size_t N>
+struct dary_max_child
+{
+    template <typename RandomIter, typename Distance, typename Compare>
+    static Distance select(RandomIter first, Distance child, Compare& comp)
+    {
+        const Distance a = dary_max_child<N / 2>::select(first, child, comp);
+        const Distance b = dary_max_child<N - N / 2>::select(first, child + static_cast<Distance>(N / 2), comp);
+        return a + (b - a) * static_cast<Distance>(comp(*(first + a), *(first + b)));
+    }
+};
+
+template <>
+struct dary_max_child<1>
+{
+    template <typename RandomIter, typename Distance, typename Compare>
+    static Distance select(RandomIter, Distance child, Compare&)
+    {
+        return child;
+    }
+};
+
+template <size_t Arity, typename RandomIter, typename Distance, typename Type, typename Compare>
+void dary_adjust_heap(RandomIter first, Distance holeIndex, Distance len, Type value, Compare& comp)
+{
+    const Distance arity = static_cast<Distance>(Arity);
+    const Distance topIndex = holeIndex;
+    Distance child = arity * holeIndex + 1;
+    // 子节点齐全的节点；比较之前先预取每个子节点的子节点，下一层的缓存未命中与本层的比较重叠
+    while (child + arity <= len)
+    {
+        const Distance grandchild = arity * child + 1;
+        if (grandchild < len)
+        {
+            const Distance end = len - grandchild < arity * arity ? len : grandchild + arity * arity;
+            for (Distance g = grandchild; g < end; g += arity)
+            {
+                MYSTL_PREFETCH(&*(first + g));
+            }
+        }
+        const Distance best = mystl::dary_max_child<Arity>::select(first, child, comp);
+        *(first + holeIndex) = mystl::move(*(first + best));
+        holeIndex = best;
+        child = arity * holeIndex + 1;
+    }
+    // 最后一个内部节点可能只有部分子节点
+    if (child < len)
+    {
+        Distance best = child;
+        for (Distance c = child + 1; c < len; ++c)
+        {
+            if (comp(*(first + best), *(first + c)))
+            {
+                best = c;
+            }
+        }
+        *(first + holeIndex) = mystl::move(*(first + best));
+        holeIndex = best;
+    }
+    mystl::dary_push_heap_aux<Arity>(first, holeIndex, topIndex, mystl::move(value), comp);
+}
+
+template <size_t Arity, typename RandomIter, typename Compare>
+void push_heap(RandomIter first, RandomIter last, Compare comp)
+{
+    static_assert(Arity >= 2, "the arity of a heap should be at least 2");
+    typedef typename mystl::iterator_traits<RandomIter>::difference_type distance;
+    if (last - first < 2)
+    {
+        return;
+    }
+    auto value = mystl::move(*(last - 1));
+    mystl::dary_push_heap_aux<Arity>(first, static_cast<distance>(last - first - 1), static_cast<distance>(0),
+                                     mystl::move(value), comp);
+}
+
+template <size_t Arity, typename RandomIter>
+void push_heap(RandomIter first, RandomIter last)
+{
+    typedef typename mystl::iterator_traits<RandomIter>::value_type value_type;
+    mystl::push_heap<Arity>(first, last, mystl::less<value_type>());
+}
+
+template <size_t Arity, typename RandomIter, typename Compare>
+void pop_heap(RandomIter first, RandomIter last, Compare comp)
+{
+    static_assert(Arity >= 2, "the arity of a heap should be at least 2");
+    typedef typename mystl::iterator_traits<RandomIter>::difference_type distance;
+    if (last - first < 2)
+    {
+        return;
+    }
+    --last;
+    auto value = mystl::move(*last);
+    *last = mystl::move(*first);
+    mystl::dary_adjust_heap<Arity>(first, static_cast<distance>(0), static_cast<distance>(last - first),
+                                   mystl::move(value), comp);
+}
+
+template <size_t Arity, typename RandomIter>
+void pop_heap(RandomIter first, RandomIter last)
+{
+    typedef typename mystl::iterator_traits<RandomIter>::value_type value_type;
+    mystl::pop_heap<Arity>(first, last, mystl::less<value_type>());
+}
+
+template <size_t Arity, typename RandomIter, typename Compare>
+void sort_heap(RandomIter first, RandomIter last, Compare comp)
+{
+    for (; last - first > 1; --last)
+    {
+        mystl::pop_heap<Arity>(first, last, comp);
+    }
+}
+
+template <size_t Arity, typename RandomIter>
+void sort_heap(RandomIter first, RandomIter last)
+{
+    typedef typename mystl::iterator_traits<RandomIter>::value_type value_type;
+    mystl::sort_heap<Arity>(first, last, mystl::less<value_type>());
+}
+
+template <size_t Arity, typename RandomIter, typename Compare>
+void make_heap(RandomIter first, RandomIter last, Compare comp)
+{
+    static_assert(Arity >= 2, "the arity of a heap should be at least 2");
+    typedef typename mystl::iterator_traits<RandomIter>::difference_type distance;
+    const distance len = last - first;
+    if (len < 2)
+    {
+        return;
+    }
+    // 从最后一个内部节点开始，依次重排以它为根的子树
+    for (distance holeIndex = (len - 2) / static_cast<distance>(Arity); ; --holeIndex)
+    {
+        auto value = mystl::move(*(first + holeIndex));
+        mystl::dary_adjust_heap<Arity>(first, holeIndex, len, mystl::move(value), comp);
+        if (holeIndex == 0)
+        {
+            return;
+        }
+    }
+}
+
+template <size_t Arity, typename RandomIter>
+void make_heap(RandomIter first, RandomIter last)
+{
+    typedef typename mystl::iterator_traits<RandomIter>::value_type value_type;
+    mystl::make_heap<Arity>(first, last, mystl::less<value_type>());
+}
+
 }   // end namespace mystl
 
 
@@ -0,0 +1,252 @@
+#ifndef MINIATURE_STL_MERGE_ALGO_H
+#define MINIATURE_STL_MERGE_ALGO_H
+
+// 这个头文件包含 k 路归并算法 merge_k，以及它所使用的败者树 loser_tree
+
+#include <new>
+#include <type_traits>
+
+#include "../02_iterators/iterator.h"
+#include "../01_allocators/construct.h"
+#include "../01_allocators/util.h"
+#include "../03_algorithms/functional.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// loser_tree
+// 败者树：k 路有序输入的锦标赛树，内部节点记录该场比赛的败者，tree_[0] 记录总冠军
+// 弹出冠军后只需沿该路叶子到根重赛一次，每输出一个元素至多 ceil(log2 k) 次比较，
+// 比二叉堆的 sift-down 少一半左右，而且路径固定，不依赖兄弟节点
+//
+// 每一路只被顺序地读取一次：先用 *iter 复制出当前元素，再 ++iter，
+// 因此可以直接建立在只能前进一次的输入迭代器（例如流式读取文件的迭代器）之上
+// 元素相等时编号较小的一路获胜，归并结果是稳定的
+/*****************************************************************************************/
+template <class InputIter, class Compare>
+class loser_tree
+{
+public:
+    typedef typename mystl::iterator_traits<InputIter>::value_type  value_type;
+    typedef size_t                                                  size_type;
+
+private:
+    // 每一路的状态
+    struct run
+    {
+        InputIter   cur;    // 尚未读取的第一个位置
+        InputIter   last;
+        bool        live;   // heads_ 中是否存有该路的当前元素
+    };
+
+    size_type   k_;
+    size_type*  tree_;      // tree_[0] 为冠军，tree_[1, k) 为各内部节点的败者，叶子 i 的位置为 k + i
+    run*        runs_;
+    value_type* heads_;     // 各路当前元素，只有 live 为 true 时才已构造
+    size_type*  winner_;    // build 时暂存每个内部节点的胜者
+    Compare     comp_;
+
+public:
+    explicit loser_tree(size_type k, Compare comp = Compare())
+        : k_(k), tree_(nullptr), runs_(nullptr), heads_(nullptr), winner_(nullptr), comp_(comp)
+    {
+        if (k_ == 0)
+        {
+            return;
+        }
+        try
+        {
+            tree_ = static_cast<size_type*>(::operator new(k_ * sizeof(size_type)));
+            runs_ = static_cast<run*>(::operator new(k_ * sizeof(run)));
+            heads_ = static_cast<value_type*>(::operator new(k_ * sizeof(value_type)));
+            winner_ = static_cast<size_type*>(::operator new(k_ * sizeof(size_type)));
+        }
+        catch (...)
+        {
+            ::operator delete(heads_);
+            ::operator delete(runs_);
+            ::operator delete(tree_);
+            throw;
+        }
+        for (size_type i = 0; i < k_; ++i)
+        {
+            mystl::construct(runs_ + i);
+            runs_[i].live = false;
+            tree_[i] = i;
+        }
+    }
+
+    loser_tree(const loser_tree&) = delete;
+    loser_tree& operator=(const loser_tree&) = delete;
+
+    ~loser_tree()
+    {
+        if (k_ == 0)
+        {
+            return;
+        }
+        for (size_type i = 0; i < k_; ++i)
+        {
+            if (runs_[i].live)
+            {
+                mystl::destroy(heads_ + i);
+            }
+            mystl::destroy(runs_ + i);
+        }
+        ::operator delete(winner_);
+        ::operator delete(heads_);
+        ::operator delete(runs_);
+        ::operator delete(tree_);
+    }
+
+public:
+    // 设置第 i 路的输入区间，全部设置完毕后调用 build
+    void set_run(size_type i, InputIter first, InputIter last)
+    {
+        run& r = runs_[i];
+        if (r.live)
+        {
+            mystl::destroy(heads_ + i);
+            r.live = false;
+        }
+        r.cur = first;
+        r.last = last;
+        fetch(i);
+    }
+
+    // 自底向上进行第一轮比赛
+    void build()
+    {
+        if (k_ <= 1)
+        {
+            return;
+        }
+        // winner_ 暂存每个内部节点的胜者，叶子直接用路号表示；缓冲区在构造时分配，comp_ 抛出异常也不会泄漏
+        size_type* winner = winner_;
+        for (size_type node = k_ - 1; node > 0; --node)
+        {
+            const size_type l = 2 * node;
+            const size_type r = l + 1;
+            const size_type wl = l >= k_ ? l - k_ : winner[l];
+            const size_type wr = r >= k_ ? r - k_ : winner[r];
+            if (beats(wl, wr))
+            {
+                winner[node] = wl;
+                tree_[node] = wr;
+            }
+            else
+            {
+                winner[node] = wr;
+                tree_[node] = wl;
+            }
+        }
+        tree_[0] = winner[1];
+    }
+
+    // 所有输入都已耗尽
+    bool      empty()     const { return k_ == 0 || !runs_[tree_[0]].live; }
+
+    // 当前冠军所在的路号及其元素
+    size_type top_index() const { return tree_[0]; }
+    value_type& top()           { return heads_[tree_[0]]; }
+
+    // 弹出当前冠军，从同一路补充下一个元素后重赛
+    void pop()
+    {
+        const size_type i = tree_[0];
+        mystl::destroy(heads_ + i);
+        runs_[i].live = false;
+        fetch(i);
+        replay(i);
+    }
+
+private:
+    // 读取第 i 路的下一个元素
+    void fetch(size_type i)
+    {
+        run& r = runs_[i];
+        if (r.cur != r.last)
+        {
+            mystl::construct(heads_ + i, *r.cur);
+            r.live = true;
+            ++r.cur;
+        }
+    }
+
+    // a 是否战胜 b：耗尽的一路总是失败，相等时编号较小者获胜
+    bool beats(size_type a, size_type b)
+    {
+        if (!runs_[a].live)
+        {
+            return false;
+        }
+        if (!runs_[b].live)
+        {
+            return true;
+        }
+        // 每场比赛只调用一次 comp_：编号较小的一路只要不严格小于对方就获胜
+        if (a < b)
+        {
+            return !comp_(heads_[b], heads_[a]);
+        }
+        return comp_(heads_[a], heads_[b]);
+    }
+
+    // 沿叶子 i 到根的路径重赛，胜者继续向上，败者留在节点中
+    void replay(size_type i)
+    {
+        size_type w = i;
+        for (size_type node = (k_ + i) / 2; node > 0; node /= 2)
+        {
+            if (beats(tree_[node], w))
+            {
+                mystl::swap(tree_[node], w);
+            }
+        }
+        tree_[0] = w;
+    }
+};
+
+/*****************************************************************************************/
+// merge_k
+// 将 [first, last) 中的每一路有序区间合并到以 result 起始的位置上，返回一个迭代器指向输出结果的尾部
+// *first 为一个具有 first / second 成员的区间，例如 mystl::pair<InputIter, InputIter>
+// 各路之间元素相等时按路的顺序输出，同一路内保持原有顺序
+/*****************************************************************************************/
+template <class RangeIter, class OutputIter, class Compare>
+OutputIter merge_k(RangeIter first, RangeIter last, OutputIter result, Compare comp)
+{
+    typedef typename std::decay<decltype((*first).first)>::type input_iter;
+
+    const size_t k = static_cast<size_t>(mystl::distance(first, last));
+    if (k == 0)
+    {
+        return result;
+    }
+    mystl::loser_tree<input_iter, Compare> tree(k, comp);
+    for (size_t i = 0; first != last; ++first, ++i)
+    {
+        tree.set_run(i, (*first).first, (*first).second);
+    }
+    tree.build();
+    while (!tree.empty())
+    {
+        *result = mystl::move(tree.top());
+        ++result;
+        tree.pop();
+    }
+    return result;
+}
+
+template <class RangeIter, class OutputIter>
+OutputIter merge_k(RangeIter first, RangeIter last, OutputIter result)
+{
+    typedef typename std::decay<decltype((*first).first)>::type input_iter;
+    typedef typename mystl::iterator_traits<input_iter>::value_type value_type;
+    return mystl::merge_k(first, last, result, mystl::less<value_type>());
+}
+
+}  // end namespace mystl
+
+#endif  // end MINIATURE_STL_MERGE_ALGO_H
@@ -0,0 +1,883 @@
+#ifndef MINIATURE_STL_NUMERIC_H
+#define MINIATURE_STL_NUMERIC_H
+
+// 这个头文件包含了 mystl 的数值算法
+//
+// accumulate / inner_product 按从左到右的顺序计算，结果与逐个累加完全一致；
+// reduce / transform_reduce 假定运算满足结合律与交换律，使用多个相互独立的累加器，
+// 对连续内存上的算术类型使用 SIMD 内核，并提供带执行策略的并行版本，浮点数的结果可能与顺序累加略有不同
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#include "../00_utils/parallel.h"
+#include "../01_allocators/util.h"
+#include "../02_iterators/iterator.h"
+#include "../03_algorithms/functional.h"
+#include "../03_algorithms/simd_algo.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// accumulate
+// 版本1：以初值 init 对每个元素进行累加
+// 版本2：以初值 init 对每个元素进行二元操作
+// 分段迭代器（如 deque 的迭代器）逐段在原生指针上按原有次序累加
+/*****************************************************************************************/
+template <class InputIter, class Type, class BinaryOp>
+Type accumulate_aux(InputIter first, InputIter last, Type init, BinaryOp& op, std::false_type)
+{
+    for (; first != last; ++first)
+    {
+        init = op(init, *first);
+    }
+    return init;
+}
+
+template <class InputIter, class Type, class BinaryOp>
+Type accumulate_aux(InputIter first, InputIter last, Type init, BinaryOp& op, std::true_type)
+{
+    typedef typename segmented_iterator_traits<InputIter>::local_iterator local_iterator;
+    mystl::segmented_for_each_block(first, last, [&init, &op](local_iterator f, local_iterator l)
+    {
+        init = mystl::accumulate_aux(f, l, init, op, std::false_type());
+    });
+    return init;
+}
+
+template <class InputIter, class Type>
+Type accumulate(InputIter first, InputIter last, Type init)
+{
+    auto op = [](const Type& x, typename iterator_traits<InputIter>::reference y) { return x + y; };
+    return mystl::accumulate_aux(first, last, init, op, mystl::is_segmented_iterator<InputIter>());
+}
+
+template <class InputIter, class Type, class BinaryOp>
+Type accumulate(InputIter first, InputIter last, Type init, BinaryOp op)
+{
+    return mystl::accumulate_aux(first, last, init, op, mystl::is_segmented_iterator<InputIter>());
+}
+
+/*****************************************************************************************/
+// inner_product
+// 版本1：以 init 为初值，计算两个区间的内积
+// 版本2：自定义 operator+ 和 operator*
+/*****************************************************************************************/
+template <class InputIter1, class InputIter2, class Type>
+Type inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, Type init)
+{
+    for (; first1 != last1; ++first1, ++first2)
+    {
+        init = init + (*first1 * *first2);
+    }
+    return init;
+}
+
+template <class InputIter1, class InputIter2, class Type, class BinaryOp1, class BinaryOp2>
+Type inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, Type init,
+                   BinaryOp1 op1, BinaryOp2 op2)
+{
+    for (; first1 != last1; ++first1, ++first2)
+    {
+        init = op1(init, op2(*first1, *first2));
+    }
+    return init;
+}
+
+/*****************************************************************************************/
+// iota
+// 填充[first, last)，以 value 为初值开始递增
+/*****************************************************************************************/
+template <class ForwardIter, class Type>
+void iota(ForwardIter first, ForwardIter last, Type value)
+{
+    for (; first != last; ++first, ++value)
+    {
+        *first = value;
+    }
+}
+
+/*****************************************************************************************/
+// adjacent_difference
+// 版本1：计算相邻元素的差值，结果保存到以 result 为起始的区间上
+// 版本2：自定义相邻元素的二元操作
+/*****************************************************************************************/
+template <class InputIter, class OutputIter>
+OutputIter adjacent_difference(InputIter first, InputIter last, OutputIter result)
+{
+    typedef typename mystl::iterator_traits<InputIter>::value_type value_type;
+
+    if (first == last)
+    {
+        return result;
+    }
+    value_type prev = *first;
+    *result = prev;
+    while (++first != last)
+    {
+        value_type cur = *first;
+        *++result = cur - prev;
+        prev = mystl::move(cur);
+    }
+    return ++result;
+}
+
+template <class InputIter, class OutputIter, class BinaryOp>
+OutputIter adjacent_difference(InputIter first, InputIter last, OutputIter result, BinaryOp op)
+{
+    typedef typename mystl::iterator_traits<InputIter>::value_type value_type;
+
+    if (first == last)
+    {
+        return result;
+    }
+    value_type prev = *first;
+    *result = prev;
+    while (++first != last)
+    {
+        value_type cur = *first;
+        *++result = op(cur, prev);
+        prev = mystl::move(cur);
+    }
+    return ++result;
+}
+
+/*****************************************************************************************/
+// partial_sum
+// 版本1：计算局部累计求和，结果保存到以 result 为起始的区间上
+// 版本2：进行局部进行自定义二元操作
+/*****************************************************************************************/
+template <class InputIter, class OutputIter>
+OutputIter partial_sum(InputIter first, InputIter last, OutputIter result)
+{
+    typedef typename mystl::iterator_traits<InputIter>::value_type value_type;
+
+    if (first == last)
+    {
+        return result;
+    }
+    value_type sum = *first;
+    *result = sum;
+    while (++first != last)
+    {
+        sum = sum + *first;
+        *++result = sum;
+    }
+    return ++result;
+}
+
+template <class InputIter, class OutputIter, class BinaryOp>
+OutputIter partial_sum(InputIter first, InputIter last, OutputIter result, BinaryOp op)
+{
+    typedef typename mystl::iterator_traits<InputIter>::value_type value_type;
+
+    if (first == last)
+    {
+        return result;
+    }
+    value_type sum = *first;
+    *result = sum;
+    while (++first != last)
+    {
+        sum = op(sum, *first);
+        *++result = sum;
+    }
+    return ++result;
+}
+
+/*****************************************************************************************/
+// 多累加器归约
+// 对 get(0), get(1), ..., get(n - 1) 做归约，四个累加器交替累加，打断相邻两次 op 之间的依赖，
+// 让乘加等长延迟运算可以流水执行；要求 op 满足结合律与交换律
+/*****************************************************************************************/
+template <class Size, class Type, class BinaryOp, class Getter>
+Type multi_reduce(Size n, Type init, BinaryOp op, Getter get)
+{
+    if (n < 7)
+    {
+        for (Size i = 0; i < n; ++i)
+        {
+            init = op(init, get(i));
+        }
+        return init;
+    }
+    Type s0 = op(init, get(0));
+    Type s1 = op(get(1), get(2));
+    Type s2 = op(get(3), get(4));
+    Type s3 = op(get(5), get(6));
+    Size i = 7;
+    for (; i + 4 <= n; i += 4)
+    {
+        s0 = op(s0, get(i));
+        s1 = op(s1, get(i + 1));
+        s2 = op(s2, get(i + 2));
+        s3 = op(s3, get(i + 3));
+    }
+    for (; i < n; ++i)
+    {
+        s0 = op(s0, get(i));
+    }
+    return op(op(s0, s1), op(s2, s3));
+}
+
+// 指向 Type 的连续内存，且 Type 有对应的 SIMD 内核
+template <class Iter, class Type>
+struct is_simd_numeric_range : public std::integral_constant<bool,
+    std::is_pointer<Iter>::value &&
+    std::is_same<typename std::remove_cv<typename std::remove_pointer<Iter>::type>::type, Type>::value &&
+    (std::is_same<Type, float>::value || std::is_same<Type, double>::value)> {};
+
+// 整数求和只需要按同宽度的无符号数回绕相加
+template <class Type, bool = std::is_integral<Type>::value && !std::is_same<Type, bool>::value>
+struct simd_sum_lane
+{
+    typedef void type;
+};
+
+template <class Type>
+struct simd_sum_lane<Type, true>
+{
+    typedef typename std::make_unsigned<Type>::type unsigned_type;
+    typedef typename std::conditional<std::is_same<unsigned_type, uint32_t>::value ||
+                                      std::is_same<unsigned_type, uint64_t>::value, unsigned_type, void>::type type;
+};
+
+// reduce 可以使用 simd_reduce_add 的情形
+template <class Iter, class Type, class BinaryOp>
+struct is_simd_reduce_add : public std::integral_constant<bool,
+    std::is_same<BinaryOp, mystl::plus<Type>>::value &&
+    std::is_pointer<Iter>::value &&
+    std::is_same<typename std::remove_cv<typename std::remove_pointer<Iter>::type>::type, Type>::value &&
+    (std::is_same<Type, float>::value || std::is_same<Type, double>::value ||
+     !std::is_void<typename simd_sum_lane<Type>::type>::value)> {};
+
+// transform_reduce 可以使用 simd_dot 的情形
+template <class Iter1, class Iter2, class Type, class BinaryOp1, class BinaryOp2>
+struct is_simd_dot : public std::integral_constant<bool,
+    std::is_same<BinaryOp1, mystl::plus<Type>>::value &&
+    std::is_same<BinaryOp2, mystl::multiplies<Type>>::value &&
+    is_simd_numeric_range<Iter1, Type>::value && is_simd_numeric_range<Iter2, Type>::value> {};
+
+/*****************************************************************************************/
+// reduce
+// 版本1：以 value_type() 为初值求 [first, last) 中元素的和
+// 版本2：以 init 为初值求和
+// 版本3：以 init 为初值，用二元操作 op 归约，op 必须满足结合律与交换律，元素的计算次序不确定
+/*****************************************************************************************/
+template <class InputIter, class Type, class BinaryOp>
+Type reduce_dispatch(InputIter first, InputIter last, Type init, BinaryOp op, mystl::input_iterator_tag)
+{
+    for (; first != last; ++first)
+    {
+        init = op(init, *first);
+    }
+    return init;
+}
+
+template <class RandomIter, class Type, class BinaryOp>
+Type reduce_dispatch(RandomIter first, RandomIter last, Type init, BinaryOp op, mystl::random_access_iterator_tag)
+{
+    return mystl::multi_reduce(last - first, init, op,
+                               [first](typename mystl::iterator_traits<RandomIter>::difference_type i)
+                               -> decltype(first[i]) { return first[i]; });
+}
+
+template <class InputIter, class Type, class BinaryOp>
+Type reduce_aux(InputIter first, InputIter last, Type init, BinaryOp op, std::false_type)
+{
+    return mystl::reduce_dispatch(first, last, init, op, mystl::iterator_category(first));
+}
+
+// 浮点数
+template <class Type>
+Type simd_sum_aux(const Type* first, size_t n, Type init, std::false_type)
+{
+    return init + mystl::simd_reduce_add(first, n);
+}
+
+// 整数：按无符号数回绕相加
+template <class Type>
+Type simd_sum_aux(const Type* first, size_t n, Type init, std::true_type)
+{
+    typedef typename simd_sum_lane<Type>::type lane_type;
+    const lane_type sum = mystl::simd_reduce_add(reinterpret_cast<const lane_type*>(first), n);
+    return static_cast<Type>(static_cast<lane_type>(static_cast<lane_type>(init) + sum));
+}
+
+template <class Pointer, class Type, class BinaryOp>
+Type reduce_aux(Pointer first, Pointer last, Type init, BinaryOp, std::true_type)
+{
+    return mystl::simd_sum_aux(static_cast<const Type*>(first), static_cast<size_t>(last - first), init,
+                               std::is_integral<Type>());
+}
+
+template <class InputIter, class Type, class BinaryOp>
+Type reduce(InputIter first, InputIter last, Type init, BinaryOp op)
+{
+    return mystl::reduce_aux(first, last, init, op, is_simd_reduce_add<InputIter, Type, BinaryOp>());
+}
+
+template <class InputIter, class Type>
+Type reduce(InputIter first, InputIter last, Type init)
+{
+    return mystl::reduce(first, last, init, mystl::plus<Type>());
+}
+
+template <class InputIter>
+typename mystl::iterator_traits<InputIter>::value_type
+reduce(InputIter first, InputIter last)
+{
+    typedef typename mystl::iterator_traits<InputIter>::value_type value_type;
+    return mystl::reduce(first, last, value_type(), mystl::plus<value_type>());
+}
+
+/*****************************************************************************************/
+// transform_reduce
+// 版本1：以 init 为初值，求两个区间的内积
+// 版本2：以 init 为初值，先对两个区间的对应元素做 transform_op，再用 reduce_op 归约
+// 版本3：以 init 为初值，先对每个元素做 transform_op，再用 reduce_op 归约
+// 与 reduce 相同，reduce_op 必须满足结合律与交换律
+/*****************************************************************************************/
+template <class InputIter1, class InputIter2, class Type, class BinaryOp1, class BinaryOp2>
+Type transform_reduce_dispatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, Type init,
+                               BinaryOp1 reduce_op, BinaryOp2 transform_op, mystl::input_iterator_tag)
+{
+    for (; first1 != last1; ++first1, ++first2)
+    {
+        init = reduce_op(init, transform_op(*first1, *first2));
+    }
+    return init;
+}
+
+template <class RandomIter1, class RandomIter2, class Type, class BinaryOp1, class BinaryOp2>
+Type transform_reduce_dispatch(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, Type init,
+                               BinaryOp1 reduce_op, BinaryOp2 transform_op, mystl::random_access_iterator_tag)
+{
+    return mystl::multi_reduce(last1 - first1, init, reduce_op,
+                               [first1, first2, &transform_op](typename mystl::iterator_traits<RandomIter1>::difference_type i)
+                               { return transform_op(first1[i], first2[i]); });
+}
+
+template <class InputIter1, class InputIter2, class Type, class BinaryOp1, class BinaryOp2>
+Type transform_reduce_aux(InputIter1 first1, InputIter1 last1, InputIter2 first2, Type init,
+                          BinaryOp1 reduce_op, BinaryOp2 transform_op, std::false_type)
+{
+    // 两个区间都支持随机访问时才使用多累加器
+    typedef typename std::conditional<
+        mystl::is_random_access_iterator<InputIter1>::value && mystl::is_random_access_iterator<InputIter2>::value,
+        mystl::random_access_iterator_tag, mystl::input_iterator_tag>::type category;
+    return mystl::transform_reduce_dispatch(first1, last1, first2, init, reduce_op, transform_op, category());
+}
+
+template <class Pointer1, class Pointer2, class Type, class BinaryOp1, class BinaryOp2>
+Type transform_reduce_aux(Pointer1 first1, Pointer1 last1, Pointer2 first2, Type init,
+                          BinaryOp1, BinaryOp2, std::true_type)
+{
+    return init + mystl::simd_dot(static_cast<const Type*>(first1), static_cast<const Type*>(first2),
+                                  static_cast<size_t>(last1 - first1));
+}
+
+template <class InputIter1, class InputIter2, class Type, class BinaryOp1, class BinaryOp2>
+Type transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, Type init,
+                      BinaryOp1 reduce_op, BinaryOp2 transform_op)
+{
+    return mystl::transform_reduce_aux(first1, last1, first2, init, reduce_op, transform_op,
+                                       is_simd_dot<InputIter1, InputIter2, Type, BinaryOp1, BinaryOp2>());
+}
+
+template <class InputIter1, class InputIter2, class Type>
+Type transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, Type init)
+{
+    return mystl::transform_reduce(first1, last1, first2, init, mystl::plus<Type>(), mystl::multiplies<Type>());
+}
+
+template <class InputIter, class Type, class BinaryOp, class UnaryOp>
+Type transform_reduce_dispatch(InputIter first, InputIter last, Type init,
+                               BinaryOp reduce_op, UnaryOp transform_op, mystl::input_iterator_tag)
+{
+    for (; first != last; ++first)
+    {
+        init = reduce_op(init, transform_op(*first));
+    }
+    return init;
+}
+
+template <class RandomIter, class Type, class BinaryOp, class UnaryOp>
+Type transform_reduce_dispatch(RandomIter first, RandomIter last, Type init,
+                               BinaryOp reduce_op, UnaryOp transform_op, mystl::random_access_iterator_tag)
+{
+    return mystl::multi_reduce(last - first, init, reduce_op,
+                               [first, &transform_op](typename mystl::iterator_traits<RandomIter>::difference_type i)
+                               { return transform_op(first[i]); });
+}
+
+template <class InputIter, class Type, class BinaryOp, class UnaryOp>
+Type transform_reduce(InputIter first, InputIter last, Type init, BinaryOp reduce_op, UnaryOp transform_op)
+{
+    return mystl::transform_reduce_dispatch(first, last, init, reduce_op, transform_op,
+                                            mystl::iterator_category(first));
+}
+
+/*****************************************************************************************/
+// 并行归约
+// 把 n 个元素平均分给 parts 个线程，每个线程对自己的分块调用 chunk(begin, end) 求出部分和，
+// 最后在当前线程上按分块顺序合并；parts 由 parallel_thread_count 得出，大于 1 时每块至少有两个元素
+/*****************************************************************************************/
+template <class Type, class BinaryOp, class ChunkReduce>
+Type parallel_reduce_aux(size_t n, size_t parts, Type init, BinaryOp op, ChunkReduce chunk)
+{
+    mystl::parallel_buffer<Type> partial(parts);
+    mystl::parallel_invoke_n(parts, [&](size_t t)
+    {
+        partial.construct(t, chunk(mystl::parallel_chunk_begin(n, parts, t),
+                                   mystl::parallel_chunk_begin(n, parts, t + 1)));
+    });
+    for (size_t t = 0; t < parts; ++t)
+    {
+        init = op(init, partial[t]);
+    }
+    return init;
+}
+
+// 顺序执行，或者迭代器不支持随机访问时
+template <class Policy, class InputIter, class Type, class BinaryOp, class Category>
+Type reduce_policy(const Policy&, InputIter first, InputIter last, Type init, BinaryOp op, Category)
+{
+    return mystl::reduce(first, last, init, op);
+}
+
+template <class RandomIter, class Type, class BinaryOp>
+Type reduce_policy(const execution::parallel_policy&, RandomIter first, RandomIter last, Type init, BinaryOp op,
+                   mystl::random_access_iterator_tag)
+{
+    const size_t n = static_cast<size_t>(last - first);
+    const size_t parts = mystl::parallel_thread_count(n);
+    if (parts == 1)
+    {
+        return mystl::reduce(first, last, init, op);
+    }
+    return mystl::parallel_reduce_aux(n, parts, init, op,
+                                      [first, &op](size_t b, size_t e)
+                                      {
+                                          // 分块中至少有两个元素，用前两个元素的和作为初值
+                                          return mystl::reduce(first + b + 2, first + e, Type(op(first[b], first[b + 1])), op);
+                                      });
+}
+
+template <class ExecutionPolicy, class ForwardIter, class Type, class BinaryOp>
+typename std::enable_if<mystl::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, Type>::type
+reduce(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, Type init, BinaryOp op)
+{
+    return mystl::reduce_policy(policy, first, last, init, op, mystl::iterator_category(first));
+}
+
+template <class ExecutionPolicy, class ForwardIter, class Type>
+typename std::enable_if<mystl::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, Type>::type
+reduce(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, Type init)
+{
+    return mystl::reduce(policy, first, last, init, mystl::plus<Type>());
+}
+
+template <class ExecutionPolicy, class ForwardIter>
+typename std::enable_if<mystl::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value,
+                        typename mystl::iterator_traits<ForwardIter>::value_type>::type
+reduce(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last)
+{
+    typedef typename mystl::iterator_traits<ForwardIter>::value_type value_type;
+    return mystl::reduce(policy, first, last, value_type(), mystl::plus<value_type>());
+}
+
+// 两个区间的 transform_reduce
+template <class Policy, class InputIter1, class InputIter2, class Type, class BinaryOp1, class BinaryOp2, class Category>
+Type transform_reduce_policy(const Policy&, InputIter1 first1, InputIter1 last1, InputIter2 first2, Type init,
+                             BinaryOp1 reduce_op, BinaryOp2 transform_op, Category)
+{
+    return mystl::transform_reduce(first1, last1, first2, init, reduce_op, transform_op);
+}
+
+template <class RandomIter1, class RandomIter2, class Type, class BinaryOp1, class BinaryOp2>
+Type transform_reduce_policy(const execution::parallel_policy&, RandomIter1 first1, RandomIter1 last1, RandomIter2 first2,
+                             Type init, BinaryOp1 reduce_op, BinaryOp2 transform_op, mystl::random_access_iterator_tag)
+{
+    const size_t n = static_cast<size_t>(last1 - first1);
+    const size_t parts = mystl::parallel_thread_count(n);
+    if (parts == 1)
+    {
+        return mystl::transform_reduce(first1, last1, first2, init, reduce_op, transform_op);
+    }
+    return mystl::parallel_reduce_aux(n, parts, init, reduce_op,
+                                      [first1, first2, &reduce_op, &transform_op](size_t b, size_t e)
+                                      {
+                                          const Type seed = reduce_op(transform_op(first1[b], first2[b]),
+                                                                      transform_op(first1[b + 1], first2[b + 1]));
+                                          return mystl::transform_reduce(first1 + b + 2, first1 + e, first2 + b + 2,
+                                                                         seed, reduce_op, transform_op);
+                                      });
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class Type, class BinaryOp1, class BinaryOp2>
+typename std::enable_if<mystl::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, Type>::type
+transform_reduce(ExecutionPolicy&& policy, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, Type init,
+                 BinaryOp1 reduce_op, BinaryOp2 transform_op)
+{
+    typedef typename std::conditional<
+        mystl::is_random_access_iterator<ForwardIter1>::value && mystl::is_random_access_iterator<ForwardIter2>::value,
+        mystl::random_access_iterator_tag, mystl::input_iterator_tag>::type category;
+    return mystl::transform_reduce_policy(policy, first1, last1, first2, init, reduce_op, transform_op, category());
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class Type>
+typename std::enable_if<mystl::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, Type>::type
+transform_reduce(ExecutionPolicy&& policy, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, Type init)
+{
+    return mystl::transform_reduce(policy, first1, last1, first2, init, mystl::plus<Type>(), mystl::multiplies<Type>());
+}
+
+// 一个区间的 transform_reduce
+template <class Policy, class InputIter, class Type, class BinaryOp, class UnaryOp, class Category>
+Type transform_reduce_policy(const Policy&, InputIter first, InputIter last, Type init,
+                             BinaryOp reduce_op, UnaryOp transform_op, Category)
+{
+    return mystl::transform_reduce(first, last, init, reduce_op, transform_op);
+}
+
+template <class RandomIter, class Type, class BinaryOp, class UnaryOp>
+Type transform_reduce_policy(const execution::parallel_policy&, RandomIter first, RandomIter last, Type init,
+                             BinaryOp reduce_op, UnaryOp transform_op, mystl::random_access_iterator_tag)
+{
+    const size_t n = static_cast<size_t>(last - first);
+    const size_t parts = mystl::parallel_thread_count(n);
+    if (parts == 1)
+    {
+        return mystl::transform_reduce(first, last, init, reduce_op, transform_op);
+    }
+    return mystl::parallel_reduce_aux(n, parts, init, reduce_op,
+                                      [first, &reduce_op, &transform_op](size_t b, size_t e)
+                                      {
+                                          const Type seed = reduce_op(transform_op(first[b]), transform_op(first[b + 1]));
+                                          return mystl::transform_reduce(first + b + 2, first + e, seed,
+                                                                         reduce_op, transform_op);
+                                      });
+}
+
+template <class ExecutionPolicy, class ForwardIter, class Type, class BinaryOp, class UnaryOp>
+typename std::enable_if<mystl::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, Type>::type
+transform_reduce(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, Type init,
+                 BinaryOp reduce_op, UnaryOp transform_op)
+{
+    return mystl::transform_reduce_policy(policy, first, last, init, reduce_op, transform_op,
+                                          mystl::iterator_category(first));
+}
+
+/*****************************************************************************************/
+// inclusive_scan / exclusive_scan / transform_inclusive_scan / transform_exclusive_scan
+// 求前缀和，结果保存到以 result 为起始的区间上，result 可以等于 first
+// inclusive 版本的第 i 个结果包含第 i 个元素，exclusive 版本不包含；transform 版本先对每个元素做 transform_op
+// 与 partial_sum 不同，op 只需要满足结合律，计算时可以改变结合的方式
+/*****************************************************************************************/
+
+// scan 可以使用 simd_scan_add 的情形：连续内存上的 Type，op 为 plus，不做变换
+template <class InputIter, class OutputIter, class Type, class BinaryOp, class UnaryOp>
+struct is_simd_scan_add : public std::integral_constant<bool,
+    is_simd_reduce_add<InputIter, Type, BinaryOp>::value &&
+    std::is_same<OutputIter, Type*>::value &&
+    std::is_same<UnaryOp, mystl::identity<Type>>::value> {};
+
+// 从 carry 开始顺序扫描
+template <bool Inclusive, class InputIter, class OutputIter, class Type, class BinaryOp, class UnaryOp>
+OutputIter scan_aux(InputIter first, InputIter last, OutputIter result, Type carry,
+                    BinaryOp op, UnaryOp transform_op, std::false_type)
+{
+    for (; first != last; ++first, ++result)
+    {
+        // 先读出当前元素再写结果，result 与 first 相同时也正确
+        Type next = op(carry, transform_op(*first));
+        if (Inclusive)
+        {
+            carry = mystl::move(next);
+            *result = carry;
+        }
+        else
+        {
+            *result = mystl::move(carry);
+            carry = mystl::move(next);
+        }
+    }
+    return result;
+}
+
+// 浮点数
+template <bool Inclusive, class Type>
+void simd_scan_aux(const Type* first, size_t n, Type* result, Type carry, std::false_type)
+{
+    mystl::simd_scan_add<Inclusive>(first, result, n, carry);
+}
+
+// 整数：按无符号数回绕相加
+template <bool Inclusive, class Type>
+void simd_scan_aux(const Type* first, size_t n, Type* result, Type carry, std::true_type)
+{
+    typedef typename simd_sum_lane<Type>::type lane_type;
+    mystl::simd_scan_add<Inclusive>(reinterpret_cast<const lane_type*>(first), reinterpret_cast<lane_type*>(result),
+                                    n, static_cast<lane_type>(carry));
+}
+
+template <bool Inclusive, class Pointer, class Type, class BinaryOp, class UnaryOp>
+Type* scan_aux(Pointer first, Pointer last, Type* result, Type carry, BinaryOp, UnaryOp, std::true_type)
+{
+    const size_t n = static_cast<size_t>(last - first);
+    mystl::simd_scan_aux<Inclusive>(static_cast<const Type*>(first), n, result, carry, std::is_integral<Type>());
+    return result + n;
+}
+
+template <bool Inclusive, class InputIter, class OutputIter, class Type, class BinaryOp, class UnaryOp>
+OutputIter scan_carry(InputIter first, InputIter last, OutputIter result, Type carry, BinaryOp op, UnaryOp transform_op)
+{
+    return mystl::scan_aux<Inclusive>(first, last, result, carry, op, transform_op,
+                                      is_simd_scan_add<InputIter, OutputIter, Type, BinaryOp, UnaryOp>());
+}
+
+template <class InputIter, class OutputIter, class Type, class BinaryOp>
+OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result, BinaryOp op, Type init)
+{
+    return mystl::scan_carry<true>(first, last, result, init, op,
+                                   mystl::identity<typename mystl::iterator_traits<InputIter>::value_type>());
+}
+
+template <class InputIter, class OutputIter, class BinaryOp>
+OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result, BinaryOp op)
+{
+    typedef typename mystl::iterator_traits<InputIter>::value_type value_type;
+
+    if (first == last)
+    {
+        return result;
+    }
+    value_type carry = *first;
+    *result = carry;
+    return mystl::inclusive_scan(++first, last, ++result, op, carry);
+}
+
+template <class InputIter, class OutputIter>
+OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result)
+{
+    typedef typename mystl::iterator_traits<InputIter>::value_type value_type;
+    return mystl::inclusive_scan(first, last, result, mystl::plus<value_type>());
+}
+
+template <class InputIter, class OutputIter, class Type, class BinaryOp>
+OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result, Type init, BinaryOp op)
+{
+    return mystl::scan_carry<false>(first, last, result, init, op,
+                                    mystl::identity<typename mystl::iterator_traits<InputIter>::value_type>());
+}
+
+template <class InputIter, class OutputIter, class Type>
+OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result, Type init)
+{
+    return mystl::exclusive_scan(first, last, result, init, mystl::plus<Type>());
+}
+
+template <class InputIter, class OutputIter, class Type, class BinaryOp, class UnaryOp>
+OutputIter transform_inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                                    BinaryOp op, UnaryOp transform_op, Type init)
+{
+    return mystl::scan_carry<true>(first, last, result, init, op, transform_op);
+}
+
+template <class InputIter, class OutputIter, class BinaryOp, class UnaryOp>
+OutputIter transform_inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                                    BinaryOp op, UnaryOp transform_op)
+{
+    if (first == last)
+    {
+        return result;
+    }
+    typename std::decay<decltype(transform_op(*first))>::type carry = transform_op(*first);
+    *result = carry;
+    return mystl::transform_inclusive_scan(++first, last, ++result, op, transform_op, carry);
+}
+
+template <class InputIter, class OutputIter, class Type, class BinaryOp, class UnaryOp>
+OutputIter transform_exclusive_scan(InputIter first, InputIter last, OutputIter result,
+                                    Type init, BinaryOp op, UnaryOp transform_op)
+{
+    return mystl::scan_carry<false>(first, last, result, init, op, transform_op);
+}
+
+/*****************************************************************************************/
+// 并行前缀和
+// 两趟算法：把区间平均分为 parts 块，第一趟并行求出前 parts - 1 块各自的和，
+// 在当前线程上对这些和做一次 exclusive scan 得到每块的进位，第二趟各块以自己的进位为初值并行扫描
+// 总共只多读一遍输入，且两趟都是顺序访存
+/*****************************************************************************************/
+
+// 求一个分块的和，分块中至少有两个元素
+template <class RandomIter, class Type, class BinaryOp, class UnaryOp>
+Type scan_chunk_sum(RandomIter first, RandomIter last, BinaryOp op, UnaryOp transform_op, std::false_type)
+{
+    // op 不一定满足交换律，只能从左到右结合
+    Type sum = op(transform_op(*first), transform_op(*(first + 1)));
+    for (first += 2; first != last; ++first)
+    {
+        sum = op(sum, transform_op(*first));
+    }
+    return sum;
+}
+
+template <class Pointer, class Type, class BinaryOp, class UnaryOp>
+Type scan_chunk_sum(Pointer first, Pointer last, BinaryOp op, UnaryOp, std::true_type)
+{
+    return mystl::reduce(first, last, Type(), op);
+}
+
+template <bool Inclusive, class RandomIter1, class RandomIter2, class Type, class BinaryOp, class UnaryOp>
+RandomIter2 parallel_scan_aux(RandomIter1 first, RandomIter1 last, RandomIter2 result, Type init,
+                              BinaryOp op, UnaryOp transform_op)
+{
+    const size_t n = static_cast<size_t>(last - first);
+    const size_t parts = mystl::parallel_thread_count(n);
+    if (parts == 1)
+    {
+        return mystl::scan_carry<Inclusive>(first, last, result, init, op, transform_op);
+    }
+
+    typedef is_simd_scan_add<RandomIter1, RandomIter2, Type, BinaryOp, UnaryOp> simd;
+
+    // 第一趟：最后一块的和用不到，不必计算
+    mystl::parallel_buffer<Type> sum(parts - 1);
+    mystl::parallel_invoke_n(parts - 1, [&](size_t t)
+    {
+        sum.construct(t, mystl::scan_chunk_sum<RandomIter1, Type>(first + mystl::parallel_chunk_begin(n, parts, t),
+                                                                  first + mystl::parallel_chunk_begin(n, parts, t + 1),
+                                                                  op, transform_op, simd()));
+    });
+
+    mystl::parallel_buffer<Type> carry(parts);
+    carry.construct(0, init);
+    for (size_t t = 1; t < parts; ++t)
+    {
+        carry.construct(t, op(carry[t - 1], sum[t - 1]));
+    }
+
+    // 第二趟
+    mystl::parallel_invoke_n(parts, [&](size_t t)
+    {
+        const size_t b = mystl::parallel_chunk_begin(n, parts, t);
+        const size_t e = mystl::parallel_chunk_begin(n, parts, t + 1);
+        mystl::scan_carry<Inclusive>(first + b, first + e, result + b, carry[t], op, transform_op);
+    });
+    return result + n;
+}
+
+// 顺序执行，或者迭代器不支持随机访问时
+template <bool Inclusive, class Policy, class InputIter, class OutputIter, class Type, class BinaryOp, class UnaryOp,
+          class Category>
+OutputIter scan_policy(const Policy&, InputIter first, InputIter last, OutputIter result, Type init,
+                       BinaryOp op, UnaryOp transform_op, Category)
+{
+    return mystl::scan_carry<Inclusive>(first, last, result, init, op, transform_op);
+}
+
+template <bool Inclusive, class RandomIter1, class RandomIter2, class Type, class BinaryOp, class UnaryOp>
+RandomIter2 scan_policy(const execution::parallel_policy&, RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                        Type init, BinaryOp op, UnaryOp transform_op, mystl::random_access_iterator_tag)
+{
+    return mystl::parallel_scan_aux<Inclusive>(first, last, result, init, op, transform_op);
+}
+
+template <bool Inclusive, class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class Type, class BinaryOp,
+          class UnaryOp>
+ForwardIter2 scan_policy(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+                         Type init, BinaryOp op, UnaryOp transform_op)
+{
+    typedef typename std::conditional<
+        mystl::is_random_access_iterator<ForwardIter1>::value && mystl::is_random_access_iterator<ForwardIter2>::value,
+        mystl::random_access_iterator_tag, mystl::input_iterator_tag>::type category;
+    return mystl::scan_policy<Inclusive>(policy, first, last, result, init, op, transform_op, category());
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class Type, class BinaryOp>
+typename std::enable_if<mystl::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, ForwardIter2>::type
+inclusive_scan(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+               BinaryOp op, Type init)
+{
+    return mystl::scan_policy<true>(policy, first, last, result, init, op,
+                                    mystl::identity<typename mystl::iterator_traits<ForwardIter1>::value_type>());
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class BinaryOp>
+typename std::enable_if<mystl::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, ForwardIter2>::type
+inclusive_scan(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result, BinaryOp op)
+{
+    typedef typename mystl::iterator_traits<ForwardIter1>::value_type value_type;
+
+    if (first == last)
+    {
+        return result;
+    }
+    value_type carry = *first;
+    *result = carry;
+    return mystl::inclusive_scan(policy, ++first, last, ++result, op, carry);
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2>
+typename std::enable_if<mystl::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, ForwardIter2>::type
+inclusive_scan(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result)
+{
+    typedef typename mystl::iterator_traits<ForwardIter1>::value_type value_type;
+    return mystl::inclusive_scan(policy, first, last, result, mystl::plus<value_type>());
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class Type, class BinaryOp>
+typename std::enable_if<mystl::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, ForwardIter2>::type
+exclusive_scan(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+               Type init, BinaryOp op)
+{
+    return mystl::scan_policy<false>(policy, first, last, result, init, op,
+                                     mystl::identity<typename mystl::iterator_traits<ForwardIter1>::value_type>());
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class Type>
+typename std::enable_if<mystl::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, ForwardIter2>::type
+exclusive_scan(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result, Type init)
+{
+    return mystl::exclusive_scan(policy, first, last, result, init, mystl::plus<Type>());
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class Type, class BinaryOp, class UnaryOp>
+typename std::enable_if<mystl::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, ForwardIter2>::type
+transform_inclusive_scan(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+                         BinaryOp op, UnaryOp transform_op, Type init)
+{
+    return mystl::scan_policy<true>(policy, first, last, result, init, op, transform_op);
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class BinaryOp, class UnaryOp>
+typename std::enable_if<mystl::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, ForwardIter2>::type
+transform_inclusive_scan(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+                         BinaryOp op, UnaryOp transform_op)
+{
+    if (first == last)
+    {
+        return result;
+    }
+    typename std::decay<decltype(transform_op(*first))>::type carry = transform_op(*first);
+    *result = carry;
+    return mystl::transform_inclusive_scan(policy, ++first, last, ++result, op, transform_op, carry);
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class Type, class BinaryOp, class UnaryOp>
+typename std::enable_if<mystl::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, ForwardIter2>::type
+transform_exclusive_scan(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+                         Type init, BinaryOp op, UnaryOp transform_op)
+{
+    return mystl::scan_policy<false>(policy, first, last, result, init, op, transform_op);
+}
+
+}  // end namespace mystl
+
+#endif  // end MINIATURE_STL_NUMERIC_H
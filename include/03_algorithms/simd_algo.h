@@ -0,0 +1,959 @@
+#ifndef MINIATURE_STL_SIMD_ALGO_H
+#define MINIATURE_STL_SIMD_ALGO_H
+
+// 这个头文件包含了 mystl 算法中使用的 SIMD 内核
+// 内核只处理连续内存上的平凡类型，由 algo.h 等头文件在满足条件时调用；
+// 编译时未开启对应指令集的情况下，各内核退化为等价的标量实现
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "../00_utils/bitops.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MYSTL_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSSE3__)
+#define MYSTL_HAS_SSSE3 1
+#include <tmmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define MYSTL_HAS_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__FMA__)
+#define MYSTL_HAS_FMA 1
+#endif
+
+#if defined(__AVX512F__)
+#define MYSTL_HAS_AVX512 1
+#endif
+
+#if defined(__AVX512VBMI2__) && defined(__AVX512BW__)
+#define MYSTL_HAS_AVX512_VBMI2 1
+#endif
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// simd_set_intersection
+// 求两个严格递增（无重复元素）的数组的交集，结果写入 out，返回结果的个数
+// out 至少需要容纳 min(na, nb) 个元素
+//
+// 每次取两边各一个向量，通过旋转其中一个向量做全配对比较，得到左边向量中命中元素的掩码，
+// 然后把命中的元素压缩写出；最后按两个向量的最大值决定推进哪一边
+/*****************************************************************************************/
+
+// 标量版本：先写入再根据是否相等决定是否前移输出位置，循环中没有依赖数据的分支
+// 被写入但未前移的位置总小于 min(na, nb)，不会越过 out 的容量
+template <class Type>
+size_t scalar_set_intersection(const Type* a, size_t na, const Type* b, size_t nb, Type* out,
+                               size_t i = 0, size_t j = 0, size_t k = 0)
+{
+    while (i < na && j < nb)
+    {
+        const Type x = a[i];
+        const Type y = b[j];
+        out[k] = x;
+        k += static_cast<size_t>(x == y);
+        i += static_cast<size_t>(x <= y);
+        j += static_cast<size_t>(y <= x);
+    }
+    return k;
+}
+
+#if MYSTL_HAS_SSSE3
+// 按 4 位掩码把 32 位元素压缩到向量低位的 pshufb 控制表
+inline const unsigned char (*simd_compact_table_u32())[16]
+{
+    alignas(16) static const unsigned char table[16][16] = {
+        {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x00, 0x01, 0x02, 0x03, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x08, 0x09, 0x0a, 0x0b, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x00, 0x01, 0x02, 0x03, 0x08, 0x09, 0x0a, 0x0b, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x80, 0x80, 0x80, 0x80},
+        {0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x00, 0x01, 0x02, 0x03, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x04, 0x05, 0x06, 0x07, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80},
+        {0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+        {0x00, 0x01, 0x02, 0x03, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80},
+        {0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80},
+        {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f},
+    };
+    return table;
+}
+#endif
+
+// uint32_t 版本：每次比较 4x4 个元素
+inline size_t simd_set_intersection(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out)
+{
+    size_t i = 0, j = 0, k = 0;
+#if MYSTL_HAS_SSE2
+#if MYSTL_HAS_SSSE3
+    const size_t cap = na < nb ? na : nb;
+#endif
+    while (i + 4 <= na && j + 4 <= nb)
+    {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        const __m128i c0 = _mm_cmpeq_epi32(va, vb);
+        const __m128i c1 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)));
+        const __m128i c2 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2)));
+        const __m128i c3 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)));
+        unsigned mask = static_cast<unsigned>(
+            _mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(_mm_or_si128(c0, c1), _mm_or_si128(c2, c3)))));
+#if MYSTL_HAS_SSSE3
+        // 整向量写出，只在剩余容量足够时使用
+        if (k + 4 <= cap)
+        {
+            const __m128i ctrl = _mm_load_si128(reinterpret_cast<const __m128i*>(simd_compact_table_u32()[mask]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k), _mm_shuffle_epi8(va, ctrl));
+            k += static_cast<size_t>(mystl::popcount64(mask));
+            mask = 0;
+        }
+#endif
+        while (mask != 0)
+        {
+            out[k++] = a[i + mystl::countr_zero64(mask)];
+            mask &= mask - 1;
+        }
+        const uint32_t amax = a[i + 3];
+        const uint32_t bmax = b[j + 3];
+        i += amax <= bmax ? 4 : 0;
+        j += bmax <= amax ? 4 : 0;
+    }
+#endif
+    return mystl::scalar_set_intersection(a, na, b, nb, out, i, j, k);
+}
+
+// uint64_t 版本：每次比较 2x2 个元素，64 位相等由两个 32 位相等拼出，只需要 SSE2
+inline size_t simd_set_intersection(const uint64_t* a, size_t na, const uint64_t* b, size_t nb, uint64_t* out)
+{
+    size_t i = 0, j = 0, k = 0;
+#if MYSTL_HAS_SSE2
+    const size_t cap = na < nb ? na : nb;
+    while (i + 2 <= na && j + 2 <= nb)
+    {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        const __m128i e0 = _mm_cmpeq_epi32(va, vb);
+        const __m128i e1 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2)));
+        const __m128i c0 = _mm_and_si128(e0, _mm_shuffle_epi32(e0, _MM_SHUFFLE(2, 3, 0, 1)));
+        const __m128i c1 = _mm_and_si128(e1, _mm_shuffle_epi32(e1, _MM_SHUFFLE(2, 3, 0, 1)));
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(_mm_or_si128(c0, c1))));
+        if (k + 2 <= cap)
+        {
+            // 无分支写出：先写第 0 个，再写第 1 个到按掩码前移后的位置
+            out[k] = a[i];
+            k += mask & 1;
+            out[k] = a[i + 1];
+            k += mask >> 1;
+        }
+        else
+        {
+            if (mask & 1)
+            {
+                out[k++] = a[i];
+            }
+            if (mask & 2)
+            {
+                out[k++] = a[i + 1];
+            }
+        }
+        const uint64_t amax = a[i + 1];
+        const uint64_t bmax = b[j + 1];
+        i += amax <= bmax ? 2 : 0;
+        j += bmax <= amax ? 2 : 0;
+    }
+#endif
+    return mystl::scalar_set_intersection(a, na, b, nb, out, i, j, k);
+}
+
+/*****************************************************************************************/
+// simd_reduce_add / simd_dot
+// 求连续数组的和以及两个数组的内积，使用多个相互独立的向量累加器，不保证与顺序求和的结果逐位相同
+// 整数版本按 2 的补码回绕，有符号整数可以转换为同宽度的无符号整数后调用
+/*****************************************************************************************/
+
+// 标量版本：四个累加器打断加法之间的依赖链
+template <class Type>
+Type scalar_reduce_add(const Type* p, size_t n)
+{
+    Type s0 = Type(0), s1 = Type(0), s2 = Type(0), s3 = Type(0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        s0 += p[i];
+        s1 += p[i + 1];
+        s2 += p[i + 2];
+        s3 += p[i + 3];
+    }
+    for (; i < n; ++i)
+    {
+        s0 += p[i];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+template <class Type>
+Type scalar_dot(const Type* a, const Type* b, size_t n)
+{
+    Type s0 = Type(0), s1 = Type(0), s2 = Type(0), s3 = Type(0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i)
+    {
+        s0 += a[i] * b[i];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+#if MYSTL_HAS_SSE2
+inline float simd_hsum_ps(__m128 v)
+{
+    v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(v);
+}
+
+inline double simd_hsum_pd(__m128d v)
+{
+    return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+#endif
+
+#if MYSTL_HAS_AVX2
+inline float simd_hsum_ps(__m256 v)
+{
+    return mystl::simd_hsum_ps(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+}
+
+inline double simd_hsum_pd(__m256d v)
+{
+    return mystl::simd_hsum_pd(_mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1)));
+}
+#endif
+
+inline float simd_reduce_add(const float* p, size_t n)
+{
+    size_t i = 0;
+    float sum = 0.0f;
+#if MYSTL_HAS_AVX2
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps(), s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+    for (; i + 32 <= n; i += 32)
+    {
+        s0 = _mm256_add_ps(s0, _mm256_loadu_ps(p + i));
+        s1 = _mm256_add_ps(s1, _mm256_loadu_ps(p + i + 8));
+        s2 = _mm256_add_ps(s2, _mm256_loadu_ps(p + i + 16));
+        s3 = _mm256_add_ps(s3, _mm256_loadu_ps(p + i + 24));
+    }
+    sum = mystl::simd_hsum_ps(_mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3)));
+#elif MYSTL_HAS_SSE2
+    __m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps(), s2 = _mm_setzero_ps(), s3 = _mm_setzero_ps();
+    for (; i + 16 <= n; i += 16)
+    {
+        s0 = _mm_add_ps(s0, _mm_loadu_ps(p + i));
+        s1 = _mm_add_ps(s1, _mm_loadu_ps(p + i + 4));
+        s2 = _mm_add_ps(s2, _mm_loadu_ps(p + i + 8));
+        s3 = _mm_add_ps(s3, _mm_loadu_ps(p + i + 12));
+    }
+    sum = mystl::simd_hsum_ps(_mm_add_ps(_mm_add_ps(s0, s1), _mm_add_ps(s2, s3)));
+#endif
+    return sum + mystl::scalar_reduce_add(p + i, n - i);
+}
+
+inline double simd_reduce_add(const double* p, size_t n)
+{
+    size_t i = 0;
+    double sum = 0.0;
+#if MYSTL_HAS_AVX2
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd(), s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    for (; i + 16 <= n; i += 16)
+    {
+        s0 = _mm256_add_pd(s0, _mm256_loadu_pd(p + i));
+        s1 = _mm256_add_pd(s1, _mm256_loadu_pd(p + i + 4));
+        s2 = _mm256_add_pd(s2, _mm256_loadu_pd(p + i + 8));
+        s3 = _mm256_add_pd(s3, _mm256_loadu_pd(p + i + 12));
+    }
+    sum = mystl::simd_hsum_pd(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+#elif MYSTL_HAS_SSE2
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd(), s2 = _mm_setzero_pd(), s3 = _mm_setzero_pd();
+    for (; i + 8 <= n; i += 8)
+    {
+        s0 = _mm_add_pd(s0, _mm_loadu_pd(p + i));
+        s1 = _mm_add_pd(s1, _mm_loadu_pd(p + i + 2));
+        s2 = _mm_add_pd(s2, _mm_loadu_pd(p + i + 4));
+        s3 = _mm_add_pd(s3, _mm_loadu_pd(p + i + 6));
+    }
+    sum = mystl::simd_hsum_pd(_mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3)));
+#endif
+    return sum + mystl::scalar_reduce_add(p + i, n - i);
+}
+
+inline uint32_t simd_reduce_add(const uint32_t* p, size_t n)
+{
+    size_t i = 0;
+    uint32_t sum = 0;
+#if MYSTL_HAS_SSE2
+    __m128i s0 = _mm_setzero_si128(), s1 = _mm_setzero_si128(), s2 = _mm_setzero_si128(), s3 = _mm_setzero_si128();
+#if MYSTL_HAS_AVX2
+    __m256i t0 = _mm256_setzero_si256(), t1 = _mm256_setzero_si256();
+    for (; i + 16 <= n; i += 16)
+    {
+        t0 = _mm256_add_epi32(t0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+        t1 = _mm256_add_epi32(t1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 8)));
+    }
+    t0 = _mm256_add_epi32(t0, t1);
+    s0 = _mm_add_epi32(_mm256_castsi256_si128(t0), _mm256_extracti128_si256(t0, 1));
+#endif
+    for (; i + 16 <= n; i += 16)
+    {
+        s0 = _mm_add_epi32(s0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+        s1 = _mm_add_epi32(s1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 4)));
+        s2 = _mm_add_epi32(s2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 8)));
+        s3 = _mm_add_epi32(s3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 12)));
+    }
+    __m128i v = _mm_add_epi32(_mm_add_epi32(s0, s1), _mm_add_epi32(s2, s3));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    sum = static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+#endif
+    return sum + mystl::scalar_reduce_add(p + i, n - i);
+}
+
+inline uint64_t simd_reduce_add(const uint64_t* p, size_t n)
+{
+    size_t i = 0;
+    uint64_t sum = 0;
+#if MYSTL_HAS_SSE2
+    __m128i s0 = _mm_setzero_si128(), s1 = _mm_setzero_si128(), s2 = _mm_setzero_si128(), s3 = _mm_setzero_si128();
+#if MYSTL_HAS_AVX2
+    __m256i t0 = _mm256_setzero_si256(), t1 = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8)
+    {
+        t0 = _mm256_add_epi64(t0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+        t1 = _mm256_add_epi64(t1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 4)));
+    }
+    t0 = _mm256_add_epi64(t0, t1);
+    s0 = _mm_add_epi64(_mm256_castsi256_si128(t0), _mm256_extracti128_si256(t0, 1));
+#endif
+    for (; i + 8 <= n; i += 8)
+    {
+        s0 = _mm_add_epi64(s0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+        s1 = _mm_add_epi64(s1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 2)));
+        s2 = _mm_add_epi64(s2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 4)));
+        s3 = _mm_add_epi64(s3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 6)));
+    }
+    __m128i v = _mm_add_epi64(_mm_add_epi64(s0, s1), _mm_add_epi64(s2, s3));
+    v = _mm_add_epi64(v, _mm_unpackhi_epi64(v, v));
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+    sum = lanes[0];
+#endif
+    return sum + mystl::scalar_reduce_add(p + i, n - i);
+}
+
+inline float simd_dot(const float* a, const float* b, size_t n)
+{
+    size_t i = 0;
+    float sum = 0.0f;
+#if MYSTL_HAS_AVX2 && MYSTL_HAS_FMA
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps(), s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+    for (; i + 32 <= n; i += 32)
+    {
+        s0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), s0);
+        s1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), s1);
+        s2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), s2);
+        s3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), s3);
+    }
+    sum = mystl::simd_hsum_ps(_mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3)));
+#elif MYSTL_HAS_SSE2
+    __m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps(), s2 = _mm_setzero_ps(), s3 = _mm_setzero_ps();
+    for (; i + 16 <= n; i += 16)
+    {
+        s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+        s2 = _mm_add_ps(s2, _mm_mul_ps(_mm_loadu_ps(a + i + 8), _mm_loadu_ps(b + i + 8)));
+        s3 = _mm_add_ps(s3, _mm_mul_ps(_mm_loadu_ps(a + i + 12), _mm_loadu_ps(b + i + 12)));
+    }
+    sum = mystl::simd_hsum_ps(_mm_add_ps(_mm_add_ps(s0, s1), _mm_add_ps(s2, s3)));
+#endif
+    return sum + mystl::scalar_dot(a + i, b + i, n - i);
+}
+
+inline double simd_dot(const double* a, const double* b, size_t n)
+{
+    size_t i = 0;
+    double sum = 0.0;
+#if MYSTL_HAS_AVX2 && MYSTL_HAS_FMA
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd(), s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    for (; i + 16 <= n; i += 16)
+    {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), s1);
+        s2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8), s2);
+        s3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), s3);
+    }
+    sum = mystl::simd_hsum_pd(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+#elif MYSTL_HAS_SSE2
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd(), s2 = _mm_setzero_pd(), s3 = _mm_setzero_pd();
+    for (; i + 8 <= n; i += 8)
+    {
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+        s2 = _mm_add_pd(s2, _mm_mul_pd(_mm_loadu_pd(a + i + 4), _mm_loadu_pd(b + i + 4)));
+        s3 = _mm_add_pd(s3, _mm_mul_pd(_mm_loadu_pd(a + i + 6), _mm_loadu_pd(b + i + 6)));
+    }
+    sum = mystl::simd_hsum_pd(_mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3)));
+#endif
+    return sum + mystl::scalar_dot(a + i, b + i, n - i);
+}
+
+/*****************************************************************************************/
+// simd_scan_add
+// 以 carry 为初值求前缀和，Inclusive 为 true 时 out[i] 包含 in[i]，否则不包含；in 与 out 可以相同
+// 向量内部用两次移位相加得到前缀和，再加上广播的进位，每个向量只有一次加法处在依赖链上
+/*****************************************************************************************/
+template <bool Inclusive, class Type>
+void scalar_scan_add(const Type* in, Type* out, size_t n, Type carry)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Type x = in[i];
+        if (Inclusive)
+        {
+            carry += x;
+            out[i] = carry;
+        }
+        else
+        {
+            out[i] = carry;
+            carry += x;
+        }
+    }
+}
+
+template <bool Inclusive>
+void simd_scan_add(const uint32_t* in, uint32_t* out, size_t n, uint32_t carry)
+{
+    size_t i = 0;
+#if MYSTL_HAS_SSE2
+    __m128i c = _mm_set1_epi32(static_cast<int>(carry));
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        const __m128i y = Inclusive ? x : _mm_slli_si128(x, 4);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi32(y, c));
+        c = _mm_add_epi32(c, _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+    carry = static_cast<uint32_t>(_mm_cvtsi128_si32(c));
+#endif
+    mystl::scalar_scan_add<Inclusive>(in + i, out + i, n - i, carry);
+}
+
+template <bool Inclusive>
+void simd_scan_add(const uint64_t* in, uint64_t* out, size_t n, uint64_t carry)
+{
+    size_t i = 0;
+#if MYSTL_HAS_SSE2
+    __m128i c = _mm_set1_epi64x(static_cast<long long>(carry));
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+        const __m128i y = Inclusive ? x : _mm_slli_si128(x, 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi64(y, c));
+        c = _mm_add_epi64(c, _mm_unpackhi_epi64(x, x));
+    }
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), c);
+    carry = lanes[0];
+#endif
+    mystl::scalar_scan_add<Inclusive>(in + i, out + i, n - i, carry);
+}
+
+template <bool Inclusive>
+void simd_scan_add(const float* in, float* out, size_t n, float carry)
+{
+    size_t i = 0;
+#if MYSTL_HAS_SSE2
+    __m128 c = _mm_set1_ps(carry);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(in + i);
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+        const __m128 y = Inclusive ? x : _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4));
+        _mm_storeu_ps(out + i, _mm_add_ps(y, c));
+        c = _mm_add_ps(c, _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+    carry = _mm_cvtss_f32(c);
+#endif
+    mystl::scalar_scan_add<Inclusive>(in + i, out + i, n - i, carry);
+}
+
+template <bool Inclusive>
+void simd_scan_add(const double* in, double* out, size_t n, double carry)
+{
+    size_t i = 0;
+#if MYSTL_HAS_SSE2
+    __m128d c = _mm_set1_pd(carry);
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128d x = _mm_loadu_pd(in + i);
+        x = _mm_add_pd(x, _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8)));
+        const __m128d y = Inclusive ? x : _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8));
+        _mm_storeu_pd(out + i, _mm_add_pd(y, c));
+        c = _mm_add_pd(c, _mm_unpackhi_pd(x, x));
+    }
+    carry = _mm_cvtsd_f64(c);
+#endif
+    mystl::scalar_scan_add<Inclusive>(in + i, out + i, n - i, carry);
+}
+
+/*****************************************************************************************/
+// simd_reverse
+// 将 p 起始的 n 个宽度为 Size 字节（1、2、4、8）的元素反转，只按字节搬移，适用于任意平凡可复制类型
+// 每次从两端各取一个向量，在寄存器内反转元素次序后交换写回
+/*****************************************************************************************/
+template <size_t Size>
+struct simd_reverse_lane;
+
+#if MYSTL_HAS_SSE2
+template <>
+struct simd_reverse_lane<8>
+{
+    static __m128i rev(__m128i v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)); }
+};
+
+template <>
+struct simd_reverse_lane<4>
+{
+    static __m128i rev(__m128i v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)); }
+};
+
+template <>
+struct simd_reverse_lane<2>
+{
+    static __m128i rev(__m128i v)
+    {
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+};
+
+template <>
+struct simd_reverse_lane<1>
+{
+    static __m128i rev(__m128i v)
+    {
+#if MYSTL_HAS_SSSE3
+        return _mm_shuffle_epi8(v, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+#else
+        // 先按 16 位反转，再交换每个 16 位元素内的两个字节
+        v = simd_reverse_lane<2>::rev(v);
+        return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+#endif
+    }
+};
+#endif
+
+#if MYSTL_HAS_AVX2
+// 256 位版本：先在每个 128 位通道内反转，再交换两个通道
+template <size_t Size>
+inline __m256i simd_reverse_256(__m256i v)
+{
+    const __m256i mask = Size == 2
+        ? _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                           14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1)
+        : _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                           15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, mask), _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+template <>
+inline __m256i simd_reverse_256<4>(__m256i v)
+{
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+template <>
+inline __m256i simd_reverse_256<8>(__m256i v)
+{
+    return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+#endif
+
+template <size_t Size>
+void simd_reverse(void* p, size_t n)
+{
+    static_assert(Size == 1 || Size == 2 || Size == 4 || Size == 8, "simd_reverse needs 1, 2, 4 or 8 byte lanes");
+    unsigned char* lo = static_cast<unsigned char*>(p);
+    unsigned char* hi = lo + n * Size;
+#if MYSTL_HAS_AVX2
+    for (; hi - lo >= 64; lo += 32)
+    {
+        hi -= 32;
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lo));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hi));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lo), mystl::simd_reverse_256<Size>(b));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(hi), mystl::simd_reverse_256<Size>(a));
+    }
+#endif
+#if MYSTL_HAS_SSE2
+    for (; hi - lo >= 32; lo += 16)
+    {
+        hi -= 16;
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lo));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lo), mystl::simd_reverse_lane<Size>::rev(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(hi), mystl::simd_reverse_lane<Size>::rev(a));
+    }
+#endif
+    // 剩余不足两个向量的部分逐个交换，用 memcpy 搬移避免以其他类型访问元素
+    for (; hi - lo >= static_cast<ptrdiff_t>(2 * Size); lo += Size)
+    {
+        hi -= Size;
+        unsigned char t[Size];
+        std::memcpy(t, lo, Size);
+        std::memcpy(lo, hi, Size);
+        std::memcpy(hi, t, Size);
+    }
+}
+
+/*****************************************************************************************/
+// simd_compress
+// 把 in 起始的 n（不超过 64）个宽度为 Size 字节的元素中，mask 对应位为 1 的元素按原有次序连续写入 out，
+// 返回写入的个数；只写入这些元素，不会越过 out 中第 popcount(mask) 个位置
+// out 可以与 in 相同或位于 in 之前（原地压缩），每个向量都先读入再写出
+//
+// AVX-512 使用 compress 指令，AVX2 用查表得到的置换把选中的 32 / 64 位元素移到低位再按掩码写出，
+// 其余情况逐个取出最低的置位，只在每一段结束时有一次难以预测的分支
+/*****************************************************************************************/
+template <size_t Size>
+size_t scalar_compress(const unsigned char* in, uint64_t mask, unsigned char* out)
+{
+    size_t k = 0;
+    while (mask != 0)
+    {
+        std::memmove(out + k * Size, in + static_cast<size_t>(mystl::countr_zero64(mask)) * Size, Size);
+        ++k;
+        mask &= mask - 1;
+    }
+    return k;
+}
+
+#if MYSTL_HAS_AVX2
+// 把选中的元素移到低位的置换表：第 m 项的第 j 个字节为第 j 个选中的 32 位元素的下标
+// u32 按 8 位掩码选 32 位元素，u64 按 4 位掩码选 64 位元素（每个元素占两个 32 位下标）
+struct simd_compress_table
+{
+    uint64_t u32[256];
+    uint64_t u64[16];
+
+    simd_compress_table()
+    {
+        for (unsigned m = 0; m < 256; ++m)
+        {
+            uint64_t v = 0;
+            int k = 0;
+            for (unsigned j = 0; j < 8; ++j)
+            {
+                if (m & (1u << j))
+                {
+                    v |= static_cast<uint64_t>(j) << (8 * k++);
+                }
+            }
+            u32[m] = v;
+        }
+        for (unsigned m = 0; m < 16; ++m)
+        {
+            uint64_t v = 0;
+            int k = 0;
+            for (unsigned j = 0; j < 4; ++j)
+            {
+                if (m & (1u << j))
+                {
+                    v |= static_cast<uint64_t>(2 * j) << (8 * k++);
+                    v |= static_cast<uint64_t>(2 * j + 1) << (8 * k++);
+                }
+            }
+            u64[m] = v;
+        }
+    }
+
+    static const simd_compress_table& get()
+    {
+        static const simd_compress_table table;
+        return table;
+    }
+};
+
+// 按 32 位下标 idx 置换 v，只写出前 k 个 32 位元素
+inline void simd_compress_store_256(unsigned char* out, __m256i v, uint64_t idx, int k)
+{
+    const __m256i perm = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(idx)));
+    const __m256i keep = _mm256_cmpgt_epi32(_mm256_set1_epi32(k), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    _mm256_maskstore_epi32(reinterpret_cast<int*>(out), keep, _mm256_permutevar8x32_epi32(v, perm));
+}
+#endif
+
+template <size_t Size>
+size_t simd_compress(const void* in, size_t n, uint64_t mask, void* out)
+{
+    const unsigned char* src = static_cast<const unsigned char*>(in);
+    unsigned char* dst = static_cast<unsigned char*>(out);
+    if (n < 64)
+    {
+        mask &= (static_cast<uint64_t>(1) << n) - 1;
+    }
+    size_t i = 0;
+    size_t k = 0;
+#if MYSTL_HAS_AVX512
+    if (Size == 4)
+    {
+        for (; i + 16 <= n; i += 16)
+        {
+            const __mmask16 m = static_cast<__mmask16>(mask >> i);
+            const __m512i v = _mm512_maskz_compress_epi32(m, _mm512_loadu_si512(src + i * 4));
+            const int c = mystl::popcount64(m);
+            _mm512_mask_storeu_epi32(dst + k * 4, static_cast<__mmask16>((1u << c) - 1), v);
+            k += static_cast<size_t>(c);
+        }
+    }
+    else if (Size == 8)
+    {
+        for (; i + 8 <= n; i += 8)
+        {
+            const __mmask8 m = static_cast<__mmask8>(mask >> i);
+            const __m512i v = _mm512_maskz_compress_epi64(m, _mm512_loadu_si512(src + i * 8));
+            const int c = mystl::popcount64(m);
+            _mm512_mask_storeu_epi64(dst + k * 8, static_cast<__mmask8>((1u << c) - 1), v);
+            k += static_cast<size_t>(c);
+        }
+    }
+#if MYSTL_HAS_AVX512_VBMI2
+    else if (Size == 2)
+    {
+        for (; i + 32 <= n; i += 32)
+        {
+            const __mmask32 m = static_cast<__mmask32>(mask >> i);
+            const __m512i v = _mm512_maskz_compress_epi16(m, _mm512_loadu_si512(src + i * 2));
+            const int c = mystl::popcount64(m);
+            _mm512_mask_storeu_epi16(dst + k * 2, static_cast<__mmask32>((static_cast<uint64_t>(1) << c) - 1), v);
+            k += static_cast<size_t>(c);
+        }
+    }
+    else if (Size == 1)
+    {
+        for (; i + 64 <= n; i += 64)
+        {
+            const __mmask64 m = static_cast<__mmask64>(mask >> i);
+            const __m512i v = _mm512_maskz_compress_epi8(m, _mm512_loadu_si512(src + i));
+            const int c = mystl::popcount64(m);
+            _mm512_mask_storeu_epi8(dst + k, c == 64 ? ~static_cast<__mmask64>(0) : (static_cast<__mmask64>(1) << c) - 1, v);
+            k += static_cast<size_t>(c);
+        }
+    }
+#endif
+#elif MYSTL_HAS_AVX2
+    if (Size == 4 || Size == 8)
+    {
+        const simd_compress_table& table = simd_compress_table::get();
+        const size_t lanes = 32 / Size;
+        for (; i + lanes <= n; i += lanes)
+        {
+            const unsigned m = static_cast<unsigned>(mask >> i) & ((1u << lanes) - 1);
+            const int c = mystl::popcount64(m);
+            mystl::simd_compress_store_256(dst + k * Size,
+                                           _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * Size)),
+                                           Size == 4 ? table.u32[m] : table.u64[m], c * static_cast<int>(Size / 4));
+            k += static_cast<size_t>(c);
+        }
+    }
+#endif
+    if (i < n)
+    {
+        k += mystl::scalar_compress<Size>(src + i * Size, mask >> i, dst + k * Size);
+    }
+    return k;
+}
+
+/*****************************************************************************************/
+// simd_find
+// 在 p 起始的 n 个宽度为 Size 字节（1、2、4、8）的元素中查找第一个与 *value 按字节相等的元素，
+// 返回其下标，找不到时返回 n；只适用于相等与按字节相等一致的类型（整数）
+// 每次比较一个向量，用 movemask 得到相等的字节，最低的置位即是第一个相等的元素
+/*****************************************************************************************/
+template <size_t Size>
+struct simd_find_lane;
+
+#if MYSTL_HAS_SSE2
+template <>
+struct simd_find_lane<1>
+{
+    static __m128i set1(const void* v) { int8_t x; std::memcpy(&x, v, 1); return _mm_set1_epi8(x); }
+    static __m128i eq(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+#if MYSTL_HAS_AVX2
+    static __m256i set1_256(const void* v) { int8_t x; std::memcpy(&x, v, 1); return _mm256_set1_epi8(x); }
+    static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi8(a, b); }
+#endif
+};
+
+template <>
+struct simd_find_lane<2>
+{
+    static __m128i set1(const void* v) { int16_t x; std::memcpy(&x, v, 2); return _mm_set1_epi16(x); }
+    static __m128i eq(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+#if MYSTL_HAS_AVX2
+    static __m256i set1_256(const void* v) { int16_t x; std::memcpy(&x, v, 2); return _mm256_set1_epi16(x); }
+    static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi16(a, b); }
+#endif
+};
+
+template <>
+struct simd_find_lane<4>
+{
+    static __m128i set1(const void* v) { int32_t x; std::memcpy(&x, v, 4); return _mm_set1_epi32(x); }
+    static __m128i eq(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+#if MYSTL_HAS_AVX2
+    static __m256i set1_256(const void* v) { int32_t x; std::memcpy(&x, v, 4); return _mm256_set1_epi32(x); }
+    static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+#endif
+};
+
+template <>
+struct simd_find_lane<8>
+{
+    static __m128i set1(const void* v) { int64_t x; std::memcpy(&x, v, 8); return _mm_set1_epi64x(x); }
+    // SSE2 没有 64 位比较：两半都相等才算相等
+    static __m128i eq(__m128i a, __m128i b)
+    {
+        const __m128i e = _mm_cmpeq_epi32(a, b);
+        return _mm_and_si128(e, _mm_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+#if MYSTL_HAS_AVX2
+    static __m256i set1_256(const void* v) { int64_t x; std::memcpy(&x, v, 8); return _mm256_set1_epi64x(x); }
+    static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi64(a, b); }
+#endif
+};
+#endif
+
+template <size_t Size>
+size_t simd_find(const void* p, size_t n, const void* value)
+{
+    static_assert(Size == 1 || Size == 2 || Size == 4 || Size == 8, "simd_find needs 1, 2, 4 or 8 byte lanes");
+    const unsigned char* src = static_cast<const unsigned char*>(p);
+    size_t i = 0;
+#if MYSTL_HAS_AVX2
+    {
+        const __m256i v = simd_find_lane<Size>::set1_256(value);
+        for (; i + 32 / Size <= n; i += 32 / Size)
+        {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * Size));
+            const unsigned m = static_cast<unsigned>(_mm256_movemask_epi8(simd_find_lane<Size>::eq(x, v)));
+            if (m != 0)
+            {
+                return i + static_cast<size_t>(mystl::countr_zero64(m)) / Size;
+            }
+        }
+    }
+#endif
+#if MYSTL_HAS_SSE2
+    {
+        const __m128i v = simd_find_lane<Size>::set1(value);
+        for (; i + 16 / Size <= n; i += 16 / Size)
+        {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * Size));
+            const unsigned m = static_cast<unsigned>(_mm_movemask_epi8(simd_find_lane<Size>::eq(x, v)));
+            if (m != 0)
+            {
+                return i + static_cast<size_t>(mystl::countr_zero64(m)) / Size;
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        if (std::memcmp(src + i * Size, value, Size) == 0)
+        {
+            break;
+        }
+    }
+    return i;
+}
+
+/*****************************************************************************************/
+// simd_hash_stripes
+// hash_bytes 处理长输入时使用的内核：acc 为 8 个 64 位累加器，从 p 开始依次处理 n 条 64 字节的 stripe，
+// 第 j 条 stripe 的第 i 个 64 位字 d 与密钥 key[j + i] + seed 异或得到 dk，
+// 然后 acc[i] 加上 dk 的低 32 位与高 32 位之积，acc[i ^ 1] 加上 d 本身
+// 只用到 32 x 32 -> 64 位的乘法与加法，AVX2 版本与标量版本的结果逐位相同，
+// 因此 hash_bytes 的结果不随编译选项变化
+/*****************************************************************************************/
+inline void scalar_hash_stripes(uint64_t* acc, const unsigned char* p, size_t n, const uint64_t* key, uint64_t seed)
+{
+    for (size_t j = 0; j < n; ++j, p += 64)
+    {
+        for (size_t i = 0; i < 8; ++i)
+        {
+            uint64_t d;
+            std::memcpy(&d, p + i * 8, 8);
+            const uint64_t dk = d ^ (key[j + i] + seed);
+            acc[i ^ 1] += d;
+            acc[i] += (dk & 0xffffffffu) * (dk >> 32);
+        }
+    }
+}
+
+#if MYSTL_HAS_AVX2
+inline __m256i simd_hash_lane(__m256i a, const unsigned char* p, const uint64_t* key, __m256i sv)
+{
+    const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const __m256i dk = _mm256_xor_si256(d, _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(key)), sv));
+    a = _mm256_add_epi64(a, _mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm256_add_epi64(a, _mm256_mul_epu32(dk, _mm256_srli_epi64(dk, 32)));
+}
+#endif
+
+// 累加器放在局部变量中，整个循环内都留在寄存器里
+inline void simd_hash_stripes(uint64_t* acc, const unsigned char* p, size_t n, const uint64_t* key, uint64_t seed)
+{
+#if MYSTL_HAS_AVX2
+    const __m256i sv = _mm256_set1_epi64x(static_cast<long long>(seed));
+    __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc));
+    __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + 4));
+    for (size_t j = 0; j < n; ++j, p += 64)
+    {
+        a0 = mystl::simd_hash_lane(a0, p, key + j, sv);
+        a1 = mystl::simd_hash_lane(a1, p + 32, key + j + 4, sv);
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc), a0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4), a1);
+#else
+    mystl::scalar_hash_stripes(acc, p, n, key, seed);
+#endif
+}
+
+}  // end namespace mystl
+
+#endif  // end MINIATURE_STL_SIMD_ALGO_H
@@ -0,0 +1,257 @@
+#ifndef MINIATURE_STL_STATIC_SORT_H
+#define MINIATURE_STL_STATIC_SORT_H
+
+// 这个头文件包含 static_sort：对长度 N 在编译期确定的小数组排序，以 static_sort<8>(first) 的形式调用
+//
+// 比较网络在编译期由模板递归生成，使用 Batcher 奇偶归并排序网络并去掉落在 N 之后的比较器。
+// N <= 8 时比较器个数是最优的，N <= 32 时与已知最好的网络相差不多（N = 16 / 32 时为 63 / 191 个，
+// 已知最好为 60 / 185 个），层数不超过 15；网络展开后没有循环，也没有依赖数据的分支
+//
+// 可以按字节复制的小元素先读入局部数组，比较器用条件传送或 min / max 指令实现，排序后再写回；
+// 其他元素在原位置上比较，逆序时交换。排序不稳定
+
+#include <cstddef>
+#include <type_traits>
+
+#include "../02_iterators/iterator.h"
+#include "../01_allocators/util.h"
+#include "../03_algorithms/functional.h"
+#include "../03_algorithms/simd_algo.h"
+
+namespace mystl
+{
+
+// 判断 Type 能否读入局部数组、以无分支的方式比较交换
+template <class Type>
+struct is_static_sort_branchless : public std::integral_constant<bool,
+    std::is_trivial<Type>::value && sizeof(Type) <= 16> {};
+
+// 比较交换两个值：lo 返回排在前面的一个，hi 返回另一个，两者相等时 lo 返回 a
+// 一般情况下编译为条件传送；浮点数若写成同一条件的两次选择，编译器会合并为分支，
+// 因此对 less / greater 直接使用 min / max 指令，结果与下面的表达式逐位相同
+template <class Type, class Compare>
+struct static_sort_select
+{
+    static Type lo(const Type& a, const Type& b, Compare& comp) { return comp(b, a) ? b : a; }
+    static Type hi(const Type& a, const Type& b, Compare& comp) { return comp(b, a) ? a : b; }
+};
+
+#if MYSTL_HAS_SSE2
+template <>
+struct static_sort_select<float, mystl::less<float>>
+{
+    static float lo(float a, float b, mystl::less<float>&)
+    {
+        return _mm_cvtss_f32(_mm_min_ss(_mm_set_ss(b), _mm_set_ss(a)));
+    }
+    static float hi(float a, float b, mystl::less<float>&)
+    {
+        return _mm_cvtss_f32(_mm_max_ss(_mm_set_ss(a), _mm_set_ss(b)));
+    }
+};
+
+template <>
+struct static_sort_select<float, mystl::greater<float>>
+{
+    static float lo(float a, float b, mystl::greater<float>&)
+    {
+        return _mm_cvtss_f32(_mm_max_ss(_mm_set_ss(b), _mm_set_ss(a)));
+    }
+    static float hi(float a, float b, mystl::greater<float>&)
+    {
+        return _mm_cvtss_f32(_mm_min_ss(_mm_set_ss(a), _mm_set_ss(b)));
+    }
+};
+
+template <>
+struct static_sort_select<double, mystl::less<double>>
+{
+    static double lo(double a, double b, mystl::less<double>&)
+    {
+        return _mm_cvtsd_f64(_mm_min_sd(_mm_set_sd(b), _mm_set_sd(a)));
+    }
+    static double hi(double a, double b, mystl::less<double>&)
+    {
+        return _mm_cvtsd_f64(_mm_max_sd(_mm_set_sd(a), _mm_set_sd(b)));
+    }
+};
+
+template <>
+struct static_sort_select<double, mystl::greater<double>>
+{
+    static double lo(double a, double b, mystl::greater<double>&)
+    {
+        return _mm_cvtsd_f64(_mm_max_sd(_mm_set_sd(b), _mm_set_sd(a)));
+    }
+    static double hi(double a, double b, mystl::greater<double>&)
+    {
+        return _mm_cvtsd_f64(_mm_min_sd(_mm_set_sd(a), _mm_set_sd(b)));
+    }
+};
+#endif
+
+/*****************************************************************************************/
+// static_sort_cswap
+// 比较交换 first[I] 与 first[J]，结束后 first[I] 不大于 first[J]；J 不小于 N 时什么也不做
+/*****************************************************************************************/
+template <size_t I, size_t J, size_t N, bool = (J < N)>
+struct static_sort_cswap
+{
+    template <class RandomIter, class Compare>
+    static void apply(RandomIter first, Compare& comp, std::true_type)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef static_sort_select<value_type, Compare>          select;
+        const value_type a = first[I];
+        const value_type b = first[J];
+        first[I] = select::lo(a, b, comp);
+        first[J] = select::hi(a, b, comp);
+    }
+
+    template <class RandomIter, class Compare>
+    static void apply(RandomIter first, Compare& comp, std::false_type)
+    {
+        if (comp(first[J], first[I]))
+        {
+            mystl::swap(first[I], first[J]);
+        }
+    }
+};
+
+template <size_t I, size_t J, size_t N>
+struct static_sort_cswap<I, J, N, false>
+{
+    template <class RandomIter, class Compare, class Branchless>
+    static void apply(RandomIter, Compare&, Branchless) {}
+};
+
+/*****************************************************************************************/
+// batcher_merge / batcher_sort
+// Batcher 奇偶归并排序网络：按不小于 N 的 2 的幂 P 生成网络，相当于在末尾补上 P - N 个无穷大，
+// 下标不小于 N 的比较器总是不交换，直接去掉；整棵子树都落在 N 之后时不再展开
+//
+// batcher_merge<Lo, M, R, N>：归并下标为 Lo, Lo + R, ..., Lo + M - R 的序列，前后两半各自有序
+// 先分别归并偶数项与奇数项两个子序列，再比较交换相邻的 (Lo + R + 2kR, Lo + 2R + 2kR)
+/*****************************************************************************************/
+template <size_t I, size_t End, size_t R, size_t N, bool = (I < End)>
+struct batcher_compare_range
+{
+    template <class RandomIter, class Compare, class Branchless>
+    static void apply(RandomIter first, Compare& comp, Branchless tag)
+    {
+        static_sort_cswap<I, I + R, N>::apply(first, comp, tag);
+        batcher_compare_range<I + 2 * R, End, R, N>::apply(first, comp, tag);
+    }
+};
+
+template <size_t I, size_t End, size_t R, size_t N>
+struct batcher_compare_range<I, End, R, N, false>
+{
+    template <class RandomIter, class Compare, class Branchless>
+    static void apply(RandomIter, Compare&, Branchless) {}
+};
+
+// Kind：0 表示整段都在 N 之后，1 表示只剩一次比较，2 表示一般情况
+template <size_t Lo, size_t M, size_t R, size_t N,
+          int Kind = (Lo >= N) ? 0 : (2 * R < M ? 2 : 1)>
+struct batcher_merge
+{
+    template <class RandomIter, class Compare, class Branchless>
+    static void apply(RandomIter first, Compare& comp, Branchless tag)
+    {
+        batcher_merge<Lo, M, 2 * R, N>::apply(first, comp, tag);
+        batcher_merge<Lo + R, M, 2 * R, N>::apply(first, comp, tag);
+        batcher_compare_range<Lo + R, Lo + M - R, R, N>::apply(first, comp, tag);
+    }
+};
+
+template <size_t Lo, size_t M, size_t R, size_t N>
+struct batcher_merge<Lo, M, R, N, 1>
+{
+    template <class RandomIter, class Compare, class Branchless>
+    static void apply(RandomIter first, Compare& comp, Branchless tag)
+    {
+        static_sort_cswap<Lo, Lo + R, N>::apply(first, comp, tag);
+    }
+};
+
+template <size_t Lo, size_t M, size_t R, size_t N>
+struct batcher_merge<Lo, M, R, N, 0>
+{
+    template <class RandomIter, class Compare, class Branchless>
+    static void apply(RandomIter, Compare&, Branchless) {}
+};
+
+// 排序 [Lo, Lo + M)，M 为 2 的幂
+template <size_t Lo, size_t M, size_t N, bool = (M >= 2 && Lo < N)>
+struct batcher_sort
+{
+    template <class RandomIter, class Compare, class Branchless>
+    static void apply(RandomIter first, Compare& comp, Branchless tag)
+    {
+        batcher_sort<Lo, M / 2, N>::apply(first, comp, tag);
+        batcher_sort<Lo + M / 2, M / 2, N>::apply(first, comp, tag);
+        batcher_merge<Lo, M, 1, N>::apply(first, comp, tag);
+    }
+};
+
+template <size_t Lo, size_t M, size_t N>
+struct batcher_sort<Lo, M, N, false>
+{
+    template <class RandomIter, class Compare, class Branchless>
+    static void apply(RandomIter, Compare&, Branchless) {}
+};
+
+// 不小于 N 的最小的 2 的幂
+template <size_t N, size_t P = 1, bool = (P >= N)>
+struct static_sort_ceil_pow2 : public std::integral_constant<size_t, P> {};
+
+template <size_t N, size_t P>
+struct static_sort_ceil_pow2<N, P, false> : public static_sort_ceil_pow2<N, P * 2> {};
+
+/*****************************************************************************************/
+// static_sort
+// 版本1：按 operator< 排序 [first, first + N)
+// 版本2：按比较函数对象 comp 排序
+/*****************************************************************************************/
+// 在局部数组上排序，编译器可以把整个数组放在寄存器中
+template <size_t N, class RandomIter, class Compare>
+void static_sort_aux(RandomIter first, Compare& comp, std::true_type)
+{
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    value_type v[N];
+    for (size_t i = 0; i < N; ++i)
+    {
+        v[i] = first[i];
+    }
+    batcher_sort<0, static_sort_ceil_pow2<N>::value, N>::apply(v + 0, comp, std::true_type());
+    for (size_t i = 0; i < N; ++i)
+    {
+        first[i] = v[i];
+    }
+}
+
+template <size_t N, class RandomIter, class Compare>
+void static_sort_aux(RandomIter first, Compare& comp, std::false_type)
+{
+    batcher_sort<0, static_sort_ceil_pow2<N>::value, N>::apply(first, comp, std::false_type());
+}
+
+template <size_t N, class RandomIter, class Compare>
+void static_sort(RandomIter first, Compare comp)
+{
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    mystl::static_sort_aux<N>(first, comp, std::integral_constant<bool,
+        (N >= 2) && is_static_sort_branchless<value_type>::value>());
+}
+
+template <size_t N, class RandomIter>
+void static_sort(RandomIter first)
+{
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    mystl::static_sort<N>(first, mystl::less<value_type>());
+}
+
+}  // end namespace mystl
+
+#endif  // end MINIATURE_STL_STATIC_SORT_H
@@ -897,15 +897,262 @@ int basic_string<CharType, CharTraits>::compare(size_type pos1, size_type count1
     return compare_cstr(buffer_ + pos1, n1, other.buffer_, other.size_);
 }
 
+// 重载比较操作符，长度不同时不比较字符
+template <class CharType, class CharTraits>
+bool operator==(const basic_string<CharType, CharTraits>& lhs, const basic_string<CharType, CharTraits>& rhs) {
+    return lhs.size() == rhs.size() &&
+           (lhs.empty() || CharTraits::compare(lhs.begin(), rhs.begin(), lhs.size()) == 0);
+}
+
+template <class CharType, class CharTraits>
+bool operator!=(const basic_string<CharType, CharTraits>& lhs, const basic_string<CharType, CharTraits>& rhs) {
+    return !(lhs == rhs);
+}
+
+// 与另一个 basic_string 交换
+template <class CharType, class CharTraits>
+void basic_string<CharType, CharTraits>::swap(basic_string& rhs) {
+    if (this != &rhs) {
+        mystl::swap(buffer_, rhs.buffer_);
+        mystl::swap(size_, rhs.size_);
+        mystl::swap(cap_, rhs.cap_);
+    }
+}
+
+/*****************************************************************************************/
+// helper functions
+
+// 尝试分配初始空间，失败时保持为空
+template <class CharType, class CharTraits>
+void basic_string<CharType, CharTraits>::try_init() {
+    try {
+        buffer_ = data_allocator::allocate(static_cast<size_type>(StringInitSize));
+        size_ = 0;
+        cap_ = StringInitSize;
+    }
+    catch (...) {
+        buffer_ = nullptr;
+        size_ = 0;
+        cap_ = 0;
+    }
+}
+
+// 以 n 个 value 初始化，多留一个位置给结尾的空字符
+template <class CharType, class CharTraits>
+void basic_string<CharType, CharTraits>::fill_init(size_type n, value_type value) {
+    const size_type init_size = mystl::max(static_cast<size_type>(StringInitSize), n + 1);
+    buffer_ = data_allocator::allocate(init_size);
+    char_traits::fill(buffer_, value, n);
+    size_ = n;
+    cap_ = init_size;
+}
+
+// 以 src[pos, pos + count) 初始化
+template <class CharType, class CharTraits>
+void basic_string<CharType, CharTraits>::init_from(const_pointer src, size_type pos, size_type count) {
+    const size_type init_size = mystl::max(static_cast<size_type>(StringInitSize), count + 1);
+    buffer_ = data_allocator::allocate(init_size);
+    char_traits::copy(buffer_, src + pos, count);
+    size_ = count;
+    cap_ = init_size;
+}
+
+// 释放空间
+template <class CharType, class CharTraits>
+void basic_string<CharType, CharTraits>::destroy_buffer() {
+    if (buffer_ != nullptr) {
+        data_allocator::deallocate(buffer_, cap_);
+        buffer_ = nullptr;
+        size_ = 0;
+        cap_ = 0;
+    }
+}
+
+// 返回以空字符结尾的字符数组，空间不足时重新分配
+template <class CharType, class CharTraits>
+typename basic_string<CharType, CharTraits>::const_pointer basic_string<CharType, CharTraits>::to_raw_pointer() const {
+    if (size_ == cap_) {
+        auto self = const_cast<basic_string*>(this);
+        const size_type new_cap = size_ + 1;
+        auto new_buffer = data_allocator::allocate(new_cap);
+        if (size_ != 0) {
+            char_traits::copy(new_buffer, buffer_, size_);
+        }
+        data_allocator::deallocate(buffer_, cap_);
+        self->buffer_ = new_buffer;
+        self->cap_ = new_cap;
+    }
+    *(buffer_ + size_) = value_type();
+    return buffer_;
+}
+
+/*****************************************************************************************/
+// 哈希
+// hash<basic_string> 对字符数组的字节调用 hash_bytes，结果已经充分混合，mixed_hash 不再重复混合
+//
+// basic_hashed_string 在字符串旁边保存构造时计算的哈希值，之后不允许修改内容。
+// 同一个键反复查找时直接返回保存的值；比较相等时先比较哈希值，不同就不必比较字符。
+// 它多占一个 size_t，构造时多算一次哈希，只在键会被反复查找或比较时才值得使用
+/*****************************************************************************************/
+template <class CharType, class CharTraits>
+struct hash<basic_string<CharType, CharTraits>> {
+    size_t operator()(const basic_string<CharType, CharTraits>& str) const noexcept {
+        return mystl::hash_bytes(str.begin(), str.size() * sizeof(CharType));
+    }
+};
 
+template <class CharType, class CharTraits>
+struct is_avalanching_hash<hash<basic_string<CharType, CharTraits>>> : public std::true_type {};
 
+template <class CharType, class CharTraits = mystl::char_traits<CharType>>
+class basic_hashed_string {
+public:
+    typedef basic_string<CharType, CharTraits>          string_type;
+    typedef CharTraits                                  traits_type;
+    typedef typename string_type::value_type            value_type;
+    typedef typename string_type::size_type             size_type;
+    typedef typename string_type::const_pointer         const_pointer;
+    typedef typename string_type::const_iterator        const_iterator;
 
+private:
+    string_type str_;   // 字符串
+    size_t      hash_;  // str_ 的哈希值
+
+public:
+    basic_hashed_string() : str_(), hash_(hash<string_type>()(str_)) {}
 
+    basic_hashed_string(const string_type& str) : str_(str), hash_(hash<string_type>()(str_)) {}
 
+    basic_hashed_string(string_type&& str) : str_(mystl::move(str)), hash_(hash<string_type>()(str_)) {}
 
+    basic_hashed_string(const_pointer str) : str_(str), hash_(hash<string_type>()(str_)) {}
 
+    basic_hashed_string(const_pointer str, size_type count) : str_(str, count), hash_(hash<string_type>()(str_)) {}
+
+    basic_hashed_string(const basic_hashed_string& rhs) : str_(rhs.str_), hash_(rhs.hash_) {}
+
+    basic_hashed_string(basic_hashed_string&& rhs) : str_(mystl::move(rhs.str_)), hash_(rhs.hash_) {
+        rhs.hash_ = hash<string_type>()(rhs.str_);
+    }
 
+    basic_hashed_string& operator=(basic_hashed_string rhs) {
+        swap(rhs);
+        return *this;
+    }
+
+    // 只读访问
+    const string_type& str() const { return str_; }
+    const_pointer data() const { return str_.data(); }
+    const_pointer c_str() const { return str_.c_str(); }
+    const_iterator begin() const { return str_.begin(); }
+    const_iterator end() const { return str_.end(); }
+    size_type size() const { return str_.size(); }
+    size_type length() const { return str_.size(); }
+    bool empty() const { return str_.empty(); }
+
+    // 构造时计算的哈希值，与 hash<string_type>()(str()) 相同
+    size_t hash_code() const { return hash_; }
+
+    void swap(basic_hashed_string& rhs) {
+        str_.swap(rhs.str_);
+        mystl::swap(hash_, rhs.hash_);
+    }
+
+    // 哈希值或长度不同时不比较字符
+    friend bool operator==(const basic_hashed_string& lhs, const basic_hashed_string& rhs) {
+        return lhs.hash_ == rhs.hash_ && lhs.size() == rhs.size() &&
+               (lhs.empty() || traits_type::compare(lhs.str_.begin(), rhs.str_.begin(), lhs.size()) == 0);
+    }
+
+    friend bool operator!=(const basic_hashed_string& lhs, const basic_hashed_string& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+template <class CharType, class CharTraits>
+struct hash<basic_hashed_string<CharType, CharTraits>> {
+    size_t operator()(const basic_hashed_string<CharType, CharTraits>& str) const noexcept {
+        return str.hash_code();
+    }
+};
+
+template <class CharType, class CharTraits>
+struct is_avalanching_hash<hash<basic_hashed_string<CharType, CharTraits>>> : public std::true_type {};
+
+// 支持异构查找的字符串哈希函数与比较函数：basic_string、basic_hashed_string 与以空字符结尾的字符数组
+// 内容相同时哈希值相同、比较相等，以 basic_string 为键的 flat_hash_map 等容器用它们作为 Hash 与 KeyEqual 时，
+// 可以直接用字符数组查找，不必先构造 basic_string；basic_hashed_string 直接使用保存的哈希值
+template <class CharType, class CharTraits = mystl::char_traits<CharType>>
+struct basic_string_hash {
+    typedef void is_transparent;
+
+    size_t operator()(const basic_string<CharType, CharTraits>& str) const noexcept {
+        return mystl::hash_bytes(str.begin(), str.size() * sizeof(CharType));
+    }
+
+    size_t operator()(const basic_hashed_string<CharType, CharTraits>& str) const noexcept {
+        return str.hash_code();
+    }
+
+    size_t operator()(const CharType* str) const noexcept {
+        return mystl::hash_bytes(str, CharTraits::length(str) * sizeof(CharType));
+    }
+};
+
+template <class CharType, class CharTraits>
+struct is_avalanching_hash<basic_string_hash<CharType, CharTraits>> : public std::true_type {};
+
+template <class CharType, class CharTraits = mystl::char_traits<CharType>>
+struct basic_string_equal {
+    typedef void is_transparent;
+
+    template <class Lhs, class Rhs>
+    bool operator()(const Lhs& lhs, const Rhs& rhs) const {
+        return equal(view(lhs), view(rhs));
+    }
+
+private:
+    typedef mystl::pair<const CharType*, size_t> view_type;
+
+    static view_type view(const basic_string<CharType, CharTraits>& str) {
+        return view_type(str.begin(), str.size());
+    }
+
+    static view_type view(const basic_hashed_string<CharType, CharTraits>& str) {
+        return view_type(str.begin(), str.size());
+    }
+
+    static view_type view(const CharType* str) {
+        return view_type(str, CharTraits::length(str));
+    }
+
+    static bool equal(const view_type& lhs, const view_type& rhs) {
+        return lhs.second == rhs.second &&
+               (lhs.second == 0 || CharTraits::compare(lhs.first, rhs.first, lhs.second) == 0);
+    }
+};
+
+typedef basic_string_hash<char>     string_hash;
+typedef basic_string_equal<char>    string_equal;
+
+// 组合键中的字符串把字符直接写入哈希状态，basic_hashed_string 只写入保存的哈希值
+template <class HashState, class CharType, class CharTraits>
+void hash_append(HashState& h, const basic_string<CharType, CharTraits>& str) {
+    h.append_bytes(str.begin(), str.size() * sizeof(CharType));
+}
+
+template <class HashState, class CharType, class CharTraits>
+void hash_append(HashState& h, const basic_hashed_string<CharType, CharTraits>& str) {
+    h.append_word(static_cast<uint64_t>(str.hash_code()));
+}
+
+template <class CharType, class CharTraits>
+void swap(basic_hashed_string<CharType, CharTraits>& lhs, basic_hashed_string<CharType, CharTraits>& rhs) {
+    lhs.swap(rhs);
+}
 
+typedef basic_hashed_string<char>       hashed_string;
+typedef basic_hashed_string<wchar_t>    hashed_wstring;
 
 }
 
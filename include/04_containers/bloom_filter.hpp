@@ -0,0 +1,539 @@
+#ifndef MINITURE_STL_BLOOM_FILTER_HPP_
+#define MINITURE_STL_BLOOM_FILTER_HPP_
+
+// 这个头文件包含两个模板类 bloom_filter 和 blocked_bloom_filter
+// bloom_filter         : 经典的布隆过滤器，每个键在整个位数组中置 k 位
+// blocked_bloom_filter : 按缓存行分块的布隆过滤器，每个键只落在一个 64 字节的块中
+//
+// 布隆过滤器回答“键可能在集合中”或“键一定不在集合中”：插入过的键总会被判为存在，
+// 没有插入过的键以一定的概率 (false positive rate, FPR) 被误判为存在。不支持删除。
+//
+// bloom_filter 按期望元素个数 n 与目标误判率 p 取最优的位数 m = -n ln p / (ln 2)^2 与 k = m / n * ln 2，
+// 由一个 64 位哈希值用双重哈希 g_i = h1 + i * h2 得到 k 个位置，但每次查询要访问 k 条不同的缓存行。
+// blocked_bloom_filter 先用哈希值选出一个块，块内 8 个 64 位字各置 1 位，查询只读一条缓存行，
+// 启用 AVX2 / SSE2 时用向量指令一次生成并检查全部 8 位。代价是同样的误判率需要多用一些位
+//
+// 两者都可以与参数相同的另一个过滤器合并（按位或），也可以序列化为与平台无关的字节序列：
+// 8 字节的标识、几个 64 位的参数，然后是位数组，整数一律按小端序存放
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include "../00_utils/bitops.h"
+#include "../00_utils/exceptdef.h"
+#include "../01_allocators/allocator.h"
+#include "../01_allocators/util.h"
+#include "../03_algorithms/functional.h"
+#include "../03_algorithms/simd_algo.h"
+
+namespace mystl {
+
+// bloom_filter 的哈希函数个数上限
+const size_t BloomMaxHashes = 32;
+
+// 布隆过滤器使用的辅助函数
+
+// 把 h 均匀地映射到 [0, n)，用乘法的高 64 位代替取模
+inline uint64_t bloom_reduce(uint64_t h, uint64_t n) noexcept {
+    uint64_t hi;
+    mystl::mul64x64_128(h, n, &hi);
+    return hi;
+}
+
+inline void bloom_store_u64(unsigned char* out, uint64_t x) noexcept {
+    for (int i = 0; i < 8; ++i) {
+        out[i] = static_cast<unsigned char>(x >> (8 * i));
+    }
+}
+
+inline uint64_t bloom_load_u64(const unsigned char* in) noexcept {
+    uint64_t x = 0;
+    for (int i = 0; i < 8; ++i) {
+        x |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return x;
+}
+
+// 哈希值，Hash 的结果不够均匀时先混合
+template <class Hash, class Key>
+uint64_t bloom_hash(const Hash& hash, const Key& key, std::true_type) {
+    return static_cast<uint64_t>(hash(key));
+}
+
+template <class Hash, class Key>
+uint64_t bloom_hash(const Hash& hash, const Key& key, std::false_type) {
+    return mystl::hash_mix(static_cast<uint64_t>(hash(key)));
+}
+
+/*****************************************************************************************/
+
+// 模板类 bloom_filter
+// 参数一代表键的类型，参数二代表哈希函数，缺省使用 mystl::hash
+template <class Key, class Hash = mystl::hash<Key>>
+class bloom_filter {
+public:
+    typedef Key             key_type;
+    typedef Hash            hasher;
+    typedef size_t          size_type;
+
+private:
+    typedef mystl::allocator<uint64_t> word_allocator;
+
+    uint64_t*   words_;
+    size_type   num_words_;
+    size_type   num_bits_;
+    size_type   num_hashes_;
+    hasher      hash_;
+
+public:
+    // 构造、复制、移动、析构函数
+
+    // 按预计插入 expected_count 个键、误判率不超过 fpr 取位数与哈希函数个数，fpr 取 (0, 1)
+    bloom_filter(size_type expected_count, double fpr, const Hash& hash = Hash());
+
+    bloom_filter(const bloom_filter& rhs)
+        : words_(nullptr), num_words_(0), num_bits_(rhs.num_bits_), num_hashes_(rhs.num_hashes_), hash_(rhs.hash_) {
+        allocate_words(rhs.num_words_);
+        std::memcpy(words_, rhs.words_, num_words_ * sizeof(uint64_t));
+    }
+
+    bloom_filter(bloom_filter&& rhs) noexcept
+        : words_(rhs.words_), num_words_(rhs.num_words_), num_bits_(rhs.num_bits_),
+          num_hashes_(rhs.num_hashes_), hash_(rhs.hash_) {
+        rhs.words_ = nullptr;
+        rhs.num_words_ = 0;
+    }
+
+    bloom_filter& operator=(const bloom_filter& rhs) {
+        if (this != &rhs) {
+            bloom_filter temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    bloom_filter& operator=(bloom_filter&& rhs) noexcept {
+        if (this != &rhs) {
+            word_allocator::deallocate(words_, num_words_);
+            words_ = rhs.words_;
+            num_words_ = rhs.num_words_;
+            num_bits_ = rhs.num_bits_;
+            num_hashes_ = rhs.num_hashes_;
+            hash_ = rhs.hash_;
+            rhs.words_ = nullptr;
+            rhs.num_words_ = 0;
+        }
+        return *this;
+    }
+
+    ~bloom_filter() { word_allocator::deallocate(words_, num_words_); }
+
+public:
+    void insert(const key_type& key) noexcept(noexcept(hash_(key))) {
+        uint64_t h1, h2;
+        hash_pair(key, h1, h2);
+        for (size_type i = 0; i < num_hashes_; ++i) {
+            const uint64_t bit = bloom_reduce(h1, num_bits_);
+            words_[bit >> 6] |= static_cast<uint64_t>(1) << (bit & 63);
+            h1 += h2;
+        }
+    }
+
+    // 返回 false 时键一定没有插入过
+    bool contains(const key_type& key) const noexcept(noexcept(hash_(key))) {
+        uint64_t h1, h2;
+        hash_pair(key, h1, h2);
+        for (size_type i = 0; i < num_hashes_; ++i) {
+            const uint64_t bit = bloom_reduce(h1, num_bits_);
+            if ((words_[bit >> 6] & (static_cast<uint64_t>(1) << (bit & 63))) == 0) {
+                return false;
+            }
+            h1 += h2;
+        }
+        return true;
+    }
+
+    void clear() noexcept { std::memset(words_, 0, num_words_ * sizeof(uint64_t)); }
+
+    // 合并另一个位数与哈希函数个数都相同的过滤器，结果等价于两者插入过的键都插入到这一个中
+    void merge(const bloom_filter& rhs) {
+        THROW_RUNTIME_ERROR_IF(num_bits_ != rhs.num_bits_ || num_hashes_ != rhs.num_hashes_,
+                               "bloom_filter<Key>::merge requires filters of the same shape");
+        for (size_type i = 0; i < num_words_; ++i) {
+            words_[i] |= rhs.words_[i];
+        }
+    }
+
+    void swap(bloom_filter& rhs) noexcept {
+        mystl::swap(words_, rhs.words_);
+        mystl::swap(num_words_, rhs.num_words_);
+        mystl::swap(num_bits_, rhs.num_bits_);
+        mystl::swap(num_hashes_, rhs.num_hashes_);
+        mystl::swap(hash_, rhs.hash_);
+    }
+
+    size_type bit_count() const noexcept { return num_bits_; }
+    size_type hash_count() const noexcept { return num_hashes_; }
+
+    // 按当前置位的比例估计的误判率
+    double estimated_fpr() const noexcept {
+        size_type ones = 0;
+        for (size_type i = 0; i < num_words_; ++i) {
+            ones += static_cast<size_type>(mystl::popcount64(words_[i]));
+        }
+        return std::pow(static_cast<double>(ones) / static_cast<double>(num_bits_), static_cast<double>(num_hashes_));
+    }
+
+    hasher hash_function() const { return hash_; }
+
+    // 序列化：标识 "MYSTLBF1"、位数、哈希函数个数，然后是位数组
+    size_type serialized_size() const noexcept { return 24 + num_words_ * 8; }
+
+    void serialize(unsigned char* out) const noexcept {
+        std::memcpy(out, "MYSTLBF1", 8);
+        bloom_store_u64(out + 8, num_bits_);
+        bloom_store_u64(out + 16, num_hashes_);
+        for (size_type i = 0; i < num_words_; ++i) {
+            bloom_store_u64(out + 24 + i * 8, words_[i]);
+        }
+    }
+
+    // 从 serialize 得到的 size 个字节恢复过滤器，hash 必须与序列化时使用的哈希函数相同
+    static bloom_filter deserialize(const unsigned char* in, size_type size, const Hash& hash = Hash());
+
+private:
+    // 供 deserialize 使用，位数组全部清零
+    bloom_filter(size_type bits, size_type hashes, const Hash& hash)
+        : words_(nullptr), num_words_(0), num_bits_(bits), num_hashes_(hashes), hash_(hash) {
+        allocate_words((bits + 63) / 64);
+        clear();
+    }
+
+    void allocate_words(size_type n) {
+        words_ = word_allocator::allocate(n);
+        num_words_ = n;
+    }
+
+    // 双重哈希的两个参数，h2 为奇数，k 个位置互不相同的概率更高
+    void hash_pair(const key_type& key, uint64_t& h1, uint64_t& h2) const noexcept(noexcept(hash_(key))) {
+        h1 = bloom_hash(hash_, key, is_avalanching_hash<Hash>());
+        h2 = mystl::hash_mix(h1 ^ 0x9e3779b97f4a7c15ull) | 1;
+    }
+};
+
+template <class Key, class Hash>
+bloom_filter<Key, Hash>::bloom_filter(size_type expected_count, double fpr, const Hash& hash)
+    : words_(nullptr), num_words_(0), num_bits_(0), num_hashes_(0), hash_(hash) {
+    THROW_OUT_OF_RANGE_IF(!(fpr > 0.0 && fpr < 1.0), "bloom_filter<Key>'s false positive rate must be in (0, 1)");
+    const double ln2 = 0.69314718055994530942;
+    const double n = static_cast<double>(expected_count != 0 ? expected_count : 1);
+    const double bits = std::ceil(-n * std::log(fpr) / (ln2 * ln2));
+    THROW_LENGTH_ERROR_IF(bits > 9.0e18, "bloom_filter<Key>'s size too big");
+    num_bits_ = static_cast<size_type>(bits) < 64 ? 64 : static_cast<size_type>(bits);
+    const double k = std::round(static_cast<double>(num_bits_) / n * ln2);
+    num_hashes_ = k < 1.0 ? 1 : (k > static_cast<double>(BloomMaxHashes) ? BloomMaxHashes : static_cast<size_type>(k));
+    allocate_words((num_bits_ + 63) / 64);
+    clear();
+}
+
+template <class Key, class Hash>
+bloom_filter<Key, Hash> bloom_filter<Key, Hash>::deserialize(const unsigned char* in, size_type size,
+                                                             const Hash& hash) {
+    THROW_RUNTIME_ERROR_IF(size < 24 || std::memcmp(in, "MYSTLBF1", 8) != 0,
+                           "bloom_filter<Key>::deserialize: not a serialized bloom_filter");
+    const uint64_t bits = bloom_load_u64(in + 8);
+    const uint64_t hashes = bloom_load_u64(in + 16);
+    // 位数组恰好占 payload 个字节：bits 落在 (payload * 8 - 64, payload * 8] 内，不计算 bits + 63 以免回绕
+    const size_type payload = size - 24;
+    THROW_RUNTIME_ERROR_IF(payload == 0 || payload % 8 != 0 || payload > static_cast<size_type>(-1) / 8,
+                           "bloom_filter<Key>::deserialize: size does not match");
+    THROW_RUNTIME_ERROR_IF(bits > payload * 8 || bits <= payload * 8 - 64,
+                           "bloom_filter<Key>::deserialize: size does not match");
+    THROW_RUNTIME_ERROR_IF(hashes == 0 || hashes > BloomMaxHashes,
+                           "bloom_filter<Key>::deserialize: bad hash count");
+    bloom_filter filter(static_cast<size_type>(bits), static_cast<size_type>(hashes), hash);
+    for (size_type i = 0; i < filter.num_words_; ++i) {
+        filter.words_[i] = bloom_load_u64(in + 24 + i * 8);
+    }
+    return filter;
+}
+
+// 重载 mystl 的 swap
+template <class Key, class Hash>
+void swap(bloom_filter<Key, Hash>& lhs, bloom_filter<Key, Hash>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+
+// 每块的字节数与 64 位字数，块按缓存行对齐
+const size_t BloomBlockBytes = 64;
+const size_t BloomBlockWords = 8;
+
+// 模板类 blocked_bloom_filter
+// 参数与 bloom_filter 相同
+// 哈希值 h 选块，h 混合后的 48 位分成 8 段，每段 6 位指定块中对应的字要置的位，每个键置 8 位
+template <class Key, class Hash = mystl::hash<Key>>
+class blocked_bloom_filter {
+public:
+    typedef Key             key_type;
+    typedef Hash            hasher;
+    typedef size_t          size_type;
+
+private:
+    void*       raw_;           // 分配得到的原始内存
+    uint64_t*   blocks_;        // 按缓存行对齐的位数组
+    size_type   num_blocks_;
+    hasher      hash_;
+
+public:
+    // 构造、复制、移动、析构函数
+
+    // 按预计插入 expected_count 个键、误判率不超过 fpr 取块数，fpr 取 (0, 1)
+    blocked_bloom_filter(size_type expected_count, double fpr, const Hash& hash = Hash());
+
+    blocked_bloom_filter(const blocked_bloom_filter& rhs)
+        : raw_(nullptr), blocks_(nullptr), num_blocks_(0), hash_(rhs.hash_) {
+        allocate_blocks(rhs.num_blocks_);
+        std::memcpy(blocks_, rhs.blocks_, num_blocks_ * BloomBlockBytes);
+    }
+
+    blocked_bloom_filter(blocked_bloom_filter&& rhs) noexcept
+        : raw_(rhs.raw_), blocks_(rhs.blocks_), num_blocks_(rhs.num_blocks_), hash_(rhs.hash_) {
+        rhs.raw_ = nullptr;
+        rhs.blocks_ = nullptr;
+        rhs.num_blocks_ = 0;
+    }
+
+    blocked_bloom_filter& operator=(const blocked_bloom_filter& rhs) {
+        if (this != &rhs) {
+            blocked_bloom_filter temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    blocked_bloom_filter& operator=(blocked_bloom_filter&& rhs) noexcept {
+        if (this != &rhs) {
+            ::operator delete(raw_);
+            raw_ = rhs.raw_;
+            blocks_ = rhs.blocks_;
+            num_blocks_ = rhs.num_blocks_;
+            hash_ = rhs.hash_;
+            rhs.raw_ = nullptr;
+            rhs.blocks_ = nullptr;
+            rhs.num_blocks_ = 0;
+        }
+        return *this;
+    }
+
+    ~blocked_bloom_filter() { ::operator delete(raw_); }
+
+public:
+    void insert(const key_type& key) noexcept(noexcept(hash_(key))) {
+        const uint64_t h = bloom_hash(hash_, key, is_avalanching_hash<Hash>());
+        set_block(blocks_ + bloom_reduce(h, num_blocks_) * BloomBlockWords, mystl::hash_mix(h));
+    }
+
+    // 返回 false 时键一定没有插入过
+    bool contains(const key_type& key) const noexcept(noexcept(hash_(key))) {
+        const uint64_t h = bloom_hash(hash_, key, is_avalanching_hash<Hash>());
+        return test_block(blocks_ + bloom_reduce(h, num_blocks_) * BloomBlockWords, mystl::hash_mix(h));
+    }
+
+    // 提示 CPU 预取 key 所在的块，批量查询时先对后面的键调用，可以把访存延迟重叠起来
+    void prefetch(const key_type& key) const noexcept(noexcept(hash_(key))) {
+        const uint64_t h = bloom_hash(hash_, key, is_avalanching_hash<Hash>());
+        MYSTL_PREFETCH(blocks_ + bloom_reduce(h, num_blocks_) * BloomBlockWords);
+    }
+
+    void clear() noexcept { std::memset(blocks_, 0, num_blocks_ * BloomBlockBytes); }
+
+    // 合并另一个块数相同的过滤器
+    void merge(const blocked_bloom_filter& rhs) {
+        THROW_RUNTIME_ERROR_IF(num_blocks_ != rhs.num_blocks_,
+                               "blocked_bloom_filter<Key>::merge requires filters of the same shape");
+        const size_type n = num_blocks_ * BloomBlockWords;
+        for (size_type i = 0; i < n; ++i) {
+            blocks_[i] |= rhs.blocks_[i];
+        }
+    }
+
+    void swap(blocked_bloom_filter& rhs) noexcept {
+        mystl::swap(raw_, rhs.raw_);
+        mystl::swap(blocks_, rhs.blocks_);
+        mystl::swap(num_blocks_, rhs.num_blocks_);
+        mystl::swap(hash_, rhs.hash_);
+    }
+
+    size_type block_count() const noexcept { return num_blocks_; }
+    size_type bit_count() const noexcept { return num_blocks_ * BloomBlockBytes * 8; }
+
+    hasher hash_function() const { return hash_; }
+
+    // 每块中 j 个键时，8 个字都恰好命中的概率为 (1 - (63/64)^j)^8，对服从泊松分布的 j 求期望
+    static double expected_fpr(double keys_per_block) noexcept;
+
+    // 序列化：标识 "MYSTLBB1"、块数，然后是位数组
+    size_type serialized_size() const noexcept { return 16 + num_blocks_ * BloomBlockBytes; }
+
+    void serialize(unsigned char* out) const noexcept {
+        std::memcpy(out, "MYSTLBB1", 8);
+        bloom_store_u64(out + 8, num_blocks_);
+        const size_type n = num_blocks_ * BloomBlockWords;
+        for (size_type i = 0; i < n; ++i) {
+            bloom_store_u64(out + 16 + i * 8, blocks_[i]);
+        }
+    }
+
+    static blocked_bloom_filter deserialize(const unsigned char* in, size_type size, const Hash& hash = Hash());
+
+private:
+    // 供 deserialize 使用，位数组全部清零
+    blocked_bloom_filter(size_type blocks, const Hash& hash)
+        : raw_(nullptr), blocks_(nullptr), num_blocks_(0), hash_(hash) {
+        allocate_blocks(blocks);
+        clear();
+    }
+
+    void allocate_blocks(size_type n) {
+        THROW_LENGTH_ERROR_IF(n > (static_cast<size_type>(-1) - BloomBlockBytes) / BloomBlockBytes,
+                              "blocked_bloom_filter<Key>'s size too big");
+        raw_ = ::operator new(n * BloomBlockBytes + BloomBlockBytes);
+        const size_t addr = reinterpret_cast<size_t>(raw_);
+        blocks_ = reinterpret_cast<uint64_t*>((addr + BloomBlockBytes - 1) / BloomBlockBytes * BloomBlockBytes);
+        num_blocks_ = n;
+    }
+
+    // 第 i 个字要置的位为 1 << (g 的第 6i 到 6i + 5 位)
+    static uint64_t word_bit(uint64_t g, size_type i) noexcept {
+        return static_cast<uint64_t>(1) << ((g >> (6 * i)) & 63);
+    }
+
+#if MYSTL_HAS_AVX2
+    // 一次生成前后 4 个字的掩码
+    static void make_mask(uint64_t g, __m256i& lo, __m256i& hi) noexcept {
+        const __m256i h = _mm256_set1_epi64x(static_cast<long long>(g));
+        const __m256i low6 = _mm256_set1_epi64x(63);
+        const __m256i one = _mm256_set1_epi64x(1);
+        lo = _mm256_sllv_epi64(one, _mm256_and_si256(_mm256_srlv_epi64(h, _mm256_setr_epi64x(0, 6, 12, 18)), low6));
+        hi = _mm256_sllv_epi64(one, _mm256_and_si256(_mm256_srlv_epi64(h, _mm256_setr_epi64x(24, 30, 36, 42)), low6));
+    }
+#endif
+
+    static void set_block(uint64_t* block, uint64_t g) noexcept {
+#if MYSTL_HAS_AVX2
+        __m256i m0, m1;
+        make_mask(g, m0, m1);
+        __m256i* b = reinterpret_cast<__m256i*>(block);
+        _mm256_store_si256(b, _mm256_or_si256(_mm256_load_si256(b), m0));
+        _mm256_store_si256(b + 1, _mm256_or_si256(_mm256_load_si256(b + 1), m1));
+#else
+        for (size_type i = 0; i < BloomBlockWords; ++i) {
+            block[i] |= word_bit(g, i);
+        }
+#endif
+    }
+
+    // 块中包含掩码的全部 8 位时返回 true
+    // 掩码直接在寄存器中生成，不经过内存，避免先按 64 位写入再按向量读出造成的存储转发失败
+    static bool test_block(const uint64_t* block, uint64_t g) noexcept {
+#if MYSTL_HAS_AVX2
+        __m256i m0, m1;
+        make_mask(g, m0, m1);
+        const __m256i b0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(block));
+        const __m256i b1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(block + 4));
+        // testc 在 ~b & m 全为 0 时返回 1
+        return (_mm256_testc_si256(b0, m0) & _mm256_testc_si256(b1, m1)) != 0;
+#elif MYSTL_HAS_SSE2
+        __m128i missing = _mm_setzero_si128();
+        for (size_type i = 0; i < BloomBlockWords; i += 2) {
+            const __m128i m = _mm_set_epi64x(static_cast<long long>(word_bit(g, i + 1)),
+                                             static_cast<long long>(word_bit(g, i)));
+            const __m128i b = _mm_load_si128(reinterpret_cast<const __m128i*>(block + i));
+            missing = _mm_or_si128(missing, _mm_andnot_si128(b, m));
+        }
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(missing, _mm_setzero_si128())) == 0xffff;
+#else
+        uint64_t missing = 0;
+        for (size_type i = 0; i < BloomBlockWords; ++i) {
+            missing |= word_bit(g, i) & ~block[i];
+        }
+        return missing == 0;
+#endif
+    }
+};
+
+template <class Key, class Hash>
+double blocked_bloom_filter<Key, Hash>::expected_fpr(double keys_per_block) noexcept {
+    const double lambda = keys_per_block;
+    const size_type last = static_cast<size_type>(lambda + 12.0 * std::sqrt(lambda) + 32.0);
+    // 泊松分布的概率从众数向两侧递推，避免 lambda 较大时 exp(-lambda) 下溢
+    const size_type mode = static_cast<size_type>(lambda);
+    const double p_mode = std::exp(static_cast<double>(mode) * std::log(lambda > 0.0 ? lambda : 1.0) - lambda -
+                                   std::lgamma(static_cast<double>(mode) + 1.0));
+    double fpr = 0.0;
+    double p = p_mode;
+    for (size_type j = mode; j <= last; ++j) {
+        fpr += p * std::pow(1.0 - std::pow(63.0 / 64.0, static_cast<double>(j)), 8.0);
+        p *= lambda / static_cast<double>(j + 1);
+    }
+    p = p_mode;
+    for (size_type j = mode; j > 0; --j) {
+        p *= static_cast<double>(j) / lambda;
+        fpr += p * std::pow(1.0 - std::pow(63.0 / 64.0, static_cast<double>(j - 1)), 8.0);
+    }
+    return fpr;
+}
+
+// 二分查找满足误判率的最大平均每块键数，再由此得到块数
+template <class Key, class Hash>
+blocked_bloom_filter<Key, Hash>::blocked_bloom_filter(size_type expected_count, double fpr, const Hash& hash)
+    : raw_(nullptr), blocks_(nullptr), num_blocks_(0), hash_(hash) {
+    THROW_OUT_OF_RANGE_IF(!(fpr > 0.0 && fpr < 1.0),
+                          "blocked_bloom_filter<Key>'s false positive rate must be in (0, 1)");
+    double lo = 0.0, hi = 512.0;
+    for (int i = 0; i < 60; ++i) {
+        const double mid = (lo + hi) / 2;
+        if (expected_fpr(mid) <= fpr) {
+            lo = mid;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    const double n = static_cast<double>(expected_count != 0 ? expected_count : 1);
+    const double blocks = lo > 0.0 ? std::ceil(n / lo) : n * 64.0;
+    THROW_LENGTH_ERROR_IF(blocks > 1.0e17, "blocked_bloom_filter<Key>'s size too big");
+    allocate_blocks(blocks < 1.0 ? 1 : static_cast<size_type>(blocks));
+    clear();
+}
+
+template <class Key, class Hash>
+blocked_bloom_filter<Key, Hash> blocked_bloom_filter<Key, Hash>::deserialize(const unsigned char* in,
+                                                                             size_type size, const Hash& hash) {
+    THROW_RUNTIME_ERROR_IF(size < 16 || std::memcmp(in, "MYSTLBB1", 8) != 0,
+                           "blocked_bloom_filter<Key>::deserialize: not a serialized blocked_bloom_filter");
+    const uint64_t blocks = bloom_load_u64(in + 8);
+    THROW_RUNTIME_ERROR_IF(blocks == 0 || (size - 16) % BloomBlockBytes != 0 || (size - 16) / BloomBlockBytes != blocks,
+                           "blocked_bloom_filter<Key>::deserialize: size does not match");
+    blocked_bloom_filter filter(static_cast<size_type>(blocks), hash);
+    const size_type n = filter.num_blocks_ * BloomBlockWords;
+    for (size_type i = 0; i < n; ++i) {
+        filter.blocks_[i] = bloom_load_u64(in + 16 + i * 8);
+    }
+    return filter;
+}
+
+// 重载 mystl 的 swap
+template <class Key, class Hash>
+void swap(blocked_bloom_filter<Key, Hash>& lhs, blocked_bloom_filter<Key, Hash>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // end namespace mystl
+
+#endif // MINITURE_STL_BLOOM_FILTER_HPP_
@@ -0,0 +1,664 @@
+#ifndef MINITURE_STL_CONCURRENT_HASH_MAP_HPP_
+#define MINITURE_STL_CONCURRENT_HASH_MAP_HPP_
+
+// 这个头文件包含了一个模板类 concurrent_hash_map
+// concurrent_hash_map: 可以被多个线程同时读写的哈希映射
+//
+// 哈希值的高位把键分到若干个分片 (shard)，每个分片是一张独立的线性探测表，有自己的互斥量与版本号。
+// 写操作只锁住键所在的分片；扩容也只在一个分片内进行，其他分片的读写照常，不会让整张表停下来
+//
+// 键与映射值都可平凡复制时，查找不加锁，按顺序锁 (seqlock) 的方式乐观读：
+// 写者修改前后各把版本号加一，读者在读之前和之后各读一次版本号，两次相同且为偶数才采用读到的结果，
+// 否则重读。扩容时新表建好后才替换指针，旧表留到析构时才释放，正在读旧表的线程不会访问到已释放的内存。
+// 表按倍数增长，留下的旧表加起来不超过当前的表。其他类型的键或值无法安全地乐观复制，查找时锁住分片
+//
+// 元素可能随时被其他线程修改或删除，因此不提供迭代器与引用：
+// 查找把映射值复制出来，修改通过 insert_or_assign、compute 等在锁内完成
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+#include "../00_utils/bitops.h"
+#include "../00_utils/parallel.h"
+#include "../01_allocators/construct.h"
+#include "../01_allocators/util.h"
+#include "../03_algorithms/functional.h"
+
+namespace mystl {
+
+// 每个分片的最小容量
+const size_t ConcurrentHashMinCapacity = 16;
+
+// 模板类 concurrent_hash_map
+// 参数依次为键类型、映射值类型、哈希函数（缺省使用 mystl::mixed_hash）、键的比较函数（缺省使用 mystl::equal_to）
+// Hash 的结果不是 is_avalanching_hash 时，表内先用 hash_mix 混合
+template <class Key, class Type, class Hash = mystl::mixed_hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+class concurrent_hash_map {
+public:
+    typedef Key             key_type;
+    typedef Type            mapped_type;
+    typedef Hash            hasher;
+    typedef KeyEqual        key_equal;
+    typedef size_t          size_type;
+
+private:
+    // 一个分片的槽数组：控制字节为 0 表示空槽，否则为 0x80 与哈希值中 7 位的组合
+    struct shard_table {
+        size_type                   mask;       // 容量减一，容量为 2 的幂
+        std::atomic<unsigned char>* ctrl;
+        key_type*                   keys;
+        mapped_type*                values;
+        shard_table*                retired;    // 被替换下来的旧表串成的链表
+    };
+
+    struct alignas(mystl::cache_line_size) shard {
+        std::atomic<uint64_t>       version;    // 奇数表示正在写
+        std::atomic<shard_table*>   table;
+        std::atomic<size_type>      size;
+        std::mutex                  mutex;      // 写者之间互斥
+        shard_table*                retired;
+    };
+
+    // 键与值都可平凡复制时查找不加锁
+    // 注意：乐观读用 memcpy 复制写者可能同时在改的键与值，按 C++ 内存模型这是数据竞争，形式上是未定义行为；
+    // 结果只在版本号不变时采用，在主流编译器与平台上可以正常工作（seqlock 的常见写法），但 ThreadSanitizer 会报告它。
+    // 需要严格符合标准时，可以让 optimistic_read 恒为 false_type，改为加锁查找
+    typedef std::integral_constant<bool, std::is_trivially_copyable<Key>::value &&
+                                         std::is_trivially_copyable<Type>::value> optimistic_read;
+
+    // 写区间：构造时版本号变为奇数，析构时变回偶数，中途抛出异常也能结束
+    class write_section {
+    public:
+        explicit write_section(std::atomic<uint64_t>& version) noexcept : version_(version) {
+            const uint64_t v = version_.load(std::memory_order_relaxed);
+            version_.store(v + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        ~write_section() {
+            version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        write_section(const write_section&) = delete;
+        write_section& operator=(const write_section&) = delete;
+
+    private:
+        std::atomic<uint64_t>& version_;
+    };
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    void*       shard_mem_;     // 分片数组所在的内存，按缓存行对齐后得到 shards_
+    shard*      shards_;
+    size_type   shard_mask_;    // 分片数减一，分片数为 2 的幂
+    hasher      hash_;
+    key_equal   equal_;
+
+public:
+    // 构造、析构函数
+    // concurrency 为预计同时写的线程数，为 0 时取硬件线程数；分片数取它的 4 倍向上取整为 2 的幂
+    explicit concurrent_hash_map(size_type concurrency = 0, const Hash& hash = Hash(),
+                                 const KeyEqual& equal = KeyEqual());
+
+    concurrent_hash_map(const concurrent_hash_map&) = delete;
+    concurrent_hash_map& operator=(const concurrent_hash_map&) = delete;
+
+    // 析构时不能有其他线程仍在访问
+    ~concurrent_hash_map();
+
+public:
+    // 容量相关操作，并发修改时结果只是某一时刻的近似值
+    bool empty() const noexcept { return size() == 0; }
+
+    size_type size() const noexcept {
+        size_type n = 0;
+        for (size_type i = 0; i <= shard_mask_; ++i) {
+            n += shards_[i].size.load(std::memory_order_relaxed);
+        }
+        return n;
+    }
+
+    size_type shard_count() const noexcept { return shard_mask_ + 1; }
+
+    // 查找相关操作
+
+    // 找到时把映射值复制到 value 中并返回 true
+    bool find(const key_type& key, mapped_type& value) const {
+        const uint64_t hash = hash_of(key);
+        return find_aux(shard_of(hash), key, hash, &value, optimistic_read());
+    }
+
+    bool contains(const key_type& key) const {
+        const uint64_t hash = hash_of(key);
+        return find_aux(shard_of(hash), key, hash, static_cast<mapped_type*>(nullptr), optimistic_read());
+    }
+
+    size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+    // 修改容器相关操作，每个操作对同一个键都是原子的
+
+    // 键不存在时插入，返回是否插入
+    template <class... Args>
+    bool emplace(const key_type& key, Args&&... args);
+
+    bool insert(const key_type& key, const mapped_type& value) { return emplace(key, value); }
+    bool insert(const key_type& key, mapped_type&& value) { return emplace(key, mystl::move(value)); }
+
+    // 键不存在时插入，存在时赋值，返回是否插入
+    template <class M>
+    bool insert_or_assign(const key_type& key, M&& obj);
+
+    // 在锁内以映射值的引用调用 f(value)；键不存在时先对值初始化的映射值调用 f，再插入。返回是否插入
+    // f 抛出异常时，新键不会被插入，已有的值保留 f 已经做出的修改
+    template <class Func>
+    bool compute(const key_type& key, Func f);
+
+    // 键存在时在锁内调用 f(value)，返回键是否存在
+    template <class Func>
+    bool compute_if_present(const key_type& key, Func f);
+
+    // 返回删除的元素个数
+    size_type erase(const key_type& key);
+
+    // 逐个分片清空，保留容量
+    void clear();
+
+    // 使每个分片不必扩容就能放下 count / shard_count() 个元素
+    void reserve(size_type count);
+
+    // 逐个分片加锁，对每个元素调用 f(key, value)，f 中不能再访问这张表
+    template <class Func>
+    void for_each(Func f) const;
+
+    hasher hash_function() const { return hash_; }
+    key_equal key_eq() const { return equal_; }
+
+private:
+    // helper functions
+
+    // 哈希值总是扩展到 64 位：size_t 只有 32 位时，即使 Hash 已充分混合也要再混合一次得到高 32 位
+    uint64_t hash_of(const key_type& key) const {
+        return mix(hash_(key), std::integral_constant<bool, is_avalanching_hash<Hash>::value &&
+                                                            sizeof(size_t) >= sizeof(uint64_t)>());
+    }
+
+    static uint64_t mix(size_t h, std::true_type) noexcept { return h; }
+    static uint64_t mix(size_t h, std::false_type) noexcept { return mystl::hash_mix64(h); }
+
+    // 64 位哈希值的第 40 位以上选分片，第 32 到 38 位作控制字节，低位选槽，三者互不重叠
+    shard& shard_of(uint64_t hash) const noexcept { return shards_[(hash >> 40) & shard_mask_]; }
+
+    static unsigned char tag_of(uint64_t hash) noexcept {
+        return static_cast<unsigned char>(0x80 | ((hash >> 32) & 0x7f));
+    }
+
+    // 最多放入容量的 3/4
+    static bool need_grow(const shard_table* t, size_type n) noexcept {
+        return t == nullptr || n > (t->mask + 1) / 4 * 3;
+    }
+
+    bool find_aux(shard& s, const key_type& key, uint64_t hash, mapped_type* value, std::true_type) const;
+    bool find_aux(shard& s, const key_type& key, uint64_t hash, mapped_type* value, std::false_type) const;
+
+    // 在持有分片锁时查找键所在的槽，找不到时返回 npos
+    size_type find_index(const shard_table* t, const key_type& key, uint64_t hash) const;
+
+    // 在持有分片锁时保证能再放入一个元素，返回当前的表
+    shard_table* prepare_insert(shard& s);
+
+    // 在持有分片锁时把键与值放入空槽，由调用者保证键不存在且容量足够
+    template <class KeyArg, class... Args>
+    void insert_new(shard& s, shard_table* t, uint64_t hash, KeyArg&& key, Args&&... args);
+
+    void erase_at(shard_table* t, size_type i);
+
+    static shard_table* allocate_table(size_type cap);
+    static void destroy_table(shard_table* t) noexcept;
+
+    // 把分片扩容到 cap 个槽，新表建好后才替换旧表
+    void rehash_shard(shard& s, size_type cap);
+
+    // 旧表在乐观读时要留到析构，否则立即释放
+    static void retire(shard& s, shard_table* t, std::true_type) noexcept {
+        t->retired = s.retired;
+        s.retired = t;
+    }
+    static void retire(shard&, shard_table* t, std::false_type) noexcept { destroy_table(t); }
+
+    static void wait_even(const std::atomic<uint64_t>& version, uint64_t& v) noexcept {
+        for (size_type spins = 0; v & 1; ++spins) {
+            if (spins < 64) {
+                mystl::cpu_relax();
+            }
+            else {
+                std::this_thread::yield();
+            }
+            v = version.load(std::memory_order_acquire);
+        }
+    }
+};
+
+/*****************************************************************************************/
+
+template <class Key, class Type, class Hash, class KeyEqual>
+concurrent_hash_map<Key, Type, Hash, KeyEqual>::concurrent_hash_map(size_type concurrency, const Hash& hash,
+                                                                    const KeyEqual& equal)
+    : shard_mem_(nullptr), shards_(nullptr), shard_mask_(0), hash_(hash), equal_(equal) {
+    if (concurrency == 0) {
+        concurrency = std::thread::hardware_concurrency();
+        concurrency = concurrency != 0 ? concurrency : 1;
+    }
+    size_type n = 1;
+    while (n < concurrency * 4 && n < (static_cast<size_type>(1) << 20)) {
+        n <<= 1;
+    }
+    // 每个分片独占缓存行，不同分片的写者不会争用同一行
+    shard_mem_ = ::operator new(n * sizeof(shard) + mystl::cache_line_size);
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(shard_mem_);
+    shards_ = reinterpret_cast<shard*>((addr + mystl::cache_line_size - 1) & ~(mystl::cache_line_size - 1));
+    shard_mask_ = n - 1;
+    for (size_type i = 0; i < n; ++i) {
+        new (shards_ + i) shard();
+        shards_[i].version.store(0, std::memory_order_relaxed);
+        shards_[i].table.store(nullptr, std::memory_order_relaxed);
+        shards_[i].size.store(0, std::memory_order_relaxed);
+        shards_[i].retired = nullptr;
+    }
+}
+
+template <class Key, class Type, class Hash, class KeyEqual>
+concurrent_hash_map<Key, Type, Hash, KeyEqual>::~concurrent_hash_map() {
+    for (size_type i = 0; i <= shard_mask_; ++i) {
+        shard_table* t = shards_[i].table.load(std::memory_order_relaxed);
+        if (t != nullptr) {
+            for (size_type j = 0; j <= t->mask; ++j) {
+                if (t->ctrl[j].load(std::memory_order_relaxed) != 0) {
+                    mystl::destroy(t->keys + j);
+                    mystl::destroy(t->values + j);
+                }
+            }
+            destroy_table(t);
+        }
+        // 旧表中的元素都已移入新表，只剩内存
+        shard_table* r = shards_[i].retired;
+        while (r != nullptr) {
+            shard_table* next = r->retired;
+            destroy_table(r);
+            r = next;
+        }
+    }
+    for (size_type i = 0; i <= shard_mask_; ++i) {
+        shards_[i].~shard();
+    }
+    ::operator delete(shard_mem_);
+}
+
+// 乐观读：键与值先复制到局部的缓冲区，版本号没有变化才把值交给调用者。
+// 读到一半时写者可能正在修改，缓冲区里的内容可能是不一致的，但只会被比较，不会被采用
+template <class Key, class Type, class Hash, class KeyEqual>
+bool concurrent_hash_map<Key, Type, Hash, KeyEqual>::find_aux(shard& s, const key_type& key, uint64_t hash,
+                                                              mapped_type* value, std::true_type) const {
+    typename std::aligned_storage<sizeof(Key), alignof(Key)>::type key_buf;
+    typename std::aligned_storage<sizeof(Type), alignof(Type)>::type value_buf;
+    const unsigned char tag = tag_of(hash);
+    while (true) {
+        uint64_t v = s.version.load(std::memory_order_acquire);
+        wait_even(s.version, v);
+        const shard_table* t = s.table.load(std::memory_order_acquire);
+        bool found = false;
+        if (t != nullptr) {
+            size_type i = static_cast<size_type>(hash) & t->mask;
+            for (size_type probes = 0; probes <= t->mask; ++probes, i = (i + 1) & t->mask) {
+                const unsigned char c = t->ctrl[i].load(std::memory_order_relaxed);
+                if (c == 0) {
+                    break;
+                }
+                if (c == tag) {
+                    std::memcpy(&key_buf, t->keys + i, sizeof(Key));
+                    if (equal_(*reinterpret_cast<const Key*>(&key_buf), key)) {
+                        if (value != nullptr) {
+                            std::memcpy(&value_buf, t->values + i, sizeof(Type));
+                        }
+                        found = true;
+                        break;
+                    }
+                }
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s.version.load(std::memory_order_relaxed) == v) {
+            if (found && value != nullptr) {
+                std::memcpy(value, &value_buf, sizeof(Type));
+            }
+            return found;
+        }
+    }
+}
+
+template <class Key, class Type, class Hash, class KeyEqual>
+bool concurrent_hash_map<Key, Type, Hash, KeyEqual>::find_aux(shard& s, const key_type& key, uint64_t hash,
+                                                              mapped_type* value, std::false_type) const {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    const shard_table* t = s.table.load(std::memory_order_relaxed);
+    const size_type i = find_index(t, key, hash);
+    if (i == npos) {
+        return false;
+    }
+    if (value != nullptr) {
+        *value = t->values[i];
+    }
+    return true;
+}
+
+template <class Key, class Type, class Hash, class KeyEqual>
+typename concurrent_hash_map<Key, Type, Hash, KeyEqual>::size_type
+concurrent_hash_map<Key, Type, Hash, KeyEqual>::find_index(const shard_table* t, const key_type& key,
+                                                           uint64_t hash) const {
+    if (t == nullptr) {
+        return npos;
+    }
+    const unsigned char tag = tag_of(hash);
+    size_type i = static_cast<size_type>(hash) & t->mask;
+    while (true) {
+        const unsigned char c = t->ctrl[i].load(std::memory_order_relaxed);
+        if (c == 0) {
+            return npos;
+        }
+        if (c == tag && equal_(t->keys[i], key)) {
+            return i;
+        }
+        i = (i + 1) & t->mask;
+    }
+}
+
+template <class Key, class Type, class Hash, class KeyEqual>
+typename concurrent_hash_map<Key, Type, Hash, KeyEqual>::shard_table*
+concurrent_hash_map<Key, Type, Hash, KeyEqual>::prepare_insert(shard& s) {
+    shard_table* t = s.table.load(std::memory_order_relaxed);
+    const size_type n = s.size.load(std::memory_order_relaxed) + 1;
+    if (need_grow(t, n)) {
+        rehash_shard(s, t == nullptr ? ConcurrentHashMinCapacity : (t->mask + 1) * 2);
+        t = s.table.load(std::memory_order_relaxed);
+    }
+    return t;
+}
+
+// 键与值先构造，最后才写控制字节，构造失败时槽仍为空
+template <class Key, class Type, class Hash, class KeyEqual>
+template <class KeyArg, class... Args>
+void concurrent_hash_map<Key, Type, Hash, KeyEqual>::insert_new(shard& s, shard_table* t, uint64_t hash,
+                                                                KeyArg&& key, Args&&... args) {
+    size_type i = static_cast<size_type>(hash) & t->mask;
+    while (t->ctrl[i].load(std::memory_order_relaxed) != 0) {
+        i = (i + 1) & t->mask;
+    }
+    write_section section(s.version);
+    mystl::construct(t->keys + i, mystl::forward<KeyArg>(key));
+    try {
+        mystl::construct(t->values + i, mystl::forward<Args>(args)...);
+    }
+    catch (...) {
+        mystl::destroy(t->keys + i);
+        throw;
+    }
+    t->ctrl[i].store(tag_of(hash), std::memory_order_relaxed);
+    s.size.store(s.size.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+template <class Key, class Type, class Hash, class KeyEqual>
+template <class... Args>
+bool concurrent_hash_map<Key, Type, Hash, KeyEqual>::emplace(const key_type& key, Args&&... args) {
+    const uint64_t hash = hash_of(key);
+    shard& s = shard_of(hash);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (find_index(s.table.load(std::memory_order_relaxed), key, hash) != npos) {
+        return false;
+    }
+    insert_new(s, prepare_insert(s), hash, key, mystl::forward<Args>(args)...);
+    return true;
+}
+
+template <class Key, class Type, class Hash, class KeyEqual>
+template <class M>
+bool concurrent_hash_map<Key, Type, Hash, KeyEqual>::insert_or_assign(const key_type& key, M&& obj) {
+    const uint64_t hash = hash_of(key);
+    shard& s = shard_of(hash);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    shard_table* t = s.table.load(std::memory_order_relaxed);
+    const size_type i = find_index(t, key, hash);
+    if (i != npos) {
+        write_section section(s.version);
+        t->values[i] = mystl::forward<M>(obj);
+        return false;
+    }
+    insert_new(s, prepare_insert(s), hash, key, mystl::forward<M>(obj));
+    return true;
+}
+
+template <class Key, class Type, class Hash, class KeyEqual>
+template <class Func>
+bool concurrent_hash_map<Key, Type, Hash, KeyEqual>::compute(const key_type& key, Func f) {
+    const uint64_t hash = hash_of(key);
+    shard& s = shard_of(hash);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    shard_table* t = s.table.load(std::memory_order_relaxed);
+    const size_type i = find_index(t, key, hash);
+    if (i != npos) {
+        write_section section(s.version);
+        f(t->values[i]);
+        return false;
+    }
+    mapped_type value = mapped_type();
+    f(value);
+    insert_new(s, prepare_insert(s), hash, key, mystl::move(value));
+    return true;
+}
+
+template <class Key, class Type, class Hash, class KeyEqual>
+template <class Func>
+bool concurrent_hash_map<Key, Type, Hash, KeyEqual>::compute_if_present(const key_type& key, Func f) {
+    const uint64_t hash = hash_of(key);
+    shard& s = shard_of(hash);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    shard_table* t = s.table.load(std::memory_order_relaxed);
+    const size_type i = find_index(t, key, hash);
+    if (i == npos) {
+        return false;
+    }
+    write_section section(s.version);
+    f(t->values[i]);
+    return true;
+}
+
+template <class Key, class Type, class Hash, class KeyEqual>
+typename concurrent_hash_map<Key, Type, Hash, KeyEqual>::size_type
+concurrent_hash_map<Key, Type, Hash, KeyEqual>::erase(const key_type& key) {
+    const uint64_t hash = hash_of(key);
+    shard& s = shard_of(hash);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    shard_table* t = s.table.load(std::memory_order_relaxed);
+    const size_type i = find_index(t, key, hash);
+    if (i == npos) {
+        return 0;
+    }
+    write_section section(s.version);
+    erase_at(t, i);
+    s.size.store(s.size.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+    return 1;
+}
+
+// 删除第 i 个槽后向前移动后面的元素，使线性探测不需要墓碑：
+// 后面的元素只要其起始槽不在 (i, j] 之间，就可以移到空出来的 i
+template <class Key, class Type, class Hash, class KeyEqual>
+void concurrent_hash_map<Key, Type, Hash, KeyEqual>::erase_at(shard_table* t, size_type i) {
+    mystl::destroy(t->keys + i);
+    mystl::destroy(t->values + i);
+    size_type j = i;
+    while (true) {
+        j = (j + 1) & t->mask;
+        const unsigned char c = t->ctrl[j].load(std::memory_order_relaxed);
+        if (c == 0) {
+            break;
+        }
+        const size_type home = static_cast<size_type>(hash_of(t->keys[j])) & t->mask;
+        if (((j - home) & t->mask) >= ((j - i) & t->mask)) {
+            mystl::construct(t->keys + i, mystl::move(t->keys[j]));
+            mystl::construct(t->values + i, mystl::move(t->values[j]));
+            mystl::destroy(t->keys + j);
+            mystl::destroy(t->values + j);
+            t->ctrl[i].store(c, std::memory_order_relaxed);
+            i = j;
+        }
+    }
+    t->ctrl[i].store(0, std::memory_order_relaxed);
+}
+
+template <class Key, class Type, class Hash, class KeyEqual>
+void concurrent_hash_map<Key, Type, Hash, KeyEqual>::clear() {
+    for (size_type k = 0; k <= shard_mask_; ++k) {
+        shard& s = shards_[k];
+        std::lock_guard<std::mutex> lock(s.mutex);
+        shard_table* t = s.table.load(std::memory_order_relaxed);
+        if (t == nullptr || s.size.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        write_section section(s.version);
+        for (size_type i = 0; i <= t->mask; ++i) {
+            if (t->ctrl[i].load(std::memory_order_relaxed) != 0) {
+                mystl::destroy(t->keys + i);
+                mystl::destroy(t->values + i);
+                t->ctrl[i].store(0, std::memory_order_relaxed);
+            }
+        }
+        s.size.store(0, std::memory_order_relaxed);
+    }
+}
+
+template <class Key, class Type, class Hash, class KeyEqual>
+void concurrent_hash_map<Key, Type, Hash, KeyEqual>::reserve(size_type count) {
+    const size_type per_shard = count / (shard_mask_ + 1) + 1;
+    size_type cap = ConcurrentHashMinCapacity;
+    while (cap / 4 * 3 < per_shard) {
+        cap <<= 1;
+    }
+    for (size_type k = 0; k <= shard_mask_; ++k) {
+        shard& s = shards_[k];
+        std::lock_guard<std::mutex> lock(s.mutex);
+        const shard_table* t = s.table.load(std::memory_order_relaxed);
+        if (t == nullptr || t->mask + 1 < cap) {
+            rehash_shard(s, cap);
+        }
+    }
+}
+
+template <class Key, class Type, class Hash, class KeyEqual>
+template <class Func>
+void concurrent_hash_map<Key, Type, Hash, KeyEqual>::for_each(Func f) const {
+    for (size_type k = 0; k <= shard_mask_; ++k) {
+        shard& s = shards_[k];
+        std::lock_guard<std::mutex> lock(s.mutex);
+        const shard_table* t = s.table.load(std::memory_order_relaxed);
+        if (t == nullptr) {
+            continue;
+        }
+        for (size_type i = 0; i <= t->mask; ++i) {
+            if (t->ctrl[i].load(std::memory_order_relaxed) != 0) {
+                f(static_cast<const key_type&>(t->keys[i]), static_cast<const mapped_type&>(t->values[i]));
+            }
+        }
+    }
+}
+
+// 控制字节、键、值放在同一块内存中
+template <class Key, class Type, class Hash, class KeyEqual>
+typename concurrent_hash_map<Key, Type, Hash, KeyEqual>::shard_table*
+concurrent_hash_map<Key, Type, Hash, KeyEqual>::allocate_table(size_type cap) {
+    const size_type key_offset = (sizeof(shard_table) + cap + alignof(Key) - 1) / alignof(Key) * alignof(Key);
+    const size_type value_offset =
+        (key_offset + cap * sizeof(Key) + alignof(Type) - 1) / alignof(Type) * alignof(Type);
+    char* raw = static_cast<char*>(::operator new(value_offset + cap * sizeof(Type)));
+    shard_table* t = reinterpret_cast<shard_table*>(raw);
+    t->mask = cap - 1;
+    t->ctrl = reinterpret_cast<std::atomic<unsigned char>*>(raw + sizeof(shard_table));
+    for (size_type i = 0; i < cap; ++i) {
+        new (t->ctrl + i) std::atomic<unsigned char>(0);
+    }
+    t->keys = reinterpret_cast<key_type*>(raw + key_offset);
+    t->values = reinterpret_cast<mapped_type*>(raw + value_offset);
+    t->retired = nullptr;
+    return t;
+}
+
+template <class Key, class Type, class Hash, class KeyEqual>
+void concurrent_hash_map<Key, Type, Hash, KeyEqual>::destroy_table(shard_table* t) noexcept {
+    ::operator delete(t);
+}
+
+// 新表在写区间之外构建，读者在此期间继续读旧表；只有替换指针时才让读者重试
+// 元素的移动构造可能抛出异常时改为复制，失败时旧表保持不变
+template <class Key, class Type, class Hash, class KeyEqual>
+void concurrent_hash_map<Key, Type, Hash, KeyEqual>::rehash_shard(shard& s, size_type cap) {
+    shard_table* old = s.table.load(std::memory_order_relaxed);
+    shard_table* t = allocate_table(cap);
+    size_type built = 0;
+    size_type* slots = nullptr;
+    try {
+        if (old != nullptr) {
+            slots = new size_type[s.size.load(std::memory_order_relaxed) + 1];
+            for (size_type i = 0; i <= old->mask; ++i) {
+                const unsigned char c = old->ctrl[i].load(std::memory_order_relaxed);
+                if (c == 0) {
+                    continue;
+                }
+                size_type j = static_cast<size_type>(hash_of(old->keys[i])) & t->mask;
+                while (t->ctrl[j].load(std::memory_order_relaxed) != 0) {
+                    j = (j + 1) & t->mask;
+                }
+                mystl::construct(t->keys + j, std::move_if_noexcept(old->keys[i]));
+                try {
+                    mystl::construct(t->values + j, std::move_if_noexcept(old->values[i]));
+                }
+                catch (...) {
+                    mystl::destroy(t->keys + j);
+                    throw;
+                }
+                t->ctrl[j].store(c, std::memory_order_relaxed);
+                slots[built++] = j;
+            }
+        }
+    }
+    catch (...) {
+        for (size_type k = 0; k < built; ++k) {
+            mystl::destroy(t->keys + slots[k]);
+            mystl::destroy(t->values + slots[k]);
+        }
+        delete[] slots;
+        destroy_table(t);
+        throw;
+    }
+    delete[] slots;
+
+    {
+        write_section section(s.version);
+        s.table.store(t, std::memory_order_release);
+    }
+    if (old != nullptr) {
+        for (size_type i = 0; i <= old->mask; ++i) {
+            if (old->ctrl[i].load(std::memory_order_relaxed) != 0) {
+                mystl::destroy(old->keys + i);
+                mystl::destroy(old->values + i);
+            }
+        }
+        retire(s, old, optimistic_read());
+    }
+}
+
+}  // end namespace mystl
+
+#endif // MINITURE_STL_CONCURRENT_HASH_MAP_HPP_
@@ -0,0 +1,312 @@
+#ifndef MINITURE_STL_CUCKOO_FILTER_HPP_
+#define MINITURE_STL_CUCKOO_FILTER_HPP_
+
+// 这个头文件包含一个模板类 cuckoo_filter
+// cuckoo_filter : 布谷鸟过滤器，与布隆过滤器一样回答“键可能在集合中”或“键一定不在集合中”，但支持删除
+//
+// 表由 n 个桶组成，每个桶 4 个槽，槽中只存放键的短指纹 (fingerprint)，0 表示空槽。
+// 一个键对应两个候选桶 i1 = reduce(h, n) 与 i2 = (reduce(fp * c, n) - i1) mod n，由指纹与一个桶号就能算出
+// 另一个桶号 (partial-key cuckoo hashing)，所以搬移指纹时不需要原来的键。
+// 用减法而不是异或求另一个桶，n 不必是 2 的幂，表的大小可以按期望的元素个数取得刚好够用。
+// 两个候选桶都满时随机踢出一个指纹放到它的另一个桶中，最多尝试 CuckooMaxKicks 次，
+// 仍然失败时把最后被踢出的指纹放进一个单独的槽 (victim)，此后的插入都返回 false，直到有删除腾出空间。
+// 4 路的桶使表在插入开始失败前能装满约 95% 的槽。
+//
+// 查询只读两个桶，桶内 4 个指纹同时比较；误判率约为 8 / 2^f，f 为指纹的位数。
+// erase 只能删除插入过的键，否则可能删掉另一个键的相同指纹而造成漏判。
+// 同一个键可以插入多次，每次占用一个槽，删除一次去掉一个
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "../00_utils/bitops.h"
+#include "../00_utils/exceptdef.h"
+#include "../00_utils/random.h"
+#include "../01_allocators/allocator.h"
+#include "../01_allocators/util.h"
+#include "../03_algorithms/functional.h"
+
+namespace mystl {
+
+// 每个桶的槽数与搬移的最大次数
+const size_t CuckooBucketSlots = 4;
+const size_t CuckooMaxKicks = 500;
+// 构造时按这个负载率为期望的元素个数预留空间
+const double CuckooTargetLoad = 0.95;
+
+// 模板类 cuckoo_filter
+// 参数一代表键的类型，参数二代表哈希函数，缺省使用 mystl::hash，
+// 参数三代表指纹的类型，必须是不超过 32 位的无符号整数，缺省为 16 位
+template <class Key, class Hash = mystl::hash<Key>, class Fingerprint = uint16_t>
+class cuckoo_filter {
+    static_assert(std::is_unsigned<Fingerprint>::value && sizeof(Fingerprint) <= 4,
+                  "cuckoo_filter's Fingerprint must be an unsigned integer of at most 32 bits");
+
+public:
+    typedef Key             key_type;
+    typedef Hash            hasher;
+    typedef Fingerprint     fingerprint_type;
+    typedef size_t          size_type;
+
+private:
+    typedef mystl::allocator<Fingerprint> slot_allocator;
+
+    // 被踢出后没有位置安放的指纹
+    struct victim_slot {
+        size_type        index;
+        fingerprint_type fp;
+        bool             used;
+    };
+
+    fingerprint_type*   slots_;         // bucket_count_ * 4 个槽
+    size_type           bucket_count_;
+    size_type           size_;
+    victim_slot         victim_;
+    mystl::splitmix64   rng_;           // 选择被踢出的槽
+    hasher              hash_;
+
+public:
+    // 构造、复制、移动、析构函数
+
+    // 为 expected_count 个键预留空间，按负载率 CuckooTargetLoad 取桶数
+    explicit cuckoo_filter(size_type expected_count, const Hash& hash = Hash())
+        : slots_(nullptr), bucket_count_(0), size_(0), rng_(0x2545f4914f6cdd1dull), hash_(hash) {
+        victim_.used = false;
+        allocate_slots(buckets_for(expected_count));
+    }
+
+    cuckoo_filter(const cuckoo_filter& rhs)
+        : slots_(nullptr), bucket_count_(0), size_(rhs.size_), victim_(rhs.victim_), rng_(rhs.rng_), hash_(rhs.hash_) {
+        allocate_slots(rhs.bucket_count_);
+        std::memcpy(slots_, rhs.slots_, slot_count() * sizeof(fingerprint_type));
+    }
+
+    cuckoo_filter(cuckoo_filter&& rhs) noexcept
+        : slots_(rhs.slots_), bucket_count_(rhs.bucket_count_), size_(rhs.size_), victim_(rhs.victim_),
+          rng_(rhs.rng_), hash_(rhs.hash_) {
+        rhs.slots_ = nullptr;
+        rhs.bucket_count_ = 0;
+        rhs.size_ = 0;
+        rhs.victim_.used = false;
+    }
+
+    cuckoo_filter& operator=(const cuckoo_filter& rhs) {
+        if (this != &rhs) {
+            cuckoo_filter temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    cuckoo_filter& operator=(cuckoo_filter&& rhs) noexcept {
+        if (this != &rhs) {
+            cuckoo_filter temp(mystl::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    ~cuckoo_filter() { slot_allocator::deallocate(slots_, slot_count()); }
+
+public:
+    // 插入成功返回 true；表已满（victim 被占用）时返回 false，过滤器不变
+    bool insert(const key_type& key) noexcept(noexcept(hash_(key)));
+
+    // 返回 false 时键一定不在过滤器中
+    bool contains(const key_type& key) const noexcept(noexcept(hash_(key))) {
+        const size_t h = hash_of(key);
+        const fingerprint_type fp = fingerprint(h);
+        const size_type i1 = home_index(h);
+        const size_type i2 = alt_index(i1, fp);
+        return bucket_has(i1, fp) | bucket_has(i2, fp) |
+               (victim_.used && victim_.fp == fp && (victim_.index == i1 || victim_.index == i2));
+    }
+
+    // 删除 key 的一个指纹，找到时返回 true；key 必须插入过
+    bool erase(const key_type& key) noexcept(noexcept(hash_(key)));
+
+    void clear() noexcept {
+        std::memset(slots_, 0, slot_count() * sizeof(fingerprint_type));
+        size_ = 0;
+        victim_.used = false;
+    }
+
+    void swap(cuckoo_filter& rhs) noexcept {
+        mystl::swap(slots_, rhs.slots_);
+        mystl::swap(bucket_count_, rhs.bucket_count_);
+        mystl::swap(size_, rhs.size_);
+        mystl::swap(victim_, rhs.victim_);
+        mystl::swap(rng_, rhs.rng_);
+        mystl::swap(hash_, rhs.hash_);
+    }
+
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    size_type bucket_count() const noexcept { return bucket_count_; }
+    size_type capacity() const noexcept { return slot_count(); }
+    double load_factor() const noexcept { return static_cast<double>(size_) / static_cast<double>(slot_count()); }
+
+    hasher hash_function() const { return hash_; }
+
+private:
+    size_type slot_count() const noexcept { return bucket_count_ * CuckooBucketSlots; }
+
+    static size_type buckets_for(size_type expected_count) {
+        const double want = std::ceil(static_cast<double>(expected_count) / (CuckooTargetLoad * CuckooBucketSlots));
+        THROW_LENGTH_ERROR_IF(want > static_cast<double>(static_cast<size_type>(-1) / (4 * CuckooBucketSlots)),
+                              "cuckoo_filter<Key>'s size too big");
+        return want < 1.0 ? 1 : static_cast<size_type>(want);
+    }
+
+    // 把 x 均匀地映射到 [0, bucket_count_)，用乘法的高 64 位代替取模
+    size_type reduce(uint64_t x) const noexcept {
+        uint64_t hi;
+        mystl::mul64x64_128(x, static_cast<uint64_t>(bucket_count_), &hi);
+        return static_cast<size_type>(hi);
+    }
+
+    void allocate_slots(size_type buckets) {
+        slots_ = slot_allocator::allocate(buckets * CuckooBucketSlots);
+        bucket_count_ = buckets;
+        std::memset(slots_, 0, slot_count() * sizeof(fingerprint_type));
+    }
+
+    size_t hash_of(const key_type& key) const noexcept(noexcept(hash_(key))) {
+        return mix(hash_(key), is_avalanching_hash<Hash>());
+    }
+
+    static size_t mix(size_t h, std::true_type) noexcept { return h; }
+    static size_t mix(size_t h, std::false_type) noexcept { return mystl::hash_mix(h); }
+
+    // 桶号由哈希值的高位决定，指纹取低位，两者不相关；0 留给空槽
+    size_type home_index(size_t h) const noexcept { return reduce(static_cast<uint64_t>(h)); }
+
+    static fingerprint_type fingerprint(size_t h) noexcept {
+        const fingerprint_type fp = static_cast<fingerprint_type>(h);
+        return fp != 0 ? fp : static_cast<fingerprint_type>(1);
+    }
+
+    // 另一个候选桶，对同一个 fp 是对合：alt_index(alt_index(i, fp), fp) == i
+    size_type alt_index(size_type i, fingerprint_type fp) const noexcept {
+        const size_type f = reduce(static_cast<uint64_t>(fp) * 0xc6a4a7935bd1e995ull);
+        // f < i 时回绕，用掩码代替分支，两种情况各占一半，分支无法预测
+        return f - i + (bucket_count_ & (static_cast<size_type>(0) - static_cast<size_type>(f < i)));
+    }
+
+    // 4 个槽一起比较，不提前退出
+    // 8 位与 16 位的指纹把整个桶读成一个整数，按 SWAR 的方法检查是否有与 fp 相等的槽
+    bool bucket_has(size_type i, fingerprint_type fp) const noexcept {
+        return bucket_has(slots_ + i * CuckooBucketSlots, fp,
+                          std::integral_constant<bool, sizeof(fingerprint_type) <= 2>());
+    }
+
+    static bool bucket_has(const fingerprint_type* b, fingerprint_type fp, std::true_type) noexcept {
+        typedef typename std::conditional<sizeof(fingerprint_type) == 1, uint32_t, uint64_t>::type word_type;
+        const word_type ones = static_cast<word_type>(-1) / static_cast<fingerprint_type>(-1);
+        const word_type highs = ones << (8 * sizeof(fingerprint_type) - 1);
+        word_type w;
+        std::memcpy(&w, b, sizeof(w));
+        // x 的某个槽为 0 当且仅当该槽等于 fp
+        const word_type x = w ^ (ones * fp);
+        return ((x - ones) & ~x & highs) != 0;
+    }
+
+    static bool bucket_has(const fingerprint_type* b, fingerprint_type fp, std::false_type) noexcept {
+        return (b[0] == fp) | (b[1] == fp) | (b[2] == fp) | (b[3] == fp);
+    }
+
+    // 在桶 i 的空槽中放入 fp，没有空槽时返回 false
+    bool bucket_put(size_type i, fingerprint_type fp) noexcept {
+        fingerprint_type* b = slots_ + i * CuckooBucketSlots;
+        for (size_type s = 0; s < CuckooBucketSlots; ++s) {
+            if (b[s] == 0) {
+                b[s] = fp;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool bucket_remove(size_type i, fingerprint_type fp) noexcept {
+        fingerprint_type* b = slots_ + i * CuckooBucketSlots;
+        for (size_type s = 0; s < CuckooBucketSlots; ++s) {
+            if (b[s] == fp) {
+                b[s] = 0;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void place(size_type i, fingerprint_type fp) noexcept;
+};
+
+/*****************************************************************************************/
+
+template <class Key, class Hash, class Fingerprint>
+bool cuckoo_filter<Key, Hash, Fingerprint>::insert(const key_type& key) noexcept(noexcept(hash_(key))) {
+    if (victim_.used) {
+        return false;
+    }
+    const size_t h = hash_of(key);
+    place(home_index(h), fingerprint(h));
+    ++size_;
+    return true;
+}
+
+// 把 fp 放进桶 i 或它的另一个桶，都满时踢出指纹并沿路搬移，最后仍无处安放的指纹存入 victim_
+template <class Key, class Hash, class Fingerprint>
+void cuckoo_filter<Key, Hash, Fingerprint>::place(size_type i, fingerprint_type fp) noexcept {
+    size_type alt = alt_index(i, fp);
+    if (bucket_put(i, fp) || bucket_put(alt, fp)) {
+        return;
+    }
+    i = (rng_() & 1) ? i : alt;
+    for (size_type kick = 0; kick < CuckooMaxKicks; ++kick) {
+        const size_type s = static_cast<size_type>(rng_() & (CuckooBucketSlots - 1));
+        mystl::swap(fp, slots_[i * CuckooBucketSlots + s]);
+        i = alt_index(i, fp);
+        if (bucket_put(i, fp)) {
+            return;
+        }
+    }
+    victim_.index = i;
+    victim_.fp = fp;
+    victim_.used = true;
+}
+
+template <class Key, class Hash, class Fingerprint>
+bool cuckoo_filter<Key, Hash, Fingerprint>::erase(const key_type& key) noexcept(noexcept(hash_(key))) {
+    const size_t h = hash_of(key);
+    const fingerprint_type fp = fingerprint(h);
+    const size_type i1 = home_index(h);
+    const size_type i2 = alt_index(i1, fp);
+    if (bucket_remove(i1, fp) || bucket_remove(i2, fp)) {
+        --size_;
+        // 腾出了一个槽，把 victim 重新放回表中
+        if (victim_.used) {
+            victim_.used = false;
+            place(victim_.index, victim_.fp);
+        }
+        return true;
+    }
+    if (victim_.used && victim_.fp == fp && (victim_.index == i1 || victim_.index == i2)) {
+        victim_.used = false;
+        --size_;
+        return true;
+    }
+    return false;
+}
+
+// 重载 mystl 的 swap
+template <class Key, class Hash, class Fingerprint>
+void swap(cuckoo_filter<Key, Hash, Fingerprint>& lhs, cuckoo_filter<Key, Hash, Fingerprint>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // end namespace mystl
+
+#endif // MINITURE_STL_CUCKOO_FILTER_HPP_
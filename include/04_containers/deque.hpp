@@ -46,14 +46,8 @@ struct deque_iterator : public iterator<mystl::random_access_iterator_tag, Type>
     // 构造、复制、移动函数
     deque_iterator() : cur(nullptr), first(nullptr), last(nullptr), node(nullptr) {}
     deque_iterator(value_pointer v, map_pointer n) : cur(v), first(*n), last(*n + buffer_size), node(n) {}
-    deque_iterator(iterator& rhs) : cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node) {}
-    deque_iterator(const_iterator& rhs) : cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node) {}
-    deque_iterator(iterator&& rhs) : cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node) {
-        rhs.cur = nullptr;
-        rhs.first = nullptr;
-        rhs.last = nullptr;
-        rhs.node = nullptr;
-    }
+    // self 为 iterator 时是复制构造函数，为 const_iterator 时允许由 iterator 转换
+    deque_iterator(const iterator& rhs) : cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node) {}
 
     // 转到另一个缓冲区
     void set_node(map_pointer new_node) {
@@ -87,7 +81,7 @@ struct deque_iterator : public iterator<mystl::random_access_iterator_tag, Type>
         return *this;
     }
 
-    self&           operator++(int) {
+    self            operator++(int) {
         self tmp = *this;
         ++*this;
         return tmp;
@@ -98,11 +92,11 @@ struct deque_iterator : public iterator<mystl::random_access_iterator_tag, Type>
             set_node(node - 1);
             cur = last;
         }
-        cur--;
-        return cur;
+        --cur;
+        return *this;
     }
 
-    self&           operator--(int) {
+    self            operator--(int) {
         self tmp = *this;
         --*this;
         return tmp;
@@ -123,7 +117,7 @@ struct deque_iterator : public iterator<mystl::random_access_iterator_tag, Type>
         return *this;
     }
 
-    self&           operator+(difference_type n) const {
+    self            operator+(difference_type n) const {
         self tmp = *this;
         return tmp += n;
     }
@@ -132,7 +126,7 @@ struct deque_iterator : public iterator<mystl::random_access_iterator_tag, Type>
         return *this += -n;
     }
 
-    self&           operator-=(difference_type n) const {
+    self            operator-(difference_type n) const {
         self tmp = *this;
         return tmp -= n;
     }
@@ -152,6 +146,23 @@ struct deque_iterator : public iterator<mystl::random_access_iterator_tag, Type>
     bool operator>=(const self& rhs) const {return !(rhs > *this);}
 };
 
+// deque 的迭代器是分段迭代器：每个缓冲区是一段连续内存，map 中的节点指针用作段迭代器
+template <class Type, class Ref, class Ptr>
+struct segmented_iterator_traits<deque_iterator<Type, Ref, Ptr>> {
+    typedef std::true_type                                  is_segmented_iterator;
+    typedef deque_iterator<Type, Ref, Ptr>                  iterator;
+    typedef typename iterator::map_pointer                  segment_iterator;
+    typedef Ptr                                             local_iterator;
+
+    static segment_iterator segment(const iterator& it) {return it.node;}
+    static local_iterator   local(const iterator& it) {return it.cur;}
+    static local_iterator   begin(segment_iterator seg) {return *seg;}
+    static local_iterator   end(segment_iterator seg) {return *seg + iterator::buffer_size;}
+    static iterator         compose(segment_iterator seg, local_iterator pos) {
+        return iterator(const_cast<Type*>(pos), seg);
+    }
+};
+
 // 模板类 deque
 // 模板参数代表数据类型
 template <class Type>
@@ -191,4 +202,3 @@ private:
 
 
 #endif // MINITURE_STL_DEQUE_HPP_
-#define MINITURE_STL_DEQUE_HPP_end MINITURE_STL_DEQUE_HPP_
@@ -0,0 +1,242 @@
+#ifndef MINITURE_STL_FLAT_HASH_MAP_HPP_
+#define MINITURE_STL_FLAT_HASH_MAP_HPP_
+
+// 这个头文件包含了一个模板类 flat_hash_map
+// flat_hash_map: 开放定址的哈希映射，底层为 flat_hash_table，元素直接存放在槽数组中
+//
+// 接口与 unordered_map 相近，不同之处：
+//   插入可能引起重建，重建后所有迭代器、指针与引用都失效
+//   没有桶接口，最大负载因子固定为 7/8
+//   Hash 与 KeyEqual 都定义了 is_transparent 时，find / count / contains / erase 接受可以与键比较的任意类型
+
+#include <initializer_list>
+
+#include "flat_hash_table.hpp"
+
+namespace mystl {
+
+// 模板类 flat_hash_map
+// 参数依次为键类型、映射值类型、哈希函数（缺省使用 mystl::mixed_hash）、键的比较函数（缺省使用 mystl::equal_to）
+template <class Key, class Type, class Hash = mystl::mixed_hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+class flat_hash_map {
+private:
+    typedef flat_hash_table<mystl::pair<const Key, Type>, Key,
+                            mystl::selectfirst<mystl::pair<const Key, Type>>, Hash, KeyEqual> base_type;
+
+    base_type ht_;
+
+    template <class K>
+    using key_arg = typename flat_hash_key_arg<flat_hash_is_transparent<Hash, KeyEqual>::value>::template type<K, Key>;
+
+public:
+    typedef typename base_type::allocator_type      allocator_type;
+    typedef typename base_type::key_type            key_type;
+    typedef Type                                    mapped_type;
+    typedef typename base_type::value_type          value_type;
+    typedef typename base_type::hasher              hasher;
+    typedef typename base_type::key_equal           key_equal;
+
+    typedef typename base_type::size_type           size_type;
+    typedef typename base_type::difference_type     difference_type;
+    typedef typename base_type::pointer             pointer;
+    typedef typename base_type::const_pointer       const_pointer;
+    typedef typename base_type::reference           reference;
+    typedef typename base_type::const_reference     const_reference;
+
+    typedef typename base_type::iterator            iterator;
+    typedef typename base_type::const_iterator      const_iterator;
+
+    allocator_type get_allocator() const { return ht_.get_allocator(); }
+
+public:
+    // 构造、复制、移动函数
+    flat_hash_map() : ht_() {}
+
+    explicit flat_hash_map(size_type bucket_count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : ht_(bucket_count, hash, equal) {}
+
+    template <class InputIter, typename std::enable_if<mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+    flat_hash_map(InputIter first, InputIter last, size_type bucket_count = 0,
+                  const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : ht_(bucket_count, hash, equal) {
+        insert(first, last);
+    }
+
+    flat_hash_map(std::initializer_list<value_type> ilist, size_type bucket_count = 0,
+                  const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    flat_hash_map(const flat_hash_map& rhs) : ht_(rhs.ht_) {}
+    flat_hash_map(flat_hash_map&& rhs) noexcept : ht_(mystl::move(rhs.ht_)) {}
+
+    flat_hash_map& operator=(const flat_hash_map& rhs) {
+        ht_ = rhs.ht_;
+        return *this;
+    }
+
+    flat_hash_map& operator=(flat_hash_map&& rhs) noexcept {
+        ht_ = mystl::move(rhs.ht_);
+        return *this;
+    }
+
+    flat_hash_map& operator=(std::initializer_list<value_type> ilist) {
+        ht_.clear();
+        ht_.reserve(ilist.size());
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~flat_hash_map() = default;
+
+    // 迭代器相关操作
+    iterator begin() noexcept { return ht_.begin(); }
+    const_iterator begin() const noexcept { return ht_.begin(); }
+    iterator end() noexcept { return ht_.end(); }
+    const_iterator end() const noexcept { return ht_.end(); }
+
+    const_iterator cbegin() const noexcept { return ht_.cbegin(); }
+    const_iterator cend() const noexcept { return ht_.cend(); }
+
+    // 容量相关操作
+    bool      empty() const noexcept { return ht_.empty(); }
+    size_type size() const noexcept { return ht_.size(); }
+    size_type max_size() const noexcept { return ht_.max_size(); }
+
+    // 修改容器相关操作
+    template <class... Args>
+    mystl::pair<iterator, bool> emplace(Args&&... args) {
+        return ht_.emplace(mystl::forward<Args>(args)...);
+    }
+
+    mystl::pair<iterator, bool> insert(const value_type& value) { return ht_.insert(value); }
+    mystl::pair<iterator, bool> insert(value_type&& value) { return ht_.insert(mystl::move(value)); }
+
+    template <class InputIter>
+    void insert(InputIter first, InputIter last) { ht_.insert(first, last); }
+
+    void insert(std::initializer_list<value_type> ilist) { ht_.insert(ilist.begin(), ilist.end()); }
+
+    // 键不存在时才构造映射值
+    template <class... Args>
+    mystl::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        return ht_.try_emplace_key(key, key, mystl::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    mystl::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return ht_.try_emplace_key(key, mystl::move(key), mystl::forward<Args>(args)...);
+    }
+
+    template <class M>
+    mystl::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+        mystl::pair<iterator, bool> result = ht_.emplace_key(key, key, mystl::forward<M>(obj));
+        if (!result.second) {
+            result.first->second = mystl::forward<M>(obj);
+        }
+        return result;
+    }
+
+    template <class M>
+    mystl::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+        mystl::pair<iterator, bool> result = ht_.emplace_key(key, mystl::move(key), mystl::forward<M>(obj));
+        if (!result.second) {
+            result.first->second = mystl::forward<M>(obj);
+        }
+        return result;
+    }
+
+    iterator erase(const_iterator pos) { return ht_.erase(pos); }
+    iterator erase(const_iterator first, const_iterator last) { return ht_.erase(first, last); }
+
+    // 异构查找时 K 由参数推导，排除迭代器，以免与上面按位置删除的版本混淆
+    template <class K = key_type, typename std::enable_if<!std::is_convertible<K, const_iterator>::value, int>::type = 0>
+    size_type erase(const key_arg<K>& key) {
+        return ht_.template erase<K>(key);
+    }
+
+    void clear() { ht_.clear(); }
+
+    void swap(flat_hash_map& rhs) noexcept { ht_.swap(rhs.ht_); }
+
+    // 查找相关操作
+    mapped_type& at(const key_type& key) {
+        iterator it = ht_.find(key);
+        THROW_OUT_OF_RANGE_IF(it == ht_.end(), "flat_hash_map<Key, T> no such element exists");
+        return it->second;
+    }
+
+    const mapped_type& at(const key_type& key) const {
+        const_iterator it = ht_.find(key);
+        THROW_OUT_OF_RANGE_IF(it == ht_.end(), "flat_hash_map<Key, T> no such element exists");
+        return it->second;
+    }
+
+    mapped_type& operator[](const key_type& key) {
+        return ht_.try_emplace_key(key, key).first->second;
+    }
+
+    mapped_type& operator[](key_type&& key) {
+        return ht_.try_emplace_key(key, mystl::move(key)).first->second;
+    }
+
+    template <class K = key_type>
+    iterator find(const key_arg<K>& key) {
+        return ht_.template find<K>(key);
+    }
+
+    template <class K = key_type>
+    const_iterator find(const key_arg<K>& key) const {
+        return ht_.template find<K>(key);
+    }
+
+    template <class K = key_type>
+    size_type count(const key_arg<K>& key) const {
+        return ht_.template count<K>(key);
+    }
+
+    template <class K = key_type>
+    bool contains(const key_arg<K>& key) const {
+        return ht_.template contains<K>(key);
+    }
+
+    // 哈希策略
+    size_type bucket_count() const noexcept { return ht_.bucket_count(); }
+    float load_factor() const noexcept { return ht_.load_factor(); }
+    float max_load_factor() const noexcept { return ht_.max_load_factor(); }
+
+    void rehash(size_type count) { ht_.rehash(count); }
+    void reserve(size_type count) { ht_.reserve(count); }
+
+    hasher hash_function() const { return ht_.hash_function(); }
+    key_equal key_eq() const { return ht_.key_eq(); }
+
+public:
+    friend bool operator==(const flat_hash_map& lhs, const flat_hash_map& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        for (const_iterator it = lhs.begin(); it != lhs.end(); ++it) {
+            const_iterator other = rhs.ht_.find(it->first);
+            if (other == rhs.end() || !(other->second == it->second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(const flat_hash_map& lhs, const flat_hash_map& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+// 重载 mystl 的 swap
+template <class Key, class Type, class Hash, class KeyEqual>
+void swap(flat_hash_map<Key, Type, Hash, KeyEqual>& lhs, flat_hash_map<Key, Type, Hash, KeyEqual>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // end namespace mystl
+
+#endif // MINITURE_STL_FLAT_HASH_MAP_HPP_
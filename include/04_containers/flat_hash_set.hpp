@@ -0,0 +1,190 @@
+#ifndef MINITURE_STL_FLAT_HASH_SET_HPP_
+#define MINITURE_STL_FLAT_HASH_SET_HPP_
+
+// 这个头文件包含了一个模板类 flat_hash_set
+// flat_hash_set: 开放定址的哈希集合，底层为 flat_hash_table，元素直接存放在槽数组中
+//
+// 接口与 unordered_set 相近，不同之处与 flat_hash_map 相同：
+// 插入可能使所有迭代器失效，没有桶接口，最大负载因子固定为 7/8，支持异构查找
+
+#include <initializer_list>
+
+#include "flat_hash_table.hpp"
+
+namespace mystl {
+
+// 模板类 flat_hash_set
+// 参数依次为键类型、哈希函数（缺省使用 mystl::mixed_hash）、键的比较函数（缺省使用 mystl::equal_to）
+template <class Key, class Hash = mystl::mixed_hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+class flat_hash_set {
+private:
+    typedef flat_hash_table<Key, Key, mystl::identity<Key>, Hash, KeyEqual> base_type;
+
+    base_type ht_;
+
+    template <class K>
+    using key_arg = typename flat_hash_key_arg<flat_hash_is_transparent<Hash, KeyEqual>::value>::template type<K, Key>;
+
+public:
+    typedef typename base_type::allocator_type      allocator_type;
+    typedef typename base_type::key_type            key_type;
+    typedef typename base_type::value_type          value_type;
+    typedef typename base_type::hasher              hasher;
+    typedef typename base_type::key_equal           key_equal;
+
+    typedef typename base_type::size_type           size_type;
+    typedef typename base_type::difference_type     difference_type;
+    typedef typename base_type::const_pointer       pointer;
+    typedef typename base_type::const_pointer       const_pointer;
+    typedef typename base_type::const_reference     reference;
+    typedef typename base_type::const_reference     const_reference;
+
+    // 元素就是键，不允许通过迭代器修改
+    typedef typename base_type::const_iterator      iterator;
+    typedef typename base_type::const_iterator      const_iterator;
+
+    allocator_type get_allocator() const { return ht_.get_allocator(); }
+
+public:
+    // 构造、复制、移动函数
+    flat_hash_set() : ht_() {}
+
+    explicit flat_hash_set(size_type bucket_count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : ht_(bucket_count, hash, equal) {}
+
+    template <class InputIter, typename std::enable_if<mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+    flat_hash_set(InputIter first, InputIter last, size_type bucket_count = 0,
+                  const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : ht_(bucket_count, hash, equal) {
+        insert(first, last);
+    }
+
+    flat_hash_set(std::initializer_list<value_type> ilist, size_type bucket_count = 0,
+                  const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    flat_hash_set(const flat_hash_set& rhs) : ht_(rhs.ht_) {}
+    flat_hash_set(flat_hash_set&& rhs) noexcept : ht_(mystl::move(rhs.ht_)) {}
+
+    flat_hash_set& operator=(const flat_hash_set& rhs) {
+        ht_ = rhs.ht_;
+        return *this;
+    }
+
+    flat_hash_set& operator=(flat_hash_set&& rhs) noexcept {
+        ht_ = mystl::move(rhs.ht_);
+        return *this;
+    }
+
+    flat_hash_set& operator=(std::initializer_list<value_type> ilist) {
+        ht_.clear();
+        ht_.reserve(ilist.size());
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~flat_hash_set() = default;
+
+    // 迭代器相关操作
+    const_iterator begin() const noexcept { return ht_.begin(); }
+    const_iterator end() const noexcept { return ht_.end(); }
+
+    const_iterator cbegin() const noexcept { return ht_.cbegin(); }
+    const_iterator cend() const noexcept { return ht_.cend(); }
+
+    // 容量相关操作
+    bool      empty() const noexcept { return ht_.empty(); }
+    size_type size() const noexcept { return ht_.size(); }
+    size_type max_size() const noexcept { return ht_.max_size(); }
+
+    // 修改容器相关操作
+    template <class... Args>
+    mystl::pair<iterator, bool> emplace(Args&&... args) {
+        const auto result = ht_.emplace(mystl::forward<Args>(args)...);
+        return mystl::pair<iterator, bool>(result.first, result.second);
+    }
+
+    mystl::pair<iterator, bool> insert(const value_type& value) {
+        const auto result = ht_.insert(value);
+        return mystl::pair<iterator, bool>(result.first, result.second);
+    }
+
+    mystl::pair<iterator, bool> insert(value_type&& value) {
+        const auto result = ht_.insert(mystl::move(value));
+        return mystl::pair<iterator, bool>(result.first, result.second);
+    }
+
+    template <class InputIter>
+    void insert(InputIter first, InputIter last) { ht_.insert(first, last); }
+
+    void insert(std::initializer_list<value_type> ilist) { ht_.insert(ilist.begin(), ilist.end()); }
+
+    iterator erase(const_iterator pos) { return ht_.erase(pos); }
+    iterator erase(const_iterator first, const_iterator last) { return ht_.erase(first, last); }
+
+    // 异构查找时 K 由参数推导，排除迭代器，以免与上面按位置删除的版本混淆
+    template <class K = key_type, typename std::enable_if<!std::is_convertible<K, const_iterator>::value, int>::type = 0>
+    size_type erase(const key_arg<K>& key) {
+        return ht_.template erase<K>(key);
+    }
+
+    void clear() { ht_.clear(); }
+
+    void swap(flat_hash_set& rhs) noexcept { ht_.swap(rhs.ht_); }
+
+    // 查找相关操作
+    template <class K = key_type>
+    const_iterator find(const key_arg<K>& key) const {
+        return ht_.template find<K>(key);
+    }
+
+    template <class K = key_type>
+    size_type count(const key_arg<K>& key) const {
+        return ht_.template count<K>(key);
+    }
+
+    template <class K = key_type>
+    bool contains(const key_arg<K>& key) const {
+        return ht_.template contains<K>(key);
+    }
+
+    // 哈希策略
+    size_type bucket_count() const noexcept { return ht_.bucket_count(); }
+    float load_factor() const noexcept { return ht_.load_factor(); }
+    float max_load_factor() const noexcept { return ht_.max_load_factor(); }
+
+    void rehash(size_type count) { ht_.rehash(count); }
+    void reserve(size_type count) { ht_.reserve(count); }
+
+    hasher hash_function() const { return ht_.hash_function(); }
+    key_equal key_eq() const { return ht_.key_eq(); }
+
+public:
+    friend bool operator==(const flat_hash_set& lhs, const flat_hash_set& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        for (const_iterator it = lhs.begin(); it != lhs.end(); ++it) {
+            if (!rhs.contains(*it)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(const flat_hash_set& lhs, const flat_hash_set& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+// 重载 mystl 的 swap
+template <class Key, class Hash, class KeyEqual>
+void swap(flat_hash_set<Key, Hash, KeyEqual>& lhs, flat_hash_set<Key, Hash, KeyEqual>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // end namespace mystl
+
+#endif // MINITURE_STL_FLAT_HASH_SET_HPP_
@@ -0,0 +1,750 @@
+#ifndef MINITURE_STL_FLAT_HASH_TABLE_HPP_
+#define MINITURE_STL_FLAT_HASH_TABLE_HPP_
+
+// 这个头文件包含了一个模板类 flat_hash_table，是 flat_hash_map 与 flat_hash_set 的底层实现
+// flat_hash_table: 开放定址的哈希表（Swiss table）
+//
+// 元素直接存放在槽数组中，每个槽另有一个控制字节：空槽为 0x80，删除后留下的墓碑为 0xFE，
+// 数组末尾的哨兵为 0xFF，存有元素的槽保存哈希值的低 7 位 (H2)，最高位为 0。
+// 哈希值的其余位 (H1) 决定探测的起点。查找时一次读入 16 个控制字节，用 SSE2 找出与 H2 相同的槽，
+// 只对这些槽比较键，其他槽的元素不会被访问；这一组中出现空槽就说明键不存在。每个元素只多占一个字节
+//
+// 容量总是 2^k - 1，探测以组为单位按三角数序列前进，能够遍历所有的槽。控制字节数组的哨兵之后
+// 复制了开头的 15 个字节，从任意槽开始读 16 个字节都不会越界，也不必处理回绕
+// 元素个数最多为容量的 7/8。删除元素时，若没有探测序列会越过这个槽，直接标记为空，否则留下墓碑；
+// 插入时没有剩余空间，墓碑较多就按原容量重建，否则容量翻倍
+// 重建或扩容后所有迭代器、指针与引用都失效
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include "../00_utils/bitops.h"
+#include "../00_utils/exceptdef.h"
+#include "../01_allocators/memory.h"
+#include "../01_allocators/util.h"
+#include "../02_iterators/iterator.h"
+#include "../03_algorithms/algobase.h"
+#include "../03_algorithms/functional.h"
+#include "../03_algorithms/simd_algo.h"
+
+namespace mystl {
+
+// 控制字节
+typedef signed char flat_hash_ctrl;
+
+const flat_hash_ctrl FlatHashEmpty    = -128;
+const flat_hash_ctrl FlatHashDeleted  = -2;
+const flat_hash_ctrl FlatHashSentinel = -1;
+
+// 一次探测读入的控制字节数
+const size_t FlatHashGroupWidth = 16;
+
+// 非空表的最小容量
+const size_t FlatHashMinCapacity = 15;
+
+// 空表共用的控制字节：一个哨兵之后全是空槽，查找立即结束，begin() 等于 end()
+inline flat_hash_ctrl* flat_hash_empty_group() {
+    alignas(16) static flat_hash_ctrl group[FlatHashGroupWidth] = {
+        FlatHashSentinel, FlatHashEmpty, FlatHashEmpty, FlatHashEmpty,
+        FlatHashEmpty,    FlatHashEmpty, FlatHashEmpty, FlatHashEmpty,
+        FlatHashEmpty,    FlatHashEmpty, FlatHashEmpty, FlatHashEmpty,
+        FlatHashEmpty,    FlatHashEmpty, FlatHashEmpty, FlatHashEmpty};
+    return group;
+}
+
+// 一组 16 个控制字节，match 系列函数返回掩码，第 i 位对应第 i 个槽
+struct flat_hash_group {
+#if MYSTL_HAS_SSE2
+    __m128i ctrl;
+
+    explicit flat_hash_group(const flat_hash_ctrl* pos)
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+    uint32_t match(flat_hash_ctrl h2) const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+    }
+
+    uint32_t match_empty() const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(FlatHashEmpty), ctrl)));
+    }
+
+    // 空槽与墓碑都小于哨兵
+    uint32_t match_empty_or_deleted() const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(FlatHashSentinel), ctrl)));
+    }
+#else
+    flat_hash_ctrl ctrl[FlatHashGroupWidth];
+
+    explicit flat_hash_group(const flat_hash_ctrl* pos) {
+        std::memcpy(ctrl, pos, FlatHashGroupWidth);
+    }
+
+    uint32_t match(flat_hash_ctrl h2) const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < FlatHashGroupWidth; ++i) {
+            mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+        }
+        return mask;
+    }
+
+    uint32_t match_empty() const {
+        return match(FlatHashEmpty);
+    }
+
+    uint32_t match_empty_or_deleted() const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < FlatHashGroupWidth; ++i) {
+            mask |= static_cast<uint32_t>(ctrl[i] < FlatHashSentinel) << i;
+        }
+        return mask;
+    }
+#endif
+
+    // 从第 0 个槽起连续的空槽与墓碑的个数
+    size_t count_leading_empty_or_deleted() const {
+        return static_cast<size_t>(mystl::countr_one64(match_empty_or_deleted()));
+    }
+};
+
+// 判断哈希函数与比较函数是否都支持异构查找
+template <class... Types>
+struct flat_hash_void {
+    typedef void type;
+};
+
+template <class Hash, class KeyEqual, class = void>
+struct flat_hash_is_transparent : public std::false_type {};
+
+template <class Hash, class KeyEqual>
+struct flat_hash_is_transparent<Hash, KeyEqual,
+    typename flat_hash_void<typename Hash::is_transparent, typename KeyEqual::is_transparent>::type>
+    : public std::true_type {};
+
+// 查找函数的参数类型：支持异构查找时为 K，否则总是 Key。
+// 前一种情况下 K 可以由参数推导，后一种情况下 K 不参与推导，取缺省的 Key，其他类型的参数先转换为 Key
+template <bool Transparent>
+struct flat_hash_key_arg {
+    template <class K, class Key>
+    using type = Key;
+};
+
+template <>
+struct flat_hash_key_arg<true> {
+    template <class K, class Key>
+    using type = K;
+};
+
+// flat_hash_table 的迭代器设计
+template <class Value, class Ref, class Ptr>
+struct flat_hash_iterator : public iterator<mystl::forward_iterator_tag, Value> {
+    typedef flat_hash_iterator<Value, Value&, Value*>               iterator;
+    typedef flat_hash_iterator<Value, const Value&, const Value*>   const_iterator;
+    typedef flat_hash_iterator                                      self;
+
+    typedef Value           value_type;
+    typedef Ptr             pointer;
+    typedef Ref             reference;
+    typedef size_t          size_type;
+    typedef ptrdiff_t       difference_type;
+
+    const flat_hash_ctrl*   ctrl;   // 当前槽的控制字节，end() 指向哨兵
+    Value*                  slot;   // 当前槽
+
+    flat_hash_iterator() noexcept : ctrl(nullptr), slot(nullptr) {}
+    flat_hash_iterator(const flat_hash_ctrl* c, Value* s) noexcept : ctrl(c), slot(s) {}
+    flat_hash_iterator(const iterator& rhs) noexcept : ctrl(rhs.ctrl), slot(rhs.slot) {}
+
+    self& operator=(const iterator& rhs) noexcept {
+        ctrl = rhs.ctrl;
+        slot = rhs.slot;
+        return *this;
+    }
+
+    reference operator*() const { return *slot; }
+    pointer operator->() const { return slot; }
+
+    self& operator++() {
+        ++ctrl;
+        ++slot;
+        skip_empty_or_deleted();
+        return *this;
+    }
+
+    self operator++(int) {
+        self temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    // 按组跳过空槽与墓碑，停在下一个元素或哨兵上
+    void skip_empty_or_deleted() {
+        while (*ctrl < FlatHashSentinel) {
+            const size_t shift = flat_hash_group(ctrl).count_leading_empty_or_deleted();
+            ctrl += shift;
+            slot += shift;
+        }
+    }
+
+    bool operator==(const self& rhs) const { return ctrl == rhs.ctrl; }
+    bool operator!=(const self& rhs) const { return ctrl != rhs.ctrl; }
+};
+
+// 模板类 flat_hash_table
+// 参数依次为元素类型、键类型、从元素取出键的函数对象、哈希函数、键的比较函数
+// Hash 的结果不是 is_avalanching_hash 时，表内先用 hash_mix 混合再拆分 H1 与 H2
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+class flat_hash_table {
+public:
+    typedef Value                                                   value_type;
+    typedef Key                                                     key_type;
+    typedef Hash                                                    hasher;
+    typedef KeyEqual                                                key_equal;
+
+    typedef mystl::allocator<Value>                                 allocator_type;
+    typedef Value*                                                  pointer;
+    typedef const Value*                                            const_pointer;
+    typedef Value&                                                  reference;
+    typedef const Value&                                            const_reference;
+    typedef size_t                                                  size_type;
+    typedef ptrdiff_t                                               difference_type;
+
+    typedef flat_hash_iterator<Value, Value&, Value*>               iterator;
+    typedef flat_hash_iterator<Value, const Value&, const Value*>   const_iterator;
+
+    allocator_type get_allocator() const { return allocator_type(); }
+
+    static_assert(alignof(Value) <= alignof(std::max_align_t), "flat_hash_table does not support over-aligned types");
+
+private:
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    flat_hash_ctrl* ctrl_;          // 控制字节，共 capacity_ + FlatHashGroupWidth 个
+    value_type*     slots_;         // 槽数组，与控制字节在同一块内存中
+    size_type       size_;
+    size_type       capacity_;      // 槽数，为 0 或 2^k - 1
+    size_type       growth_left_;   // 不必重建就能再占用的空槽数
+    hasher          hash_;
+    key_equal       equal_;
+
+    template <class K>
+    using key_arg = typename flat_hash_key_arg<flat_hash_is_transparent<Hash, KeyEqual>::value>::template type<K, key_type>;
+
+public:
+    // 构造、复制、移动、析构函数
+    flat_hash_table() noexcept(std::is_nothrow_default_constructible<Hash>::value &&
+                               std::is_nothrow_default_constructible<KeyEqual>::value)
+        : ctrl_(flat_hash_empty_group()), slots_(nullptr), size_(0), capacity_(0), growth_left_(0),
+          hash_(), equal_() {}
+
+    explicit flat_hash_table(size_type bucket_count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : ctrl_(flat_hash_empty_group()), slots_(nullptr), size_(0), capacity_(0), growth_left_(0),
+          hash_(hash), equal_(equal) {
+        if (bucket_count != 0) {
+            initialize_slots(normalize_capacity(bucket_count));
+        }
+    }
+
+    flat_hash_table(const flat_hash_table& rhs);
+
+    flat_hash_table(flat_hash_table&& rhs) noexcept
+        : ctrl_(rhs.ctrl_), slots_(rhs.slots_), size_(rhs.size_), capacity_(rhs.capacity_),
+          growth_left_(rhs.growth_left_), hash_(rhs.hash_), equal_(rhs.equal_) {
+        rhs.reset_empty();
+    }
+
+    flat_hash_table& operator=(const flat_hash_table& rhs) {
+        if (this != &rhs) {
+            flat_hash_table temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    flat_hash_table& operator=(flat_hash_table&& rhs) noexcept {
+        if (this != &rhs) {
+            destroy_all();
+            ctrl_ = rhs.ctrl_;
+            slots_ = rhs.slots_;
+            size_ = rhs.size_;
+            capacity_ = rhs.capacity_;
+            growth_left_ = rhs.growth_left_;
+            hash_ = rhs.hash_;
+            equal_ = rhs.equal_;
+            rhs.reset_empty();
+        }
+        return *this;
+    }
+
+    ~flat_hash_table() { destroy_all(); }
+
+public:
+    // 迭代器相关操作
+    iterator begin() noexcept {
+        iterator it(ctrl_, slots_);
+        it.skip_empty_or_deleted();
+        return it;
+    }
+    const_iterator begin() const noexcept {
+        const_iterator it(ctrl_, slots_);
+        it.skip_empty_or_deleted();
+        return it;
+    }
+    iterator end() noexcept { return iterator(ctrl_ + capacity_, slots_ + capacity_); }
+    const_iterator end() const noexcept { return const_iterator(ctrl_ + capacity_, slots_ + capacity_); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // 容量相关操作
+    bool      empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) / (sizeof(Value) + 1) / 2; }
+    size_type capacity() const noexcept { return capacity_; }
+
+    // 修改容器相关操作
+
+    // 若不存在与 key 相等的元素，以 args 构造一个新元素，args 构造出的元素的键必须与 key 相等
+    template <class K, class... Args>
+    mystl::pair<iterator, bool> emplace_key(const K& key, Args&&... args);
+
+    // 供 flat_hash_map 使用：键不存在时才以 key_value 与 args 分别构造键和映射值
+    template <class K, class KeyArg, class... Args>
+    mystl::pair<iterator, bool> try_emplace_key(const K& key, KeyArg&& key_value, Args&&... args);
+
+    template <class... Args>
+    mystl::pair<iterator, bool> emplace(Args&&... args) {
+        value_type value(mystl::forward<Args>(args)...);
+        return insert(mystl::move(value));
+    }
+
+    mystl::pair<iterator, bool> insert(const value_type& value) {
+        return emplace_key(KeyOfValue()(value), value);
+    }
+
+    mystl::pair<iterator, bool> insert(value_type&& value) {
+        return emplace_key(KeyOfValue()(value), mystl::move(value));
+    }
+
+    template <class InputIter>
+    void insert(InputIter first, InputIter last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    iterator erase(const_iterator pos) {
+        iterator next(pos.ctrl, const_cast<value_type*>(pos.slot));
+        ++next;
+        erase_at(static_cast<size_type>(pos.slot - slots_));
+        return next;
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        return iterator(last.ctrl, const_cast<value_type*>(last.slot));
+    }
+
+    template <class K = key_type>
+    size_type erase(const key_arg<K>& key) {
+        const size_type i = find_index(key, hash_of(key));
+        if (i == npos) {
+            return 0;
+        }
+        erase_at(i);
+        return 1;
+    }
+
+    void clear();
+
+    void swap(flat_hash_table& rhs) noexcept {
+        mystl::swap(ctrl_, rhs.ctrl_);
+        mystl::swap(slots_, rhs.slots_);
+        mystl::swap(size_, rhs.size_);
+        mystl::swap(capacity_, rhs.capacity_);
+        mystl::swap(growth_left_, rhs.growth_left_);
+        mystl::swap(hash_, rhs.hash_);
+        mystl::swap(equal_, rhs.equal_);
+    }
+
+    // 查找相关操作
+    template <class K = key_type>
+    iterator find(const key_arg<K>& key) {
+        const size_type i = find_index(key, hash_of(key));
+        return i == npos ? end() : iterator_at(i);
+    }
+
+    template <class K = key_type>
+    const_iterator find(const key_arg<K>& key) const {
+        const size_type i = find_index(key, hash_of(key));
+        return i == npos ? end() : const_iterator(ctrl_ + i, slots_ + i);
+    }
+
+    template <class K = key_type>
+    size_type count(const key_arg<K>& key) const {
+        return find_index(key, hash_of(key)) == npos ? 0 : 1;
+    }
+
+    template <class K = key_type>
+    bool contains(const key_arg<K>& key) const {
+        return find_index(key, hash_of(key)) != npos;
+    }
+
+    // 桶与哈希策略
+    size_type bucket_count() const noexcept { return capacity_; }
+
+    float load_factor() const noexcept {
+        return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / static_cast<float>(capacity_);
+    }
+
+    // 最大负载因子固定为 7/8
+    float max_load_factor() const noexcept { return 0.875f; }
+
+    // 使容量不小于 count，并且能放下现有的元素；count 为 0 且没有元素时释放全部内存
+    void rehash(size_type count);
+
+    // 预留空间，之后插入 count 个元素之前不会重建
+    void reserve(size_type count) {
+        if (count > size_ + growth_left_) {
+            resize(normalize_capacity(growth_to_capacity(count)));
+        }
+    }
+
+    hasher hash_function() const { return hash_; }
+    key_equal key_eq() const { return equal_; }
+
+private:
+    // helper functions
+
+    // 哈希值，Hash 的结果不够均匀时先混合
+    template <class K>
+    size_t hash_of(const K& key) const {
+        return mix(hash_(key), is_avalanching_hash<Hash>());
+    }
+
+    static size_t mix(size_t h, std::true_type) noexcept { return h; }
+    static size_t mix(size_t h, std::false_type) noexcept { return mystl::hash_mix(h); }
+
+    static size_t h1(size_t h) noexcept { return h >> 7; }
+    static flat_hash_ctrl h2(size_t h) noexcept { return static_cast<flat_hash_ctrl>(h & 0x7f); }
+
+    static bool is_full(flat_hash_ctrl c) noexcept { return c >= 0; }
+
+    // 不小于 n 的 2^k - 1，至少为 FlatHashMinCapacity
+    static size_type normalize_capacity(size_type n) noexcept {
+        return n <= FlatHashMinCapacity ? FlatHashMinCapacity
+                                        : static_cast<size_type>(-1) >> mystl::countl_zero64(n);
+    }
+
+    // 容量为 cap 时最多能放的元素个数
+    static size_type capacity_to_growth(size_type cap) noexcept { return cap - cap / 8; }
+
+    // 放下 growth 个元素所需的最小容量（未取整为 2^k - 1）
+    static size_type growth_to_capacity(size_type growth) noexcept {
+        return growth == 0 ? 0 : growth + (growth - 1) / 7;
+    }
+
+    iterator iterator_at(size_type i) noexcept { return iterator(ctrl_ + i, slots_ + i); }
+
+    // 设置第 i 个槽的控制字节，开头的 15 个槽同时更新哨兵之后的副本
+    void set_ctrl(size_type i, flat_hash_ctrl c) noexcept {
+        ctrl_[i] = c;
+        ctrl_[((i - (FlatHashGroupWidth - 1)) & capacity_) + (FlatHashGroupWidth - 1)] = c;
+    }
+
+    template <class K>
+    size_type find_index(const K& key, size_t hash) const;
+
+    size_type find_first_non_full(size_t hash) const noexcept;
+
+    size_type prepare_insert(size_t hash);
+
+    void erase_meta_only(size_type i) noexcept;
+
+    void erase_at(size_type i) {
+        mystl::destroy(slots_ + i);
+        --size_;
+        erase_meta_only(i);
+    }
+
+    void rehash_and_grow_if_necessary() {
+        if (capacity_ > FlatHashGroupWidth && size_ * 32 <= capacity_ * 25) {
+            // 墓碑占了至少 3/32，按原容量重建即可
+            resize(capacity_);
+        }
+        else {
+            resize(capacity_ == 0 ? FlatHashMinCapacity : capacity_ * 2 + 1);
+        }
+    }
+
+    static size_type slot_offset(size_type cap) noexcept {
+        return (cap + FlatHashGroupWidth + alignof(Value) - 1) / alignof(Value) * alignof(Value);
+    }
+
+    void initialize_slots(size_type cap);
+
+    void resize(size_type new_cap);
+
+    void destroy_all() noexcept;
+
+    void reset_empty() noexcept {
+        ctrl_ = flat_hash_empty_group();
+        slots_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+        growth_left_ = 0;
+    }
+};
+
+/*****************************************************************************************/
+
+// 复制构造函数：容量与控制字节原样复制，元素复制到相同的槽中，不需要重新哈希
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::flat_hash_table(const flat_hash_table& rhs)
+    : ctrl_(flat_hash_empty_group()), slots_(nullptr), size_(0), capacity_(0), growth_left_(0),
+      hash_(rhs.hash_), equal_(rhs.equal_) {
+    if (rhs.size_ == 0) {
+        return;
+    }
+    initialize_slots(rhs.capacity_);
+    size_type i = 0;
+    try {
+        for (; i < capacity_; ++i) {
+            if (is_full(rhs.ctrl_[i])) {
+                mystl::construct(slots_ + i, rhs.slots_[i]);
+                ctrl_[i] = rhs.ctrl_[i];
+            }
+        }
+    }
+    catch (...) {
+        destroy_all();
+        throw;
+    }
+    std::memcpy(ctrl_, rhs.ctrl_, capacity_ + FlatHashGroupWidth);
+    size_ = rhs.size_;
+    growth_left_ = rhs.growth_left_;
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+template <class K, class... Args>
+mystl::pair<typename flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::iterator, bool>
+flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::emplace_key(const K& key, Args&&... args) {
+    const size_t hash = hash_of(key);
+    size_type i = find_index(key, hash);
+    if (i != npos) {
+        return mystl::pair<iterator, bool>(iterator_at(i), false);
+    }
+    i = prepare_insert(hash);
+    try {
+        mystl::construct(slots_ + i, mystl::forward<Args>(args)...);
+    }
+    catch (...) {
+        --size_;
+        erase_meta_only(i);
+        throw;
+    }
+    return mystl::pair<iterator, bool>(iterator_at(i), true);
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+template <class K, class KeyArg, class... Args>
+mystl::pair<typename flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::iterator, bool>
+flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::try_emplace_key(const K& key, KeyArg&& key_value, Args&&... args) {
+    const size_t hash = hash_of(key);
+    size_type i = find_index(key, hash);
+    if (i != npos) {
+        return mystl::pair<iterator, bool>(iterator_at(i), false);
+    }
+    i = prepare_insert(hash);
+    try {
+        mystl::construct(slots_ + i, mystl::forward<KeyArg>(key_value),
+                         typename Value::second_type(mystl::forward<Args>(args)...));
+    }
+    catch (...) {
+        --size_;
+        erase_meta_only(i);
+        throw;
+    }
+    return mystl::pair<iterator, bool>(iterator_at(i), true);
+}
+
+// 析构所有元素，保留容量
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+void flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::clear() {
+    if (capacity_ == 0) {
+        return;
+    }
+    for (size_type i = 0; i < capacity_; ++i) {
+        if (is_full(ctrl_[i])) {
+            mystl::destroy(slots_ + i);
+        }
+    }
+    std::memset(ctrl_, static_cast<unsigned char>(FlatHashEmpty), capacity_ + FlatHashGroupWidth);
+    ctrl_[capacity_] = FlatHashSentinel;
+    size_ = 0;
+    growth_left_ = capacity_to_growth(capacity_);
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+void flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::rehash(size_type count) {
+    if (count == 0 && size_ == 0) {
+        destroy_all();
+        return;
+    }
+    const size_type need = mystl::max(count, growth_to_capacity(size_));
+    const size_type new_cap = normalize_capacity(need);
+    if (new_cap != capacity_ || size_ + growth_left_ < capacity_to_growth(capacity_)) {
+        resize(new_cap);
+    }
+}
+
+// 查找与 key 相等的元素所在的槽，找不到时返回 npos
+// 每组先用 H2 筛选，只对控制字节相同的槽比较键；组内有空槽时探测序列到此为止
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+template <class K>
+typename flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::size_type
+flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::find_index(const K& key, size_t hash) const {
+    const flat_hash_ctrl tag = h2(hash);
+    size_type offset = h1(hash) & capacity_;
+    size_type step = 0;
+    while (true) {
+        const flat_hash_group group(ctrl_ + offset);
+        for (uint32_t mask = group.match(tag); mask != 0; mask &= mask - 1) {
+            const size_type i = (offset + static_cast<size_type>(mystl::countr_zero64(mask))) & capacity_;
+            if (equal_(KeyOfValue()(slots_[i]), key)) {
+                return i;
+            }
+        }
+        if (group.match_empty() != 0) {
+            return npos;
+        }
+        step += FlatHashGroupWidth;
+        offset = (offset + step) & capacity_;
+    }
+}
+
+// 沿探测序列找到第一个空槽或墓碑
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+typename flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::size_type
+flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::find_first_non_full(size_t hash) const noexcept {
+    size_type offset = h1(hash) & capacity_;
+    size_type step = 0;
+    while (true) {
+        const uint32_t mask = flat_hash_group(ctrl_ + offset).match_empty_or_deleted();
+        if (mask != 0) {
+            return (offset + static_cast<size_type>(mystl::countr_zero64(mask))) & capacity_;
+        }
+        step += FlatHashGroupWidth;
+        offset = (offset + step) & capacity_;
+    }
+}
+
+// 为哈希值为 hash 的新元素占用一个槽，返回槽的下标，由调用者在槽中构造元素
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+typename flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::size_type
+flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::prepare_insert(size_t hash) {
+    size_type target = find_first_non_full(hash);
+    // 复用墓碑不会减少空槽，不受负载上限的限制
+    if (growth_left_ == 0 && ctrl_[target] != FlatHashDeleted) {
+        rehash_and_grow_if_necessary();
+        target = find_first_non_full(hash);
+    }
+    ++size_;
+    growth_left_ -= static_cast<size_type>(ctrl_[target] == FlatHashEmpty);
+    set_ctrl(target, h2(hash));
+    return target;
+}
+
+// 把第 i 个槽标记为空或墓碑
+// i 之前与之后紧邻的非空槽加起来不到一组时，任何一次读入的 16 个控制字节都包含空槽，
+// 没有探测序列会越过 i 继续查找，可以直接标记为空
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+void flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::erase_meta_only(size_type i) noexcept {
+    const size_type before = (i - FlatHashGroupWidth) & capacity_;
+    const uint32_t empty_after = flat_hash_group(ctrl_ + i).match_empty();
+    const uint32_t empty_before = flat_hash_group(ctrl_ + before).match_empty();
+    const bool was_never_full = empty_before != 0 && empty_after != 0 &&
+        static_cast<size_type>(mystl::countr_zero64(empty_after) + mystl::countl_zero64(empty_before) - 48) <
+        FlatHashGroupWidth;
+    set_ctrl(i, was_never_full ? FlatHashEmpty : FlatHashDeleted);
+    growth_left_ += static_cast<size_type>(was_never_full);
+}
+
+// 分配容量为 cap 的空表，控制字节全部为空，末尾放置哨兵
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+void flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::initialize_slots(size_type cap) {
+    THROW_LENGTH_ERROR_IF(cap > max_size(), "flat_hash_table's size too big");
+    const size_type offset = slot_offset(cap);
+    char* raw = static_cast<char*>(::operator new(offset + cap * sizeof(Value)));
+    ctrl_ = reinterpret_cast<flat_hash_ctrl*>(raw);
+    slots_ = reinterpret_cast<value_type*>(raw + offset);
+    capacity_ = cap;
+    std::memset(ctrl_, static_cast<unsigned char>(FlatHashEmpty), cap + FlatHashGroupWidth);
+    ctrl_[cap] = FlatHashSentinel;
+    growth_left_ = capacity_to_growth(cap) - size_;
+}
+
+// 把所有元素搬到容量为 new_cap 的新表中，同时清除墓碑
+// 元素的移动构造可能抛出异常时改为复制，失败时原表保持不变
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+void flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::resize(size_type new_cap) {
+    flat_hash_ctrl* old_ctrl = ctrl_;
+    value_type* old_slots = slots_;
+    const size_type old_cap = capacity_;
+    const size_type old_growth = growth_left_;
+
+    initialize_slots(new_cap);
+    try {
+        for (size_type i = 0; i < old_cap; ++i) {
+            if (is_full(old_ctrl[i])) {
+                const size_t hash = hash_of(KeyOfValue()(old_slots[i]));
+                const size_type target = find_first_non_full(hash);
+                mystl::construct(slots_ + target, std::move_if_noexcept(old_slots[i]));
+                set_ctrl(target, h2(hash));
+            }
+        }
+    }
+    catch (...) {
+        for (size_type i = 0; i < capacity_; ++i) {
+            if (is_full(ctrl_[i])) {
+                mystl::destroy(slots_ + i);
+            }
+        }
+        ::operator delete(ctrl_);
+        ctrl_ = old_ctrl;
+        slots_ = old_slots;
+        capacity_ = old_cap;
+        growth_left_ = old_growth;
+        throw;
+    }
+
+    if (old_cap != 0) {
+        for (size_type i = 0; i < old_cap; ++i) {
+            if (is_full(old_ctrl[i])) {
+                mystl::destroy(old_slots + i);
+            }
+        }
+        ::operator delete(old_ctrl);
+    }
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+void flat_hash_table<Value, Key, KeyOfValue, Hash, KeyEqual>::destroy_all() noexcept {
+    if (capacity_ == 0) {
+        return;
+    }
+    for (size_type i = 0; i < capacity_; ++i) {
+        if (is_full(ctrl_[i])) {
+            mystl::destroy(slots_ + i);
+        }
+    }
+    ::operator delete(ctrl_);
+    reset_empty();
+}
+
+}  // end namespace mystl
+
+#endif // MINITURE_STL_FLAT_HASH_TABLE_HPP_
@@ -0,0 +1,978 @@
+#ifndef MINITURE_STL_HASHTABLE_HPP_
+#define MINITURE_STL_HASHTABLE_HPP_
+
+// 这个头文件包含了一个模板类 hashtable，是 unordered_map / unordered_set 及其 multi 版本的底层实现
+// hashtable: 分离链接法的哈希表
+//
+// 所有节点串成一条单向链表，同一个桶的节点在链表中相邻。桶数组保存的不是桶的第一个节点，
+// 而是它在链表中的前一个节点（第一个桶的前一个节点是表头 before_begin_），桶为空时为 nullptr，
+// 这样在桶的开头插入、删除都只需修改前驱的 next，迭代器沿链表前进，不必扫描空桶
+//
+// 节点中缓存了哈希值：查找时先比较哈希值再比较键，重建时直接用缓存的值分桶，不再调用 Hash。
+// 桶数总是 2 的幂，用掩码取桶号；Hash 的结果不是 is_avalanching_hash 时先用 hash_mix 混合，
+// 否则 mystl::hash<int> 这样的恒等哈希只有低位参与分桶
+//
+// 节点从每个表自己的 node_pool 中分配。重建只重新链接节点，不移动元素，
+// 指向元素的指针与引用在元素被删除之前一直有效，迭代器在重建后失效
+
+#include <cmath>
+#include <cstddef>
+
+#include "../00_utils/bitops.h"
+#include "../00_utils/exceptdef.h"
+#include "../01_allocators/memory.h"
+#include "../01_allocators/node_pool.h"
+#include "../01_allocators/util.h"
+#include "../02_iterators/iterator.h"
+#include "../03_algorithms/algobase.h"
+#include "../03_algorithms/functional.h"
+
+namespace mystl {
+
+// 新建桶数组时的最小桶数
+const size_t HashtableMinBuckets = 8;
+
+// hashtable 的节点设计
+struct hashtable_node_base {
+    hashtable_node_base* next;
+};
+
+template <class Value>
+struct hashtable_node : public hashtable_node_base {
+    size_t hash;    // 混合后的哈希值
+    Value  value;
+
+    template <class... Args>
+    explicit hashtable_node(Args&&... args) : value(mystl::forward<Args>(args)...) {}
+};
+
+// hashtable 的迭代器设计，沿节点链表前进，end() 为空指针
+template <class Value, class Ref, class Ptr>
+struct hashtable_iterator : public iterator<mystl::forward_iterator_tag, Value> {
+    typedef hashtable_iterator<Value, Value&, Value*>               iterator;
+    typedef hashtable_iterator<Value, const Value&, const Value*>   const_iterator;
+    typedef hashtable_iterator                                      self;
+    typedef hashtable_node<Value>                                   node_type;
+
+    typedef Value           value_type;
+    typedef Ptr             pointer;
+    typedef Ref             reference;
+    typedef size_t          size_type;
+    typedef ptrdiff_t       difference_type;
+
+    hashtable_node_base* node;
+
+    hashtable_iterator() noexcept : node(nullptr) {}
+    explicit hashtable_iterator(hashtable_node_base* n) noexcept : node(n) {}
+    hashtable_iterator(const iterator& rhs) noexcept : node(rhs.node) {}
+
+    self& operator=(const iterator& rhs) noexcept {
+        node = rhs.node;
+        return *this;
+    }
+
+    reference operator*() const { return static_cast<node_type*>(node)->value; }
+    pointer operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        node = node->next;
+        return *this;
+    }
+
+    self operator++(int) {
+        self temp = *this;
+        node = node->next;
+        return temp;
+    }
+
+    bool operator==(const self& rhs) const { return node == rhs.node; }
+    bool operator!=(const self& rhs) const { return node != rhs.node; }
+};
+
+// 桶内的迭代器，离开当前桶时变为 end
+template <class Value, class Ref, class Ptr>
+struct hashtable_local_iterator : public iterator<mystl::forward_iterator_tag, Value> {
+    typedef hashtable_local_iterator<Value, Value&, Value*>             iterator;
+    typedef hashtable_local_iterator<Value, const Value&, const Value*> const_iterator;
+    typedef hashtable_local_iterator                                    self;
+    typedef hashtable_node<Value>                                       node_type;
+
+    typedef Value           value_type;
+    typedef Ptr             pointer;
+    typedef Ref             reference;
+    typedef size_t          size_type;
+    typedef ptrdiff_t       difference_type;
+
+    hashtable_node_base*    node;
+    size_type               bucket;
+    size_type               mask;   // 桶数减一
+
+    hashtable_local_iterator() noexcept : node(nullptr), bucket(0), mask(0) {}
+    hashtable_local_iterator(hashtable_node_base* n, size_type b, size_type m) noexcept
+        : node(n), bucket(b), mask(m) {}
+    hashtable_local_iterator(const iterator& rhs) noexcept
+        : node(rhs.node), bucket(rhs.bucket), mask(rhs.mask) {}
+
+    self& operator=(const iterator& rhs) noexcept {
+        node = rhs.node;
+        bucket = rhs.bucket;
+        mask = rhs.mask;
+        return *this;
+    }
+
+    reference operator*() const { return static_cast<node_type*>(node)->value; }
+    pointer operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        node = node->next;
+        if (node != nullptr && (static_cast<node_type*>(node)->hash & mask) != bucket) {
+            node = nullptr;
+        }
+        return *this;
+    }
+
+    self operator++(int) {
+        self temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    bool operator==(const self& rhs) const { return node == rhs.node; }
+    bool operator!=(const self& rhs) const { return node != rhs.node; }
+};
+
+// 模板类 hashtable
+// 参数依次为元素类型、键类型、从元素取出键的函数对象、哈希函数、键的比较函数
+// 带 unique 后缀的操作要求键不重复，带 multi 后缀的操作允许重复，相等的元素在链表中总是相邻
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+class hashtable {
+public:
+    typedef Value                                                           value_type;
+    typedef Key                                                             key_type;
+    typedef Hash                                                            hasher;
+    typedef KeyEqual                                                        key_equal;
+
+    typedef mystl::allocator<Value>                                         allocator_type;
+    typedef Value*                                                          pointer;
+    typedef const Value*                                                    const_pointer;
+    typedef Value&                                                          reference;
+    typedef const Value&                                                    const_reference;
+    typedef size_t                                                          size_type;
+    typedef ptrdiff_t                                                       difference_type;
+
+    typedef hashtable_iterator<Value, Value&, Value*>                       iterator;
+    typedef hashtable_iterator<Value, const Value&, const Value*>           const_iterator;
+    typedef hashtable_local_iterator<Value, Value&, Value*>                 local_iterator;
+    typedef hashtable_local_iterator<Value, const Value&, const Value*>     const_local_iterator;
+
+    allocator_type get_allocator() const { return allocator_type(); }
+
+private:
+    typedef hashtable_node_base                                             base_type;
+    typedef hashtable_node<Value>                                           node_type;
+    typedef mystl::allocator<base_type*>                                    bucket_allocator;
+
+    base_type**             buckets_;           // 桶数组，未分配时指向 single_bucket_
+    size_type               bucket_count_;      // 桶数，总是 2 的幂
+    base_type               before_begin_;      // 链表的表头，next 为第一个节点
+    size_type               size_;
+    float                   max_load_factor_;
+    size_type               next_resize_;       // 元素个数超过这个值时扩容
+    base_type*              single_bucket_;     // 空表使用的唯一一个桶
+    node_pool<node_type>    pool_;
+    hasher                  hash_;
+    key_equal               equal_;
+
+public:
+    // 构造、复制、移动、析构函数
+    hashtable() : hashtable(0) {}
+
+    explicit hashtable(size_type bucket_count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : buckets_(&single_bucket_), bucket_count_(1), size_(0), max_load_factor_(1.0f), next_resize_(1),
+          single_bucket_(nullptr), pool_(), hash_(hash), equal_(equal) {
+        before_begin_.next = nullptr;
+        if (bucket_count > 1) {
+            rehash_aux(round_up_buckets(bucket_count));
+        }
+    }
+
+    hashtable(const hashtable& rhs);
+
+    hashtable(hashtable&& rhs) noexcept
+        : buckets_(&single_bucket_), bucket_count_(1), size_(0), max_load_factor_(rhs.max_load_factor_),
+          next_resize_(1), single_bucket_(nullptr), pool_(), hash_(rhs.hash_), equal_(rhs.equal_) {
+        before_begin_.next = nullptr;
+        steal(rhs);
+    }
+
+    hashtable& operator=(const hashtable& rhs) {
+        if (this != &rhs) {
+            hashtable temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    hashtable& operator=(hashtable&& rhs) noexcept {
+        if (this != &rhs) {
+            destroy_nodes(std::is_trivially_destructible<Value>());
+            deallocate_buckets();
+            pool_.release();
+            max_load_factor_ = rhs.max_load_factor_;
+            hash_ = rhs.hash_;
+            equal_ = rhs.equal_;
+            steal(rhs);
+        }
+        return *this;
+    }
+
+    ~hashtable() {
+        destroy_nodes(std::is_trivially_destructible<Value>());
+        deallocate_buckets();
+    }
+
+public:
+    // 迭代器相关操作
+    iterator begin() noexcept { return iterator(before_begin_.next); }
+    const_iterator begin() const noexcept { return const_iterator(before_begin_.next); }
+    iterator end() noexcept { return iterator(); }
+    const_iterator end() const noexcept { return const_iterator(); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // 容量相关操作
+    bool      empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(node_type); }
+
+    // 修改容器相关操作
+
+    // 先构造节点再查找，已有相等的元素时销毁新节点
+    template <class... Args>
+    mystl::pair<iterator, bool> emplace_unique(Args&&... args);
+
+    template <class... Args>
+    iterator emplace_multi(Args&&... args);
+
+    mystl::pair<iterator, bool> insert_unique(const value_type& value) {
+        return emplace_key(KeyOfValue()(value), value);
+    }
+
+    mystl::pair<iterator, bool> insert_unique(value_type&& value) {
+        return emplace_key(KeyOfValue()(value), mystl::move(value));
+    }
+
+    iterator insert_multi(const value_type& value) { return emplace_multi(value); }
+    iterator insert_multi(value_type&& value) { return emplace_multi(mystl::move(value)); }
+
+    template <class InputIter>
+    void insert_unique(InputIter first, InputIter last) {
+        for (; first != last; ++first) {
+            insert_unique(*first);
+        }
+    }
+
+    template <class InputIter>
+    void insert_multi(InputIter first, InputIter last) {
+        for (; first != last; ++first) {
+            insert_multi(*first);
+        }
+    }
+
+    // 先查找再构造节点：不存在与 key 相等的元素时，以 args 构造新元素，其键必须与 key 相等
+    template <class... Args>
+    mystl::pair<iterator, bool> emplace_key(const key_type& key, Args&&... args);
+
+    // 供 unordered_map 使用：键不存在时才以 key_value 与 args 分别构造键和映射值
+    template <class KeyArg, class... Args>
+    mystl::pair<iterator, bool> try_emplace_key(const key_type& key, KeyArg&& key_value, Args&&... args);
+
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+
+    size_type erase_unique(const key_type& key);
+    size_type erase_multi(const key_type& key);
+
+    void clear() noexcept;
+
+    void swap(hashtable& rhs) noexcept;
+
+    // 查找相关操作
+    iterator find(const key_type& key) {
+        return iterator(find_node(key));
+    }
+
+    const_iterator find(const key_type& key) const {
+        return const_iterator(find_node(key));
+    }
+
+    size_type count_unique(const key_type& key) const {
+        return find_node(key) == nullptr ? 0 : 1;
+    }
+
+    size_type count_multi(const key_type& key) const {
+        const mystl::pair<base_type*, base_type*> range = equal_range_node(key);
+        size_type n = 0;
+        for (base_type* p = range.first; p != range.second; p = p->next) {
+            ++n;
+        }
+        return n;
+    }
+
+    mystl::pair<iterator, iterator> equal_range(const key_type& key) {
+        const mystl::pair<base_type*, base_type*> range = equal_range_node(key);
+        return mystl::pair<iterator, iterator>(iterator(range.first), iterator(range.second));
+    }
+
+    mystl::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        const mystl::pair<base_type*, base_type*> range = equal_range_node(key);
+        return mystl::pair<const_iterator, const_iterator>(const_iterator(range.first), const_iterator(range.second));
+    }
+
+    // 桶接口
+    local_iterator begin(size_type n) noexcept {
+        return local_iterator(buckets_[n] == nullptr ? nullptr : buckets_[n]->next, n, bucket_count_ - 1);
+    }
+    const_local_iterator begin(size_type n) const noexcept {
+        return const_local_iterator(buckets_[n] == nullptr ? nullptr : buckets_[n]->next, n, bucket_count_ - 1);
+    }
+    local_iterator end(size_type n) noexcept { return local_iterator(nullptr, n, bucket_count_ - 1); }
+    const_local_iterator end(size_type n) const noexcept { return const_local_iterator(nullptr, n, bucket_count_ - 1); }
+
+    const_local_iterator cbegin(size_type n) const noexcept { return begin(n); }
+    const_local_iterator cend(size_type n) const noexcept { return end(n); }
+
+    size_type bucket_count() const noexcept { return bucket_count_; }
+    size_type max_bucket_count() const noexcept { return static_cast<size_type>(1) << 62; }
+
+    size_type bucket_size(size_type n) const noexcept {
+        size_type count = 0;
+        for (const_local_iterator it = begin(n); it != end(n); ++it) {
+            ++count;
+        }
+        return count;
+    }
+
+    size_type bucket(const key_type& key) const { return bucket_index(hash_of(key)); }
+
+    // 哈希策略
+    float load_factor() const noexcept {
+        return static_cast<float>(size_) / static_cast<float>(bucket_count_);
+    }
+
+    float max_load_factor() const noexcept { return max_load_factor_; }
+
+    // 修改最大负载因子，现有元素超出新的上限时立即重建
+    void max_load_factor(float ml);
+
+    // 使桶数不小于 count，并且不超过最大负载因子
+    void rehash(size_type count);
+
+    // 预留空间，之后插入 count 个元素之前不会重建，也不会再向系统申请节点内存
+    void reserve(size_type count) {
+        rehash(buckets_for(count));
+        if (count > size_) {
+            pool_.reserve(count - size_);
+        }
+    }
+
+    hasher hash_function() const { return hash_; }
+    key_equal key_eq() const { return equal_; }
+
+    // 供容器的 operator== 使用，键相等的元素再用 operator== 比较
+    bool equal_unique(const hashtable& rhs) const;
+    bool equal_multi(const hashtable& rhs) const;
+
+private:
+    // helper functions
+
+    // 哈希值，Hash 的结果不够均匀时先混合
+    size_t hash_of(const key_type& key) const {
+        return mix(hash_(key), is_avalanching_hash<Hash>());
+    }
+
+    static size_t mix(size_t h, std::true_type) noexcept { return h; }
+    static size_t mix(size_t h, std::false_type) noexcept { return mystl::hash_mix(h); }
+
+    size_type bucket_index(size_t hash) const noexcept { return hash & (bucket_count_ - 1); }
+
+    static size_type node_bucket(const base_type* p, size_type mask) noexcept {
+        return static_cast<const node_type*>(p)->hash & mask;
+    }
+
+    static const key_type& node_key(const base_type* p) noexcept {
+        return KeyOfValue()(static_cast<const node_type*>(p)->value);
+    }
+
+    bool node_equals(const base_type* p, const key_type& key, size_t hash) const {
+        return static_cast<const node_type*>(p)->hash == hash && equal_(node_key(p), key);
+    }
+
+    // 不小于 n 的 2 的幂
+    static size_type round_up_buckets(size_type n) noexcept {
+        return n <= 1 ? 1 : static_cast<size_type>(1) << (64 - mystl::countl_zero64(n - 1));
+    }
+
+    // 放下 n 个元素而不超过最大负载因子所需的桶数
+    size_type buckets_for(size_type n) const noexcept {
+        return static_cast<size_type>(std::ceil(static_cast<double>(n) / max_load_factor_));
+    }
+
+    void update_next_resize() noexcept {
+        next_resize_ = static_cast<size_type>(static_cast<double>(bucket_count_) * max_load_factor_);
+    }
+
+    template <class... Args>
+    node_type* create_node(Args&&... args);
+
+    void destroy_node(node_type* p) noexcept {
+        mystl::destroy(p);
+        pool_.deallocate(p);
+    }
+
+    void destroy_nodes(std::true_type) noexcept {}
+    void destroy_nodes(std::false_type) noexcept {
+        for (base_type* p = before_begin_.next; p != nullptr; p = p->next) {
+            mystl::destroy(static_cast<node_type*>(p));
+        }
+    }
+
+    // 在第 b 个桶中查找与 key 相等的节点，返回它的前一个节点，找不到时返回 nullptr
+    base_type* find_before_node(size_type b, const key_type& key, size_t hash) const;
+
+    base_type* find_node(const key_type& key) const {
+        if (size_ == 0) {
+            return nullptr;
+        }
+        const size_t hash = hash_of(key);
+        base_type* prev = find_before_node(bucket_index(hash), key, hash);
+        return prev == nullptr ? nullptr : prev->next;
+    }
+
+    mystl::pair<base_type*, base_type*> equal_range_node(const key_type& key) const;
+
+    // 把节点 p 放到第 b 个桶的开头
+    void insert_bucket_begin(size_type b, base_type* p) noexcept;
+
+    // 新增一个元素前确保不超过最大负载因子
+    void rehash_if_needed() {
+        if (size_ + 1 > next_resize_) {
+            size_type n = mystl::max(bucket_count_ * 2, round_up_buckets(buckets_for(size_ + 1)));
+            rehash_aux(mystl::max(n, static_cast<size_type>(HashtableMinBuckets)));
+        }
+    }
+
+    // 插入已经构造好的节点，扩容失败时销毁节点
+    iterator link_unique_node(node_type* p, size_t hash);
+
+    // 删除第 b 个桶中 prev 之后的节点，返回被删节点的下一个节点
+    base_type* erase_node(size_type b, base_type* prev, base_type* p) noexcept;
+
+    void rehash_aux(size_type n);
+
+    void deallocate_buckets() noexcept {
+        if (buckets_ != &single_bucket_) {
+            bucket_allocator::deallocate(buckets_, bucket_count_);
+        }
+    }
+
+    // 接管 rhs 的节点与桶，rhs 变为空表
+    void steal(hashtable& rhs) noexcept;
+
+    // 第一个节点所在桶的前驱是 before_begin_，复制、移动表头之后需要修正
+    void fix_before_begin() noexcept {
+        if (before_begin_.next != nullptr) {
+            buckets_[node_bucket(before_begin_.next, bucket_count_ - 1)] = &before_begin_;
+        }
+    }
+};
+
+/*****************************************************************************************/
+
+// 复制构造函数：桶数与 rhs 相同，按原顺序复制节点，沿用缓存的哈希值
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::hashtable(const hashtable& rhs)
+    : buckets_(&single_bucket_), bucket_count_(1), size_(0), max_load_factor_(rhs.max_load_factor_),
+      next_resize_(1), single_bucket_(nullptr), pool_(), hash_(rhs.hash_), equal_(rhs.equal_) {
+    before_begin_.next = nullptr;
+    if (rhs.bucket_count_ > 1) {
+        rehash_aux(rhs.bucket_count_);
+    }
+    pool_.reserve(rhs.size_);
+    const size_type mask = bucket_count_ - 1;
+    base_type* prev = &before_begin_;
+    try {
+        for (const base_type* q = rhs.before_begin_.next; q != nullptr; q = q->next) {
+            node_type* p = create_node(static_cast<const node_type*>(q)->value);
+            p->hash = static_cast<const node_type*>(q)->hash;
+            prev->next = p;
+            const size_type b = node_bucket(p, mask);
+            if (buckets_[b] == nullptr) {
+                buckets_[b] = prev;
+            }
+            prev = p;
+            ++size_;
+        }
+    }
+    catch (...) {
+        clear();
+        deallocate_buckets();
+        throw;
+    }
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+template <class... Args>
+typename hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::node_type*
+hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::create_node(Args&&... args) {
+    node_type* p = pool_.allocate();
+    try {
+        mystl::construct(p, mystl::forward<Args>(args)...);
+    }
+    catch (...) {
+        pool_.deallocate(p);
+        throw;
+    }
+    p->next = nullptr;
+    return p;
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+template <class... Args>
+mystl::pair<typename hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::iterator, bool>
+hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::emplace_unique(Args&&... args) {
+    node_type* p = create_node(mystl::forward<Args>(args)...);
+    const key_type& key = KeyOfValue()(p->value);
+    size_t hash;
+    base_type* prev;
+    try {
+        hash = hash_of(key);
+        prev = size_ == 0 ? nullptr : find_before_node(bucket_index(hash), key, hash);
+    }
+    catch (...) {
+        destroy_node(p);
+        throw;
+    }
+    if (prev != nullptr) {
+        destroy_node(p);
+        return mystl::pair<iterator, bool>(iterator(prev->next), false);
+    }
+    return mystl::pair<iterator, bool>(link_unique_node(p, hash), true);
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+template <class... Args>
+typename hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::iterator
+hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::emplace_multi(Args&&... args) {
+    node_type* p = create_node(mystl::forward<Args>(args)...);
+    base_type* prev;
+    try {
+        const key_type& key = KeyOfValue()(p->value);
+        p->hash = hash_of(key);
+        rehash_if_needed();
+        prev = find_before_node(bucket_index(p->hash), key, p->hash);
+    }
+    catch (...) {
+        destroy_node(p);
+        throw;
+    }
+    if (prev != nullptr) {
+        // 放在第一个相等的元素之前，相等的元素保持相邻
+        p->next = prev->next;
+        prev->next = p;
+    }
+    else {
+        insert_bucket_begin(bucket_index(p->hash), p);
+    }
+    ++size_;
+    return iterator(p);
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+template <class... Args>
+mystl::pair<typename hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::iterator, bool>
+hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::emplace_key(const key_type& key, Args&&... args) {
+    const size_t hash = hash_of(key);
+    if (size_ != 0) {
+        base_type* prev = find_before_node(bucket_index(hash), key, hash);
+        if (prev != nullptr) {
+            return mystl::pair<iterator, bool>(iterator(prev->next), false);
+        }
+    }
+    node_type* p = create_node(mystl::forward<Args>(args)...);
+    return mystl::pair<iterator, bool>(link_unique_node(p, hash), true);
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+template <class KeyArg, class... Args>
+mystl::pair<typename hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::iterator, bool>
+hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::try_emplace_key(const key_type& key, KeyArg&& key_value,
+                                                                   Args&&... args) {
+    const size_t hash = hash_of(key);
+    if (size_ != 0) {
+        base_type* prev = find_before_node(bucket_index(hash), key, hash);
+        if (prev != nullptr) {
+            return mystl::pair<iterator, bool>(iterator(prev->next), false);
+        }
+    }
+    node_type* p = create_node(mystl::forward<KeyArg>(key_value),
+                               typename Value::second_type(mystl::forward<Args>(args)...));
+    return mystl::pair<iterator, bool>(link_unique_node(p, hash), true);
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+typename hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::iterator
+hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::link_unique_node(node_type* p, size_t hash) {
+    try {
+        rehash_if_needed();
+    }
+    catch (...) {
+        destroy_node(p);
+        throw;
+    }
+    p->hash = hash;
+    insert_bucket_begin(bucket_index(hash), p);
+    ++size_;
+    return iterator(p);
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+void hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::insert_bucket_begin(size_type b, base_type* p) noexcept {
+    if (buckets_[b] != nullptr) {
+        p->next = buckets_[b]->next;
+        buckets_[b]->next = p;
+    }
+    else {
+        // 空桶放到链表的开头，原来的第一个节点所在的桶的前驱变为 p
+        p->next = before_begin_.next;
+        before_begin_.next = p;
+        if (p->next != nullptr) {
+            buckets_[node_bucket(p->next, bucket_count_ - 1)] = p;
+        }
+        buckets_[b] = &before_begin_;
+    }
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+typename hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::base_type*
+hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::erase_node(size_type b, base_type* prev, base_type* p) noexcept {
+    base_type* next = p->next;
+    const size_type mask = bucket_count_ - 1;
+    if (prev == buckets_[b]) {
+        // p 是桶中的第一个节点
+        if (next == nullptr || node_bucket(next, mask) != b) {
+            if (next != nullptr) {
+                buckets_[node_bucket(next, mask)] = prev;
+            }
+            buckets_[b] = nullptr;
+        }
+    }
+    else if (next != nullptr) {
+        const size_type next_b = node_bucket(next, mask);
+        if (next_b != b) {
+            buckets_[next_b] = prev;
+        }
+    }
+    prev->next = next;
+    destroy_node(static_cast<node_type*>(p));
+    --size_;
+    return next;
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+typename hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::iterator
+hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::erase(const_iterator pos) {
+    base_type* p = pos.node;
+    const size_type b = node_bucket(p, bucket_count_ - 1);
+    base_type* prev = buckets_[b];
+    while (prev->next != p) {
+        prev = prev->next;
+    }
+    return iterator(erase_node(b, prev, p));
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+typename hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::iterator
+hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::erase(const_iterator first, const_iterator last) {
+    if (first == last) {
+        return iterator(last.node);
+    }
+    // 只需找一次前驱，之后被删节点的前驱不变
+    base_type* p = first.node;
+    const size_type mask = bucket_count_ - 1;
+    base_type* prev = buckets_[node_bucket(p, mask)];
+    while (prev->next != p) {
+        prev = prev->next;
+    }
+    while (p != last.node) {
+        p = erase_node(node_bucket(p, mask), prev, p);
+    }
+    return iterator(last.node);
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+typename hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::size_type
+hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::erase_unique(const key_type& key) {
+    if (size_ == 0) {
+        return 0;
+    }
+    const size_t hash = hash_of(key);
+    const size_type b = bucket_index(hash);
+    base_type* prev = find_before_node(b, key, hash);
+    if (prev == nullptr) {
+        return 0;
+    }
+    erase_node(b, prev, prev->next);
+    return 1;
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+typename hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::size_type
+hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::erase_multi(const key_type& key) {
+    if (size_ == 0) {
+        return 0;
+    }
+    const size_t hash = hash_of(key);
+    const size_type b = bucket_index(hash);
+    base_type* prev = find_before_node(b, key, hash);
+    if (prev == nullptr) {
+        return 0;
+    }
+    size_type n = 0;
+    base_type* p = prev->next;
+    do {
+        p = erase_node(b, prev, p);
+        ++n;
+    } while (p != nullptr && node_equals(p, key, hash));
+    return n;
+}
+
+// 析构所有元素，节点归还给节点池，保留桶数
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+void hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::clear() noexcept {
+    base_type* p = before_begin_.next;
+    while (p != nullptr) {
+        base_type* next = p->next;
+        destroy_node(static_cast<node_type*>(p));
+        p = next;
+    }
+    for (size_type i = 0; i < bucket_count_; ++i) {
+        buckets_[i] = nullptr;
+    }
+    before_begin_.next = nullptr;
+    size_ = 0;
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+void hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::swap(hashtable& rhs) noexcept {
+    // 使用 single_bucket_ 的一方交换后要指向自己的 single_bucket_
+    const bool lhs_single = buckets_ == &single_bucket_;
+    const bool rhs_single = rhs.buckets_ == &rhs.single_bucket_;
+    mystl::swap(buckets_, rhs.buckets_);
+    mystl::swap(single_bucket_, rhs.single_bucket_);
+    if (rhs_single) {
+        buckets_ = &single_bucket_;
+    }
+    if (lhs_single) {
+        rhs.buckets_ = &rhs.single_bucket_;
+    }
+    mystl::swap(bucket_count_, rhs.bucket_count_);
+    mystl::swap(before_begin_.next, rhs.before_begin_.next);
+    mystl::swap(size_, rhs.size_);
+    mystl::swap(max_load_factor_, rhs.max_load_factor_);
+    mystl::swap(next_resize_, rhs.next_resize_);
+    pool_.swap(rhs.pool_);
+    mystl::swap(hash_, rhs.hash_);
+    mystl::swap(equal_, rhs.equal_);
+    fix_before_begin();
+    rhs.fix_before_begin();
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+void hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::steal(hashtable& rhs) noexcept {
+    if (rhs.buckets_ == &rhs.single_bucket_) {
+        buckets_ = &single_bucket_;
+        single_bucket_ = rhs.single_bucket_;
+    }
+    else {
+        buckets_ = rhs.buckets_;
+    }
+    bucket_count_ = rhs.bucket_count_;
+    before_begin_.next = rhs.before_begin_.next;
+    size_ = rhs.size_;
+    next_resize_ = rhs.next_resize_;
+    pool_ = mystl::move(rhs.pool_);
+    fix_before_begin();
+
+    rhs.buckets_ = &rhs.single_bucket_;
+    rhs.single_bucket_ = nullptr;
+    rhs.bucket_count_ = 1;
+    rhs.before_begin_.next = nullptr;
+    rhs.size_ = 0;
+    rhs.update_next_resize();
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+void hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::max_load_factor(float ml) {
+    THROW_OUT_OF_RANGE_IF(!(ml > 0.0f), "hashtable's max_load_factor must be positive");
+    max_load_factor_ = ml;
+    update_next_resize();
+    if (size_ > next_resize_) {
+        rehash_aux(round_up_buckets(buckets_for(size_)));
+    }
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+void hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::rehash(size_type count) {
+    const size_type n = round_up_buckets(mystl::max(count, buckets_for(size_)));
+    if (n != bucket_count_) {
+        rehash_aux(n);
+    }
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+typename hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::base_type*
+hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::find_before_node(size_type b, const key_type& key,
+                                                                    size_t hash) const {
+    base_type* prev = buckets_[b];
+    if (prev == nullptr) {
+        return nullptr;
+    }
+    const size_type mask = bucket_count_ - 1;
+    for (base_type* p = prev->next; ; p = p->next) {
+        if (node_equals(p, key, hash)) {
+            return prev;
+        }
+        if (p->next == nullptr || node_bucket(p->next, mask) != b) {
+            return nullptr;
+        }
+        prev = p;
+    }
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+mystl::pair<typename hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::base_type*,
+            typename hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::base_type*>
+hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::equal_range_node(const key_type& key) const {
+    if (size_ == 0) {
+        return mystl::pair<base_type*, base_type*>(nullptr, nullptr);
+    }
+    const size_t hash = hash_of(key);
+    base_type* prev = find_before_node(bucket_index(hash), key, hash);
+    if (prev == nullptr) {
+        return mystl::pair<base_type*, base_type*>(nullptr, nullptr);
+    }
+    base_type* last = prev->next->next;
+    while (last != nullptr && node_equals(last, key, hash)) {
+        last = last->next;
+    }
+    return mystl::pair<base_type*, base_type*>(prev->next, last);
+}
+
+// 按缓存的哈希值把节点重新分到 n 个桶中
+// 哈希值相同的连续节点作为一段整体移动，相等元素的相对顺序不变
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+void hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::rehash_aux(size_type n) {
+    THROW_LENGTH_ERROR_IF(n > max_bucket_count(), "hashtable's bucket count too big");
+    base_type** new_buckets = &single_bucket_;
+    if (n > 1) {
+        new_buckets = bucket_allocator::allocate(n);
+        for (size_type i = 0; i < n; ++i) {
+            new_buckets[i] = nullptr;
+        }
+    }
+    const size_type mask = n - 1;
+    base_type* p = before_begin_.next;
+    before_begin_.next = nullptr;
+    size_type begin_bucket = 0;
+    single_bucket_ = nullptr;
+    while (p != nullptr) {
+        base_type* last = p;
+        const size_t hash = static_cast<node_type*>(p)->hash;
+        while (last->next != nullptr && static_cast<node_type*>(last->next)->hash == hash) {
+            last = last->next;
+        }
+        base_type* next = last->next;
+        const size_type b = hash & mask;
+        if (new_buckets[b] == nullptr) {
+            last->next = before_begin_.next;
+            before_begin_.next = p;
+            new_buckets[b] = &before_begin_;
+            if (last->next != nullptr) {
+                new_buckets[begin_bucket] = last;
+            }
+            begin_bucket = b;
+        }
+        else {
+            last->next = new_buckets[b]->next;
+            new_buckets[b]->next = p;
+        }
+        p = next;
+    }
+    deallocate_buckets();
+    buckets_ = new_buckets;
+    bucket_count_ = n;
+    update_next_resize();
+}
+
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+bool hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::equal_unique(const hashtable& rhs) const {
+    if (size_ != rhs.size_) {
+        return false;
+    }
+    for (const base_type* p = before_begin_.next; p != nullptr; p = p->next) {
+        const base_type* q = rhs.find_node(node_key(p));
+        if (q == nullptr || !(static_cast<const node_type*>(q)->value == static_cast<const node_type*>(p)->value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 逐个比较相等键的区间，两个区间的元素互为排列即可，区间通常很短，直接逐个计数
+template <class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+bool hashtable<Value, Key, KeyOfValue, Hash, KeyEqual>::equal_multi(const hashtable& rhs) const {
+    if (size_ != rhs.size_) {
+        return false;
+    }
+    const base_type* first = before_begin_.next;
+    while (first != nullptr) {
+        const key_type& key = node_key(first);
+        const size_t hash = static_cast<const node_type*>(first)->hash;
+        const base_type* last = first->next;
+        while (last != nullptr && node_equals(last, key, hash)) {
+            last = last->next;
+        }
+        const mystl::pair<base_type*, base_type*> other = rhs.equal_range_node(key);
+        size_type n = 0, m = 0;
+        for (const base_type* p = first; p != last; p = p->next) {
+            ++n;
+        }
+        for (const base_type* q = other.first; q != other.second; q = q->next) {
+            ++m;
+        }
+        if (n != m) {
+            return false;
+        }
+        for (const base_type* p = first; p != last; p = p->next) {
+            const Value& value = static_cast<const node_type*>(p)->value;
+            size_type in_lhs = 0, in_rhs = 0;
+            for (const base_type* s = first; s != last; s = s->next) {
+                in_lhs += static_cast<size_type>(static_cast<const node_type*>(s)->value == value);
+            }
+            for (const base_type* q = other.first; q != other.second; q = q->next) {
+                in_rhs += static_cast<size_type>(static_cast<const node_type*>(q)->value == value);
+            }
+            if (in_lhs != in_rhs) {
+                return false;
+            }
+        }
+        first = last;
+    }
+    return true;
+}
+
+}  // end namespace mystl
+
+#endif // MINITURE_STL_HASHTABLE_HPP_
@@ -0,0 +1,382 @@
+#ifndef MINITURE_STL_STATIC_MAP_HPP_
+#define MINITURE_STL_STATIC_MAP_HPP_
+
+// 这个头文件包含模板类 static_map、用作键的 static_string 以及编译期可用的哈希函数 static_hash
+// static_map : 键集合在编译期确定的只读映射，可以在 constexpr 上下文中构造与查找
+//
+// 构造时为给定的 N 个键求一个最小完美哈希 (minimal perfect hash)：N 个键恰好映射到 N 个不同的槽，
+// 查找只需计算一次哈希、读一个位移值、比较一次键，没有探测，也不需要额外的空槽。
+// 方法为 hash-and-displace (CHD / PTHash)：
+//   1. 键的 64 位哈希值 h 用乘法取高位分到 B ≈ N / StaticMapBucketLoad 个桶中
+//   2. 按大小从大到小处理各桶，为每个桶找一个位移值 pilot，使桶内每个键的 slot = reduce((h ^ pilot) * c, N)
+//      都落在尚未占用的槽上，找到后占用这些槽
+//   3. 某个桶找不到合适的 pilot，或同一个桶中两个键的哈希值相同时，换一个种子从头再来
+// 查找时 slot = reduce((h ^ pilots_[reduce(h, B)]) * c, N)，再比较 keys_[slot] 与待查的键。
+//
+// 在 constexpr 中构造时，GCC 与 Clang 对常量求值的步数有限制，GCC 的缺省限制下约 3000 个字符串键以内可以直接使用，
+// 更多的键可能需要调大 -fconstexpr-ops-limit / -fconstexpr-steps。
+// Key 与 Value 必须是字面类型且可以在 constexpr 中默认构造与赋值；键重复时构造失败
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "../00_utils/exceptdef.h"
+#include "../01_allocators/util.h"
+
+// 常量求值时只能逐字符处理；运行时在小端平台上改为整块读取与 memcmp，结果与逐字符处理相同
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define MYSTL_STATIC_MAP_FAST_RUNTIME 1
+#endif
+#endif
+
+#if defined(MYSTL_STATIC_MAP_FAST_RUNTIME)
+#define MYSTL_STATIC_MAP_RUNTIME() (!__builtin_is_constant_evaluated())
+#else
+#define MYSTL_STATIC_MAP_RUNTIME() false
+#endif
+
+namespace mystl {
+
+// 每个桶平均的键数，以及每个桶尝试的 pilot 个数与重新选种子的次数上限
+const size_t StaticMapBucketLoad = 4;
+const size_t StaticMapMaxPilots = 1 << 16;
+const size_t StaticMapMaxSeeds = 64;
+
+// static_map 使用的辅助函数，都可以在常量表达式中求值
+
+// splitmix64 的终结函数
+constexpr uint64_t static_hash_mix(uint64_t z) noexcept {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// 把 x 均匀地映射到 [0, n)，取 x * n 的高 64 位
+constexpr uint64_t static_map_reduce(uint64_t x, uint64_t n) noexcept {
+#if defined(__SIZEOF_INT128__)
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(x) * n) >> 64);
+#else
+    const uint64_t xl = x & 0xffffffffull, xh = x >> 32;
+    const uint64_t nl = n & 0xffffffffull, nh = n >> 32;
+    const uint64_t lh = xl * nh, hl = xh * nl;
+    const uint64_t mid = ((xl * nl) >> 32) + (lh & 0xffffffffull) + (hl & 0xffffffffull);
+    return xh * nh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+}
+
+/*****************************************************************************************/
+
+// static_string
+// 编译期可用的只读字符串视图，不拥有字符，常用来引用字符串字面量
+class static_string {
+public:
+    typedef char            value_type;
+    typedef const char*     const_pointer;
+    typedef const char*     const_iterator;
+    typedef size_t          size_type;
+
+private:
+    const char* data_;
+    size_type   size_;
+
+public:
+    constexpr static_string() noexcept : data_(""), size_(0) {}
+
+    // 字符串字面量，不包括结尾的空字符
+    template <size_t N>
+    constexpr static_string(const char (&str)[N]) noexcept : data_(str), size_(N - 1) {}
+
+    constexpr static_string(const char* str, size_type count) noexcept : data_(str), size_(count) {}
+
+    constexpr const_pointer data() const noexcept { return data_; }
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr const_iterator begin() const noexcept { return data_; }
+    constexpr const_iterator end() const noexcept { return data_ + size_; }
+    constexpr char operator[](size_type n) const noexcept { return data_[n]; }
+};
+
+constexpr bool operator==(const static_string& lhs, const static_string& rhs) noexcept {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    if (MYSTL_STATIC_MAP_RUNTIME()) {
+        return lhs.size() == 0 || std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+    }
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        if (lhs[i] != rhs[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool operator!=(const static_string& lhs, const static_string& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+/*****************************************************************************************/
+
+// 模板类 static_hash
+// 带种子的 64 位哈希函数，可以在常量表达式中求值；static_map 靠更换种子排除哈希值相同的键
+// 整数与枚举类型使用主模板
+template <class Key>
+struct static_hash {
+    static_assert(std::is_integral<Key>::value || std::is_enum<Key>::value,
+                  "static_hash<Key> requires an integral or enumeration type, or static_string");
+
+    constexpr uint64_t operator()(const Key& key, uint64_t seed) const noexcept {
+        return static_hash_mix(static_cast<uint64_t>(key) ^ seed);
+    }
+};
+
+// 每次处理 8 个字符；逐字符拼出的 64 位整数在运行时会被编译器合并为一次读取
+template <>
+struct static_hash<static_string> {
+    constexpr uint64_t operator()(const static_string& key, uint64_t seed) const noexcept {
+        const size_t n = key.size();
+        uint64_t h = seed ^ (static_cast<uint64_t>(n) * 0x9e3779b97f4a7c15ull);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            h = round(h, load(key, i, 8));
+        }
+        if (i < n) {
+            h = round(h, load(key, i, n - i));
+        }
+        return static_hash_mix(h);
+    }
+
+private:
+    // 把 key[pos, pos + count) 按小端序拼成一个整数，count 取 1 到 8
+    static constexpr uint64_t load(const static_string& key, size_t pos, size_t count) noexcept {
+        if (MYSTL_STATIC_MAP_RUNTIME()) {
+            return load_runtime(key.data() + pos, count, pos);
+        }
+        uint64_t w = 0;
+        for (size_t j = 0; j < count; ++j) {
+            w |= static_cast<uint64_t>(static_cast<unsigned char>(key[pos + j])) << (8 * j);
+        }
+        return w;
+    }
+
+    // p 之前还有 pos 个字符；不足 8 个字符时，字符串够长就读以 p + count 结尾的 8 个字符再右移，
+    // 否则用至多三次重叠的读取拼出结果
+    static uint64_t load_runtime(const char* p, size_t count, size_t pos) noexcept {
+        uint64_t w = 0;
+        if (count == 8) {
+            std::memcpy(&w, p, 8);
+        }
+        else if (pos + count >= 8) {
+            std::memcpy(&w, p + count - 8, 8);
+            w >>= 8 * (8 - count);
+        }
+        else if (count >= 4) {
+            uint32_t lo = 0, hi = 0;
+            std::memcpy(&lo, p, 4);
+            std::memcpy(&hi, p + count - 4, 4);
+            w = static_cast<uint64_t>(lo) | (static_cast<uint64_t>(hi) << (8 * (count - 4)));
+        }
+        else {
+            w = static_cast<uint64_t>(static_cast<unsigned char>(p[0])) |
+                static_cast<uint64_t>(static_cast<unsigned char>(p[count / 2])) << (8 * (count / 2)) |
+                static_cast<uint64_t>(static_cast<unsigned char>(p[count - 1])) << (8 * (count - 1));
+        }
+        return w;
+    }
+
+    static constexpr uint64_t round(uint64_t h, uint64_t w) noexcept {
+        h = (h ^ w) * 0x9fb21c651e98df25ull;
+        return h ^ (h >> 29);
+    }
+};
+
+/*****************************************************************************************/
+
+// 模板类 static_map
+// 参数一代表键的类型，参数二代表值的类型，参数三代表键的个数，参数四代表带种子的哈希函数，缺省使用 static_hash
+template <class Key, class Value, size_t N, class Hash = static_hash<Key>>
+class static_map {
+    static_assert(N > 0, "static_map requires at least one key");
+
+public:
+    typedef Key                         key_type;
+    typedef Value                       mapped_type;
+    typedef mystl::pair<Key, Value>     value_type;
+    typedef Hash                        hasher;
+    typedef size_t                      size_type;
+
+private:
+    static constexpr size_type bucket_count_ = (N + StaticMapBucketLoad - 1) / StaticMapBucketLoad;
+
+    uint64_t    seed_;
+    uint64_t    pilots_[bucket_count_];
+    key_type    keys_[N];
+    mapped_type values_[N];
+    hasher      hash_;
+
+public:
+    // 由 N 个键值对构造，在常量表达式中求值时完美哈希在编译期求得
+    constexpr static_map(const value_type (&items)[N], const Hash& hash = Hash())
+        : seed_(0), pilots_{}, keys_{}, values_{}, hash_(hash) {
+        build(items);
+    }
+
+public:
+    constexpr size_type size() const noexcept { return N; }
+    constexpr bool empty() const noexcept { return false; }
+
+    // 键所在的槽号，取 [0, N)；键不存在时返回 N
+    // 槽号对每个键固定，可以用来索引与 static_map 并列的其他数组
+    constexpr size_type index(const key_type& key) const {
+        const size_type slot = slot_of(hash_(key, seed_));
+        return keys_[slot] == key ? slot : N;
+    }
+
+    constexpr bool contains(const key_type& key) const { return index(key) != N; }
+
+    // 返回指向值的指针，键不存在时返回 nullptr
+    constexpr const mapped_type* find(const key_type& key) const {
+        const size_type slot = slot_of(hash_(key, seed_));
+        return keys_[slot] == key ? values_ + slot : nullptr;
+    }
+
+    constexpr const mapped_type& at(const key_type& key) const {
+        const size_type slot = slot_of(hash_(key, seed_));
+        THROW_OUT_OF_RANGE_IF(!(keys_[slot] == key), "static_map<Key, T>::at no such element exists");
+        return values_[slot];
+    }
+
+    // 键不存在时返回 default_value
+    constexpr mapped_type value_or(const key_type& key, const mapped_type& default_value) const {
+        const size_type slot = slot_of(hash_(key, seed_));
+        return keys_[slot] == key ? values_[slot] : default_value;
+    }
+
+    // 按槽号访问，用于遍历
+    constexpr const key_type& key_at(size_type slot) const noexcept { return keys_[slot]; }
+    constexpr const mapped_type& value_at(size_type slot) const noexcept { return values_[slot]; }
+
+    hasher hash_function() const { return hash_; }
+
+private:
+    static constexpr uint64_t pilot_value(size_type p) noexcept { return static_hash_mix(p + 1); }
+
+    constexpr size_type slot_of(uint64_t h) const noexcept {
+        return slot_of(h, pilots_[static_map_reduce(h, bucket_count_)]);
+    }
+
+    static constexpr size_type slot_of(uint64_t h, uint64_t pilot) noexcept {
+        return static_cast<size_type>(static_map_reduce((h ^ pilot) * 0xd6e8feb86659fd93ull, N));
+    }
+
+    constexpr void build(const value_type (&items)[N]);
+    constexpr bool try_build(const value_type (&items)[N], uint64_t seed);
+};
+
+/*****************************************************************************************/
+
+template <class Key, class Value, size_t N, class Hash>
+constexpr void static_map<Key, Value, N, Hash>::build(const value_type (&items)[N]) {
+    uint64_t seed = 0x2d358dccaa6c78a5ull;
+    for (size_type attempt = 0; attempt < StaticMapMaxSeeds; ++attempt) {
+        if (try_build(items, seed)) {
+            return;
+        }
+        seed = static_hash_mix(seed + attempt + 1);
+    }
+    THROW_RUNTIME_ERROR_IF(true, "static_map<Key, T> failed to find a perfect hash");
+}
+
+// 用给定的种子求完美哈希，成功时填好 seed_、pilots_、keys_ 与 values_
+template <class Key, class Value, size_t N, class Hash>
+constexpr bool static_map<Key, Value, N, Hash>::try_build(const value_type (&items)[N], uint64_t seed) {
+    uint64_t hashes[N] = {};
+    size_type bucket_of[N] = {};
+    size_type bucket_size[bucket_count_] = {};
+    size_type max_size = 0;
+    for (size_type i = 0; i < N; ++i) {
+        hashes[i] = hash_(items[i].first, seed);
+        bucket_of[i] = static_cast<size_type>(static_map_reduce(hashes[i], bucket_count_));
+        const size_type s = ++bucket_size[bucket_of[i]];
+        max_size = s > max_size ? s : max_size;
+    }
+
+    // 按桶排列键的下标：bucket_begin[b] 到 bucket_begin[b + 1] 为桶 b 中的键
+    size_type bucket_begin[bucket_count_ + 1] = {};
+    for (size_type b = 0; b < bucket_count_; ++b) {
+        bucket_begin[b + 1] = bucket_begin[b] + bucket_size[b];
+    }
+    size_type fill[bucket_count_] = {};
+    size_type order[N] = {};
+    for (size_type i = 0; i < N; ++i) {
+        order[bucket_begin[bucket_of[i]] + fill[bucket_of[i]]++] = i;
+    }
+
+    // 同一个桶中哈希值相同的两个键无论 pilot 取什么都落在同一个槽；键相同时换种子也没有用
+    for (size_type b = 0; b < bucket_count_; ++b) {
+        for (size_type i = bucket_begin[b]; i < bucket_begin[b + 1]; ++i) {
+            for (size_type j = i + 1; j < bucket_begin[b + 1]; ++j) {
+                if (hashes[order[i]] == hashes[order[j]]) {
+                    THROW_RUNTIME_ERROR_IF(items[order[i]].first == items[order[j]].first,
+                                           "static_map<Key, T> has duplicate keys");
+                    return false;
+                }
+            }
+        }
+    }
+
+    // 大桶先放，此时空槽最多
+    bool taken[N] = {};
+    size_type slots[N] = {};
+    for (size_type s = max_size; s > 0; --s) {
+        for (size_type b = 0; b < bucket_count_; ++b) {
+            if (bucket_size[b] != s) {
+                continue;
+            }
+            size_type p = 0;
+            for (; p < StaticMapMaxPilots; ++p) {
+                const uint64_t pilot = pilot_value(p);
+                bool ok = true;
+                for (size_type i = bucket_begin[b]; ok && i < bucket_begin[b + 1]; ++i) {
+                    slots[i] = slot_of(hashes[order[i]], pilot);
+                    ok = !taken[slots[i]];
+                    for (size_type j = bucket_begin[b]; ok && j < i; ++j) {
+                        ok = slots[j] != slots[i];
+                    }
+                }
+                if (ok) {
+                    pilots_[b] = pilot;
+                    for (size_type i = bucket_begin[b]; i < bucket_begin[b + 1]; ++i) {
+                        taken[slots[i]] = true;
+                    }
+                    break;
+                }
+            }
+            if (p == StaticMapMaxPilots) {
+                return false;
+            }
+        }
+    }
+
+    seed_ = seed;
+    for (size_type i = 0; i < N; ++i) {
+        keys_[slots[i]] = items[order[i]].first;
+        values_[slots[i]] = items[order[i]].second;
+    }
+    return true;
+}
+
+// 由键值对数组构造 static_map，N 由数组长度推导
+// constexpr auto m = mystl::make_static_map<mystl::static_string, int>({{"a", 1}, {"b", 2}});
+template <class Key, class Value, size_t N, class Hash = static_hash<Key>>
+constexpr static_map<Key, Value, N, Hash> make_static_map(const mystl::pair<Key, Value> (&items)[N]) {
+    return static_map<Key, Value, N, Hash>(items);
+}
+
+}  // end namespace mystl
+
+#endif // MINITURE_STL_STATIC_MAP_HPP_
@@ -0,0 +1,243 @@
+#ifndef MINITURE_STL_STATIC_SEARCH_INDEX_HPP_
+#define MINITURE_STL_STATIC_SEARCH_INDEX_HPP_
+
+// 这个头文件包含了一个模板类 static_search_index
+// static_search_index: 只读有序数据上的静态查找索引
+//
+// 构造时把有序序列按 Eytzinger(BFS) 布局重新排列：节点 k 的左右孩子分别为 2k 与 2k+1。
+// 查找时从根向下走，每一步只依赖一次比较的结果计算下一个下标，没有分支预测失败；
+// 同时一次预取若干层之后的整条缓存行，数据远大于 L3 时也能把访存延迟重叠起来。
+// 查询结果以 "rank" 表示，即元素在原有序序列中的下标，与 mystl::lower_bound 的返回值一一对应；
+// rank 由节点下标直接算出，不额外存储。
+
+#include <cstdint>
+#include <new>
+
+#include "../00_utils/bitops.h"
+#include "../00_utils/exceptdef.h"
+#include "../01_allocators/memory.h"
+#include "../01_allocators/util.h"
+#include "../02_iterators/iterator.h"
+#include "../03_algorithms/functional.h"
+
+namespace mystl {
+
+// 模板类 static_search_index
+// 参数一代表数据类型，参数二代表比较方式，缺省使用 mystl::less，输入序列必须已按该方式排序
+template <class Type, class Compare = mystl::less<Type>>
+class static_search_index {
+public:
+    typedef Type                                value_type;
+    typedef const Type&                         const_reference;
+    typedef const Type*                         const_pointer;
+    typedef size_t                              size_type;
+    typedef ptrdiff_t                           difference_type;
+    typedef Compare                             value_compare;
+
+private:
+    // 一条缓存行能容纳的节点数，下降时预取 log2(prefetch_stride) 层之后的后代所在的缓存行
+    static constexpr size_type prefetch_stride =
+        (sizeof(Type) <= cache_line_size && (cache_line_size % sizeof(Type)) == 0) ? cache_line_size / sizeof(Type) : 1;
+
+    Type*       tree_;    // Eytzinger 布局的元素，tree_[0] 不使用
+    size_type   size_;
+    Compare     comp_;
+
+public:
+    // 构造、移动、析构函数
+    static_search_index() : tree_(nullptr), size_(0), comp_() {}
+
+    template <class ForwardIter, typename std::enable_if<mystl::is_input_iterator<ForwardIter>::value, int>::type = 0>
+    static_search_index(ForwardIter first, ForwardIter last, const Compare& comp = Compare())
+        : tree_(nullptr), size_(0), comp_(comp) {
+        init(first, static_cast<size_type>(mystl::distance(first, last)));
+    }
+
+    static_search_index(const static_search_index&) = delete;
+    static_search_index& operator=(const static_search_index&) = delete;
+
+    static_search_index(static_search_index&& rhs) noexcept
+        : tree_(rhs.tree_), size_(rhs.size_), comp_(rhs.comp_) {
+        rhs.tree_ = nullptr;
+        rhs.size_ = 0;
+    }
+
+    static_search_index& operator=(static_search_index&& rhs) noexcept {
+        if (this != &rhs) {
+            destroy_all();
+            tree_ = rhs.tree_;
+            size_ = rhs.size_;
+            comp_ = rhs.comp_;
+            rhs.tree_ = nullptr;
+            rhs.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~static_search_index() { destroy_all(); }
+
+public:
+    // 容量相关操作
+    bool      empty() const noexcept { return size_ == 0; }
+    size_type size()  const noexcept { return size_; }
+
+    // 查找相关操作，返回值均为 rank，找不到时返回 size()
+
+    // 第一个不小于 value 的元素的 rank
+    size_type lower_bound(const Type& value) const {
+        const size_type k = lower_bound_node(value);
+        return k == 0 ? size_ : rank_of(k);
+    }
+
+    // 第一个大于 value 的元素的 rank
+    size_type upper_bound(const Type& value) const {
+        const size_type k = upper_bound_node(value);
+        return k == 0 ? size_ : rank_of(k);
+    }
+
+    bool contains(const Type& value) const {
+        const size_type k = lower_bound_node(value);
+        return k != 0 && !comp_(value, tree_[k]);
+    }
+
+    // 与 value 等价的元素形成的 rank 区间 [first, second)
+    mystl::pair<size_type, size_type> equal_range(const Type& value) const {
+        return mystl::pair<size_type, size_type>(lower_bound(value), upper_bound(value));
+    }
+
+    // 若存在与 value 等价的元素，返回指向其中第一个的指针，否则返回 nullptr
+    const_pointer find(const Type& value) const {
+        const size_type k = lower_bound_node(value);
+        return (k != 0 && !comp_(value, tree_[k])) ? tree_ + k : nullptr;
+    }
+
+    value_compare value_comp() const { return comp_; }
+
+private:
+    // helper functions
+
+    // 无分支下降：tree_[k] 满足 go_right 时向右，否则向左。
+    // 结束时 k 的二进制表示中，末尾的 1 对应最后一段向右走的路径，去掉它们和最后一次向左的那一位，
+    // 就得到最后一次向左走时所在的节点，即答案；从未向左走过时结果为 0
+    size_type lower_bound_node(const Type& value) const {
+        size_type k = 1;
+        while (k <= size_) {
+            prefetch_descendants(k);
+            k = 2 * k + static_cast<size_type>(comp_(tree_[k], value));
+        }
+        return k >> (mystl::countr_one64(k) + 1);
+    }
+
+    size_type upper_bound_node(const Type& value) const {
+        size_type k = 1;
+        while (k <= size_) {
+            prefetch_descendants(k);
+            k = 2 * k + static_cast<size_type>(!comp_(value, tree_[k]));
+        }
+        return k >> (mystl::countr_one64(k) + 1);
+    }
+
+    // 节点 k 在 log2(prefetch_stride) 层之后的后代从 tree_[k * prefetch_stride] 开始，
+    // 靠近底部时这个位置会越过数组末尾，预取不会访问内存，但越界的指针运算本身是未定义行为，因此按整数计算地址
+    void prefetch_descendants(size_type k) const {
+        MYSTL_PREFETCH(reinterpret_cast<uintptr_t>(tree_) + k * prefetch_stride * sizeof(Type));
+    }
+
+    size_type rank_of(size_type k) const;
+
+    template <class ForwardIter>
+    void init(ForwardIter first, size_type n);
+
+    template <class ForwardIter>
+    void build(ForwardIter& iter, size_type k, size_type& count);
+
+    void destroy_built(size_type k, size_type& remain);
+
+    void destroy_all();
+};
+
+/*****************************************************************************************/
+
+// 节点 k 在中序遍历中的位置，即 tree_[k] 在原有序序列中的下标
+// 先把树补满成高度为 h 的满二叉树：深度为 d 的节点 k 在满树中的中序下标为 r = (2(k - 2^d) + 1) * 2^(h-d) - 1。
+// 满树最底层第 j 个叶子的中序下标为 2j，实际只存在前 leaves 个叶子，
+// 排在 k 之前的 ceil(r / 2) 个最底层叶子中缺失的那些需要从 r 中减去
+template <class Type, class Compare>
+typename static_search_index<Type, Compare>::size_type
+static_search_index<Type, Compare>::rank_of(size_type k) const {
+    const int h = 63 - mystl::countl_zero64(size_);
+    const int d = 63 - mystl::countl_zero64(k);
+    const size_type r = ((2 * (k - (static_cast<size_type>(1) << d)) + 1) << (h - d)) - 1;
+    const size_type leaves = size_ - (static_cast<size_type>(1) << h) + 1;
+    const size_type before = (r + 1) / 2;
+    return before > leaves ? r - (before - leaves) : r;
+}
+
+// 分配内存并按中序遍历的顺序依次填入有序序列，中序遍历恰好按升序访问 Eytzinger 布局的各节点
+template <class Type, class Compare>
+template <class ForwardIter>
+void static_search_index<Type, Compare>::init(ForwardIter first, size_type n) {
+    if (n == 0) {
+        return;
+    }
+    THROW_LENGTH_ERROR_IF(n > static_cast<size_type>(-1) / sizeof(Type) - 1,
+                          "static_search_index<Type, Compare>'s size too big");
+
+    tree_ = static_cast<Type*>(::operator new((n + 1) * sizeof(Type)));
+    size_ = n;
+
+    size_type count = 0;
+    try {
+        build(first, 1, count);
+    }
+    catch (...) {
+        destroy_built(1, count);
+        ::operator delete(tree_);
+        tree_ = nullptr;
+        size_ = 0;
+        throw;
+    }
+}
+
+template <class Type, class Compare>
+template <class ForwardIter>
+void static_search_index<Type, Compare>::build(ForwardIter& iter, size_type k, size_type& count) {
+    if (k > size_) {
+        return;
+    }
+    build(iter, 2 * k, count);
+    mystl::construct(tree_ + k, *iter);
+    ++count;
+    ++iter;
+    build(iter, 2 * k + 1, count);
+}
+
+// 按构造时的顺序析构前 remain 个已构造的元素
+template <class Type, class Compare>
+void static_search_index<Type, Compare>::destroy_built(size_type k, size_type& remain) {
+    if (k > size_ || remain == 0) {
+        return;
+    }
+    destroy_built(2 * k, remain);
+    if (remain == 0) {
+        return;
+    }
+    mystl::destroy(tree_ + k);
+    --remain;
+    destroy_built(2 * k + 1, remain);
+}
+
+template <class Type, class Compare>
+void static_search_index<Type, Compare>::destroy_all() {
+    if (tree_ == nullptr) {
+        return;
+    }
+    mystl::destroy(tree_ + 1, tree_ + size_ + 1);
+    ::operator delete(tree_);
+    tree_ = nullptr;
+    size_ = 0;
+}
+
+}  // end namespace mystl
+
+#endif // MINITURE_STL_STATIC_SEARCH_INDEX_HPP_
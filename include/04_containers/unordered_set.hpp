@@ -0,0 +1,341 @@
+#ifndef MINITURE_STL_UNORDERED_SET_HPP_
+#define MINITURE_STL_UNORDERED_SET_HPP_
+
+// 这个头文件包含两个模板类 unordered_set 和 unordered_multiset
+// unordered_set      : 元素不重复的哈希集合，底层为分离链接的 hashtable
+// unordered_multiset : 允许元素重复的哈希集合，相等的元素在遍历时相邻
+//
+// 重建不会移动元素，指向元素的指针与引用在元素被删除之前一直有效
+
+#include <initializer_list>
+
+#include "hashtable.hpp"
+
+namespace mystl {
+
+// 模板类 unordered_set
+// 参数依次为键类型、哈希函数（缺省使用 mystl::hash）、键的比较函数（缺省使用 mystl::equal_to）
+template <class Key, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+class unordered_set {
+private:
+    typedef hashtable<Key, Key, mystl::identity<Key>, Hash, KeyEqual> base_type;
+
+    base_type ht_;
+
+public:
+    typedef typename base_type::allocator_type          allocator_type;
+    typedef typename base_type::key_type                key_type;
+    typedef typename base_type::value_type              value_type;
+    typedef typename base_type::hasher                  hasher;
+    typedef typename base_type::key_equal               key_equal;
+
+    typedef typename base_type::size_type               size_type;
+    typedef typename base_type::difference_type         difference_type;
+    typedef typename base_type::const_pointer           pointer;
+    typedef typename base_type::const_pointer           const_pointer;
+    typedef typename base_type::const_reference         reference;
+    typedef typename base_type::const_reference         const_reference;
+
+    // 元素就是键，不允许通过迭代器修改
+    typedef typename base_type::const_iterator          iterator;
+    typedef typename base_type::const_iterator          const_iterator;
+    typedef typename base_type::const_local_iterator    local_iterator;
+    typedef typename base_type::const_local_iterator    const_local_iterator;
+
+    allocator_type get_allocator() const { return ht_.get_allocator(); }
+
+public:
+    // 构造、复制、移动函数
+    unordered_set() : ht_() {}
+
+    explicit unordered_set(size_type bucket_count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : ht_(bucket_count, hash, equal) {}
+
+    template <class InputIter, typename std::enable_if<mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+    unordered_set(InputIter first, InputIter last, size_type bucket_count = 0,
+                  const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : ht_(bucket_count, hash, equal) {
+        insert(first, last);
+    }
+
+    unordered_set(std::initializer_list<value_type> ilist, size_type bucket_count = 0,
+                  const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : ht_(bucket_count, hash, equal) {
+        ht_.reserve(ilist.size());
+        insert(ilist.begin(), ilist.end());
+    }
+
+    unordered_set(const unordered_set& rhs) : ht_(rhs.ht_) {}
+    unordered_set(unordered_set&& rhs) noexcept : ht_(mystl::move(rhs.ht_)) {}
+
+    unordered_set& operator=(const unordered_set& rhs) {
+        ht_ = rhs.ht_;
+        return *this;
+    }
+
+    unordered_set& operator=(unordered_set&& rhs) noexcept {
+        ht_ = mystl::move(rhs.ht_);
+        return *this;
+    }
+
+    unordered_set& operator=(std::initializer_list<value_type> ilist) {
+        ht_.clear();
+        ht_.reserve(ilist.size());
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~unordered_set() = default;
+
+    // 迭代器相关操作
+    const_iterator begin() const noexcept { return ht_.begin(); }
+    const_iterator end() const noexcept { return ht_.end(); }
+
+    const_iterator cbegin() const noexcept { return ht_.cbegin(); }
+    const_iterator cend() const noexcept { return ht_.cend(); }
+
+    // 容量相关操作
+    bool      empty() const noexcept { return ht_.empty(); }
+    size_type size() const noexcept { return ht_.size(); }
+    size_type max_size() const noexcept { return ht_.max_size(); }
+
+    // 修改容器相关操作
+    template <class... Args>
+    mystl::pair<iterator, bool> emplace(Args&&... args) {
+        const auto result = ht_.emplace_unique(mystl::forward<Args>(args)...);
+        return mystl::pair<iterator, bool>(result.first, result.second);
+    }
+
+    mystl::pair<iterator, bool> insert(const value_type& value) {
+        const auto result = ht_.insert_unique(value);
+        return mystl::pair<iterator, bool>(result.first, result.second);
+    }
+
+    mystl::pair<iterator, bool> insert(value_type&& value) {
+        const auto result = ht_.insert_unique(mystl::move(value));
+        return mystl::pair<iterator, bool>(result.first, result.second);
+    }
+
+    template <class InputIter>
+    void insert(InputIter first, InputIter last) { ht_.insert_unique(first, last); }
+
+    void insert(std::initializer_list<value_type> ilist) { ht_.insert_unique(ilist.begin(), ilist.end()); }
+
+    iterator erase(const_iterator pos) { return ht_.erase(pos); }
+    iterator erase(const_iterator first, const_iterator last) { return ht_.erase(first, last); }
+    size_type erase(const key_type& key) { return ht_.erase_unique(key); }
+
+    void clear() { ht_.clear(); }
+
+    void swap(unordered_set& rhs) noexcept { ht_.swap(rhs.ht_); }
+
+    // 查找相关操作
+    const_iterator find(const key_type& key) const { return ht_.find(key); }
+
+    size_type count(const key_type& key) const { return ht_.count_unique(key); }
+    bool contains(const key_type& key) const { return ht_.find(key) != ht_.end(); }
+
+    mystl::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return ht_.equal_range(key);
+    }
+
+    // 桶接口
+    const_local_iterator begin(size_type n) const noexcept { return ht_.begin(n); }
+    const_local_iterator end(size_type n) const noexcept { return ht_.end(n); }
+
+    const_local_iterator cbegin(size_type n) const noexcept { return ht_.cbegin(n); }
+    const_local_iterator cend(size_type n) const noexcept { return ht_.cend(n); }
+
+    size_type bucket_count() const noexcept { return ht_.bucket_count(); }
+    size_type max_bucket_count() const noexcept { return ht_.max_bucket_count(); }
+    size_type bucket_size(size_type n) const noexcept { return ht_.bucket_size(n); }
+    size_type bucket(const key_type& key) const { return ht_.bucket(key); }
+
+    // 哈希策略
+    float load_factor() const noexcept { return ht_.load_factor(); }
+    float max_load_factor() const noexcept { return ht_.max_load_factor(); }
+    void max_load_factor(float ml) { ht_.max_load_factor(ml); }
+
+    void rehash(size_type count) { ht_.rehash(count); }
+    void reserve(size_type count) { ht_.reserve(count); }
+
+    hasher hash_function() const { return ht_.hash_function(); }
+    key_equal key_eq() const { return ht_.key_eq(); }
+
+public:
+    friend bool operator==(const unordered_set& lhs, const unordered_set& rhs) {
+        return lhs.ht_.equal_unique(rhs.ht_);
+    }
+
+    friend bool operator!=(const unordered_set& lhs, const unordered_set& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+// 重载 mystl 的 swap
+template <class Key, class Hash, class KeyEqual>
+void swap(unordered_set<Key, Hash, KeyEqual>& lhs, unordered_set<Key, Hash, KeyEqual>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+
+// 模板类 unordered_multiset
+// 参数与 unordered_set 相同，插入总是成功，新元素放在与它相等的元素之前
+template <class Key, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+class unordered_multiset {
+private:
+    typedef hashtable<Key, Key, mystl::identity<Key>, Hash, KeyEqual> base_type;
+
+    base_type ht_;
+
+public:
+    typedef typename base_type::allocator_type          allocator_type;
+    typedef typename base_type::key_type                key_type;
+    typedef typename base_type::value_type              value_type;
+    typedef typename base_type::hasher                  hasher;
+    typedef typename base_type::key_equal               key_equal;
+
+    typedef typename base_type::size_type               size_type;
+    typedef typename base_type::difference_type         difference_type;
+    typedef typename base_type::const_pointer           pointer;
+    typedef typename base_type::const_pointer           const_pointer;
+    typedef typename base_type::const_reference         reference;
+    typedef typename base_type::const_reference         const_reference;
+
+    typedef typename base_type::const_iterator          iterator;
+    typedef typename base_type::const_iterator          const_iterator;
+    typedef typename base_type::const_local_iterator    local_iterator;
+    typedef typename base_type::const_local_iterator    const_local_iterator;
+
+    allocator_type get_allocator() const { return ht_.get_allocator(); }
+
+public:
+    // 构造、复制、移动函数
+    unordered_multiset() : ht_() {}
+
+    explicit unordered_multiset(size_type bucket_count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : ht_(bucket_count, hash, equal) {}
+
+    template <class InputIter, typename std::enable_if<mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+    unordered_multiset(InputIter first, InputIter last, size_type bucket_count = 0,
+                       const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : ht_(bucket_count, hash, equal) {
+        insert(first, last);
+    }
+
+    unordered_multiset(std::initializer_list<value_type> ilist, size_type bucket_count = 0,
+                       const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : ht_(bucket_count, hash, equal) {
+        ht_.reserve(ilist.size());
+        insert(ilist.begin(), ilist.end());
+    }
+
+    unordered_multiset(const unordered_multiset& rhs) : ht_(rhs.ht_) {}
+    unordered_multiset(unordered_multiset&& rhs) noexcept : ht_(mystl::move(rhs.ht_)) {}
+
+    unordered_multiset& operator=(const unordered_multiset& rhs) {
+        ht_ = rhs.ht_;
+        return *this;
+    }
+
+    unordered_multiset& operator=(unordered_multiset&& rhs) noexcept {
+        ht_ = mystl::move(rhs.ht_);
+        return *this;
+    }
+
+    unordered_multiset& operator=(std::initializer_list<value_type> ilist) {
+        ht_.clear();
+        ht_.reserve(ilist.size());
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~unordered_multiset() = default;
+
+    // 迭代器相关操作
+    const_iterator begin() const noexcept { return ht_.begin(); }
+    const_iterator end() const noexcept { return ht_.end(); }
+
+    const_iterator cbegin() const noexcept { return ht_.cbegin(); }
+    const_iterator cend() const noexcept { return ht_.cend(); }
+
+    // 容量相关操作
+    bool      empty() const noexcept { return ht_.empty(); }
+    size_type size() const noexcept { return ht_.size(); }
+    size_type max_size() const noexcept { return ht_.max_size(); }
+
+    // 修改容器相关操作
+    template <class... Args>
+    iterator emplace(Args&&... args) {
+        return ht_.emplace_multi(mystl::forward<Args>(args)...);
+    }
+
+    iterator insert(const value_type& value) { return ht_.insert_multi(value); }
+    iterator insert(value_type&& value) { return ht_.insert_multi(mystl::move(value)); }
+
+    template <class InputIter>
+    void insert(InputIter first, InputIter last) { ht_.insert_multi(first, last); }
+
+    void insert(std::initializer_list<value_type> ilist) { ht_.insert_multi(ilist.begin(), ilist.end()); }
+
+    iterator erase(const_iterator pos) { return ht_.erase(pos); }
+    iterator erase(const_iterator first, const_iterator last) { return ht_.erase(first, last); }
+    size_type erase(const key_type& key) { return ht_.erase_multi(key); }
+
+    void clear() { ht_.clear(); }
+
+    void swap(unordered_multiset& rhs) noexcept { ht_.swap(rhs.ht_); }
+
+    // 查找相关操作
+    const_iterator find(const key_type& key) const { return ht_.find(key); }
+
+    size_type count(const key_type& key) const { return ht_.count_multi(key); }
+    bool contains(const key_type& key) const { return ht_.find(key) != ht_.end(); }
+
+    mystl::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return ht_.equal_range(key);
+    }
+
+    // 桶接口
+    const_local_iterator begin(size_type n) const noexcept { return ht_.begin(n); }
+    const_local_iterator end(size_type n) const noexcept { return ht_.end(n); }
+
+    const_local_iterator cbegin(size_type n) const noexcept { return ht_.cbegin(n); }
+    const_local_iterator cend(size_type n) const noexcept { return ht_.cend(n); }
+
+    size_type bucket_count() const noexcept { return ht_.bucket_count(); }
+    size_type max_bucket_count() const noexcept { return ht_.max_bucket_count(); }
+    size_type bucket_size(size_type n) const noexcept { return ht_.bucket_size(n); }
+    size_type bucket(const key_type& key) const { return ht_.bucket(key); }
+
+    // 哈希策略
+    float load_factor() const noexcept { return ht_.load_factor(); }
+    float max_load_factor() const noexcept { return ht_.max_load_factor(); }
+    void max_load_factor(float ml) { ht_.max_load_factor(ml); }
+
+    void rehash(size_type count) { ht_.rehash(count); }
+    void reserve(size_type count) { ht_.reserve(count); }
+
+    hasher hash_function() const { return ht_.hash_function(); }
+    key_equal key_eq() const { return ht_.key_eq(); }
+
+public:
+    friend bool operator==(const unordered_multiset& lhs, const unordered_multiset& rhs) {
+        return lhs.ht_.equal_multi(rhs.ht_);
+    }
+
+    friend bool operator!=(const unordered_multiset& lhs, const unordered_multiset& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+// 重载 mystl 的 swap
+template <class Key, class Hash, class KeyEqual>
+void swap(unordered_multiset<Key, Hash, KeyEqual>& lhs, unordered_multiset<Key, Hash, KeyEqual>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // end namespace mystl
+
+#endif // MINITURE_STL_UNORDERED_SET_HPP_
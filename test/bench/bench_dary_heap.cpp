@@ -0,0 +1,103 @@
+// d 叉堆与二叉堆的对比：建堆、逐个弹出，以及优先队列式的交替 push/pop
+// 用法：bench_dary_heap [元素个数 ...]，缺省覆盖放得进 L2 与远大于 L3 的几种规模
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "03_algorithms/heap_algo.h"
+
+namespace
+{
+
+typedef std::chrono::steady_clock bench_clock;
+
+double elapsed_ms(bench_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+// Arity 为 0 表示 mystl 原有的二叉堆
+template <size_t Arity>
+struct heap_ops
+{
+    static void make(uint64_t* f, uint64_t* l) { mystl::make_heap<Arity>(f, l); }
+    static void push(uint64_t* f, uint64_t* l) { mystl::push_heap<Arity>(f, l); }
+    static void pop(uint64_t* f, uint64_t* l) { mystl::pop_heap<Arity>(f, l); }
+};
+
+template <>
+struct heap_ops<0>
+{
+    static void make(uint64_t* f, uint64_t* l) { mystl::make_heap(f, l); }
+    static void push(uint64_t* f, uint64_t* l) { mystl::push_heap(f, l); }
+    static void pop(uint64_t* f, uint64_t* l) { mystl::pop_heap(f, l); }
+};
+
+template <size_t Arity>
+void run(const char* name, const std::vector<uint64_t>& input)
+{
+    typedef heap_ops<Arity> ops;
+    std::vector<uint64_t> h = input;
+    uint64_t* first = h.data();
+    const size_t n = h.size();
+
+    auto start = bench_clock::now();
+    ops::make(first, first + n);
+    const double make_ms = elapsed_ms(start);
+
+    // 优先队列式的用法：弹出最大者，再放入一个随机的新元素，堆的大小不变
+    start = bench_clock::now();
+    std::mt19937_64 rng(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        ops::pop(first, first + n);
+        first[n - 1] = rng() >> 8;
+        ops::push(first, first + n);
+    }
+    const double update_ms = elapsed_ms(start);
+
+    start = bench_clock::now();
+    for (size_t len = n; len > 1; --len)
+    {
+        ops::pop(first, first + len);
+    }
+    const double drain_ms = elapsed_ms(start);
+
+    std::printf("%11zu %8s %10.2f %12.2f %11.2f%s\n", n, name, make_ms, update_ms, drain_ms,
+                std::is_sorted(h.begin(), h.end()) ? "" : "  NOT SORTED");
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i)
+    {
+        sizes.push_back(static_cast<size_t>(std::strtoull(argv[i], nullptr, 10)));
+    }
+    if (sizes.empty())
+    {
+        sizes = {10000, 1000000, 10000000};
+    }
+    std::printf("%11s %8s %10s %12s %11s\n", "n", "arity", "make(ms)", "pop+push(ms)", "drain(ms)");
+    for (size_t n : sizes)
+    {
+        std::mt19937_64 rng(n);
+        std::vector<uint64_t> input(n);
+        for (auto& x : input)
+        {
+            x = rng() >> 8;
+        }
+        run<0>("binary", input);
+        run<2>("2", input);
+        run<4>("4", input);
+        run<8>("8", input);
+    }
+    return 0;
+}
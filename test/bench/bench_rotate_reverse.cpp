@@ -0,0 +1,84 @@
+// 平凡可复制数组上 mystl::rotate / mystl::reverse 与 std::rotate / std::reverse 的对比
+// 用法：bench_rotate_reverse [字节数 ...]，rotate 的分割点分别取长度的 1/3 与只差几个元素的位置
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+#include "03_algorithms/algo.h"
+
+namespace
+{
+
+typedef std::chrono::steady_clock bench_clock;
+
+double elapsed_us(bench_clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(bench_clock::now() - start).count();
+}
+
+// 重复 reps 次取平均，每次都在上一次的结果上继续操作
+template <class Func>
+double time_us(size_t reps, Func f)
+{
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < reps; ++i)
+    {
+        f();
+    }
+    return elapsed_us(start) / reps;
+}
+
+template <class Type>
+void run(const char* type_name, size_t bytes)
+{
+    const size_t n = bytes / sizeof(Type);
+    const size_t reps = std::max<size_t>(1, (size_t(64) << 20) / bytes);
+    std::vector<Type> a(n), b(n);
+    std::iota(a.begin(), a.end(), Type(0));
+    b = a;
+    Type* pa = a.data();
+    Type* pb = b.data();
+
+    const double std_rev = time_us(reps, [&]() { std::reverse(pa, pa + n); });
+    const double my_rev = time_us(reps, [&]() { mystl::reverse(pb, pb + n); });
+    const bool same_rev = a == b;
+
+    const size_t third = n / 3;
+    const double std_rot = time_us(reps, [&]() { std::rotate(pa, pa + third, pa + n); });
+    const double my_rot = time_us(reps, [&]() { mystl::rotate(pb, pb + third, pb + n); });
+    const size_t near = n > 7 ? n - 7 : n;
+    const double std_rot7 = time_us(reps, [&]() { std::rotate(pa, pa + near, pa + n); });
+    const double my_rot7 = time_us(reps, [&]() { mystl::rotate(pb, pb + near, pb + n); });
+
+    std::printf("%11zu %9s %10.1f %10.1f %11.1f %11.1f %11.1f %11.1f%s\n", bytes, type_name, std_rev, my_rev,
+                std_rot, my_rot, std_rot7, my_rot7, same_rev && a == b ? "" : "  MISMATCH");
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i)
+    {
+        sizes.push_back(static_cast<size_t>(std::strtoull(argv[i], nullptr, 10)));
+    }
+    if (sizes.empty())
+    {
+        sizes = {size_t(32) << 10, size_t(1) << 20, size_t(32) << 20};
+    }
+    std::printf("%11s %9s %10s %10s %11s %11s %11s %11s   (us)\n", "bytes", "type", "std::rev", "mystl::rev",
+                "std::rot/3", "mystl::rot/3", "std::rot-7", "mystl::rot-7");
+    for (size_t bytes : sizes)
+    {
+        run<uint8_t>("uint8", bytes);
+        run<uint32_t>("uint32", bytes);
+        run<uint64_t>("uint64", bytes);
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+// static_search_index 的构建开销与查询吞吐量，对比在有序数组上的 std::lower_bound
+// 用法：bench_static_search_index [元素个数 ...]，缺省覆盖从 L1 到远大于 L3 的几种规模
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "04_containers/static_search_index.hpp"
+
+namespace
+{
+
+typedef std::chrono::steady_clock bench_clock;
+
+double elapsed_ns(bench_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count();
+}
+
+void run(size_t n, size_t queries)
+{
+    std::mt19937_64 rng(n);
+    std::vector<uint32_t> data(n);
+    for (auto& x : data)
+    {
+        x = static_cast<uint32_t>(rng());
+    }
+    std::sort(data.begin(), data.end());
+    std::vector<uint32_t> keys(queries);
+    for (auto& x : keys)
+    {
+        x = static_cast<uint32_t>(rng());
+    }
+
+    auto start = bench_clock::now();
+    mystl::static_search_index<uint32_t> index(data.data(), data.data() + n);
+    const double build = elapsed_ns(start);
+
+    size_t sum_std = 0, sum_index = 0;
+    start = bench_clock::now();
+    for (uint32_t q : keys)
+    {
+        sum_std += static_cast<size_t>(std::lower_bound(data.begin(), data.end(), q) - data.begin());
+    }
+    const double std_ns = elapsed_ns(start) / queries;
+
+    start = bench_clock::now();
+    for (uint32_t q : keys)
+    {
+        sum_index += index.lower_bound(q);
+    }
+    const double index_ns = elapsed_ns(start) / queries;
+
+    // 构建开销折合成多少次查询的节省才能收回
+    const double saved = std_ns - index_ns;
+    std::printf("%11zu %12.2f %14.2f %14.2f %16.0f%s\n", n, build / 1e6, std_ns, index_ns,
+                saved > 0 ? build / saved : -1.0, sum_std == sum_index ? "" : "  MISMATCH");
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i)
+    {
+        sizes.push_back(static_cast<size_t>(std::strtoull(argv[i], nullptr, 10)));
+    }
+    if (sizes.empty())
+    {
+        sizes = {1000, 100000, 1000000, 10000000, 100000000};
+    }
+    std::printf("%11s %12s %14s %14s %16s\n", "n", "build(ms)", "std(ns/query)", "index(ns/query)", "break-even");
+    for (size_t n : sizes)
+    {
+        run(n, 2000000);
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+// static_sort 与 std::sort、mystl::sort 在大量定长小数组上的对比
+// 用法：bench_static_sort [数组个数]，每种长度分别排序同样多的随机数组
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "03_algorithms/algo.h"
+#include "03_algorithms/static_sort.h"
+
+namespace
+{
+
+typedef std::chrono::steady_clock bench_clock;
+
+double elapsed_ns(bench_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count();
+}
+
+template <size_t N, class Type>
+void run(const char* type_name, size_t arrays)
+{
+    std::mt19937_64 rng(N);
+    std::vector<Type> input(N * arrays);
+    for (auto& x : input)
+    {
+        x = static_cast<Type>(rng() % 1000000);
+    }
+
+    std::vector<Type> a = input;
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < arrays; ++i)
+    {
+        std::sort(a.data() + i * N, a.data() + (i + 1) * N);
+    }
+    const double std_ns = elapsed_ns(start) / arrays;
+
+    std::vector<Type> b = input;
+    start = bench_clock::now();
+    for (size_t i = 0; i < arrays; ++i)
+    {
+        mystl::sort(b.data() + i * N, b.data() + (i + 1) * N);
+    }
+    const double mystl_ns = elapsed_ns(start) / arrays;
+
+    std::vector<Type> c = input;
+    start = bench_clock::now();
+    for (size_t i = 0; i < arrays; ++i)
+    {
+        mystl::static_sort<N>(c.data() + i * N);
+    }
+    const double static_ns = elapsed_ns(start) / arrays;
+
+    std::printf("%4zu %8s %12.1f %12.1f %12.1f%s\n", N, type_name, std_ns, mystl_ns, static_ns,
+                a == b && a == c ? "" : "  MISMATCH");
+}
+
+template <class Type>
+void run_all(const char* type_name, size_t arrays)
+{
+    run<4, Type>(type_name, arrays);
+    run<8, Type>(type_name, arrays);
+    run<12, Type>(type_name, arrays);
+    run<16, Type>(type_name, arrays);
+    run<24, Type>(type_name, arrays);
+    run<32, Type>(type_name, arrays);
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t arrays = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+    std::printf("%4s %8s %12s %12s %12s   (ns per array)\n", "N", "type", "std::sort", "mystl::sort", "static_sort");
+    run_all<int>("int", arrays);
+    run_all<double>("double", arrays);
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "04_containers/concurrent_hash_map.hpp"
+#include "unit_test.h"
+
+// 单线程下随机操作，与 std::unordered_map 逐步比较
+MYSTL_TEST(concurrent_hash_map_random_ops)
+{
+    std::mt19937 rng(47);
+    mystl::concurrent_hash_map<int, long> m(2);
+    std::unordered_map<int, long> ref;
+    bool ok = true;
+    for (int step = 0; step < 200000; ++step)
+    {
+        const int key = static_cast<int>(rng() % 5000);
+        const long value = static_cast<long>(rng());
+        switch (rng() % 6)
+        {
+        case 0:
+            ok = ok && m.insert(key, value) == ref.emplace(key, value).second;
+            break;
+        case 1:
+        {
+            const bool inserted = ref.find(key) == ref.end();
+            ref[key] = value;
+            ok = ok && m.insert_or_assign(key, value) == inserted;
+            break;
+        }
+        case 2:
+        {
+            const bool inserted = ref.find(key) == ref.end();
+            ref[key] += 3;
+            ok = ok && m.compute(key, [](long& v) { v += 3; }) == inserted;
+            break;
+        }
+        case 3:
+            ok = ok && m.erase(key) == ref.erase(key);
+            break;
+        case 4:
+        {
+            long v = 0;
+            const auto it = ref.find(key);
+            ok = ok && m.find(key, v) == (it != ref.end()) && (it == ref.end() || v == it->second);
+            break;
+        }
+        default:
+            ok = ok && m.contains(key) == (ref.count(key) != 0);
+            break;
+        }
+        ok = ok && m.size() == ref.size();
+    }
+    EXPECT_TRUE(ok);
+
+    size_t visited = 0;
+    m.for_each([&](int k, long v) {
+        ++visited;
+        ok = ok && ref.at(k) == v;
+    });
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(visited, ref.size());
+    m.clear();
+    EXPECT_TRUE(m.empty());
+}
+
+// 多个线程各自插入互不相交的键，同时对共享的计数器做 compute，最后核对全部结果
+MYSTL_TEST(concurrent_hash_map_threads)
+{
+    const int threads = 4;
+    const int per_thread = 20480;
+    const int counters = 64;
+    mystl::concurrent_hash_map<int, long> m(threads);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([&m, t]() {
+            for (int i = 0; i < per_thread; ++i)
+            {
+                m.insert(counters + t * per_thread + i, i);
+                m.compute(i % counters, [](long& v) { ++v; });
+                long v = 0;
+                if (m.find(counters + t * per_thread + i / 2, v) && v != i / 2)
+                {
+                    m.insert_or_assign(-1, 1L);
+                }
+            }
+        });
+    }
+    for (auto& th : pool)
+    {
+        th.join();
+    }
+    EXPECT_TRUE(!m.contains(-1));
+    EXPECT_EQ(m.size(), static_cast<size_t>(counters + threads * per_thread));
+    bool ok = true;
+    for (int c = 0; c < counters; ++c)
+    {
+        long v = 0;
+        ok = ok && m.find(c, v) && v == threads * per_thread / counters;
+    }
+    for (int t = 0; t < threads; ++t)
+    {
+        for (int i = 0; i < per_thread; ++i)
+        {
+            long v = -1;
+            ok = ok && m.find(counters + t * per_thread + i, v) && v == i;
+        }
+    }
+    EXPECT_TRUE(ok);
+}
@@ -0,0 +1,207 @@
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "04_containers/basic_string.hpp"
+#include "04_containers/flat_hash_map.hpp"
+#include "04_containers/flat_hash_set.hpp"
+#include "unit_test.h"
+
+namespace
+{
+
+struct int_key
+{
+    static int make(int k) { return k; }
+};
+
+// 不可平凡复制的键，覆盖元素的移动与析构
+struct string_key
+{
+    static mystl::basic_string<char> make(int k) { return mystl::basic_string<char>(std::to_string(k).c_str()); }
+};
+
+// 内容与 ref 完全相同：大小一致，遍历到的每个元素都在 ref 中且映射值相同
+template <class Map, class KeyMaker>
+bool same_content(const Map& m, const std::unordered_map<int, long>& ref)
+{
+    if (m.size() != ref.size())
+    {
+        return false;
+    }
+    size_t visited = 0;
+    for (auto it = m.begin(); it != m.end(); ++it)
+    {
+        ++visited;
+    }
+    if (visited != ref.size())
+    {
+        return false;
+    }
+    for (const auto& kv : ref)
+    {
+        auto it = m.find(KeyMaker::make(kv.first));
+        if (it == m.end() || it->second != kv.second)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 随机插入、赋值、删除与查找，期间穿插 rehash、reserve、拷贝、移动与 swap，每一步后与 std::unordered_map 比较
+template <class Map, class KeyMaker>
+bool check_random_ops(unsigned seed)
+{
+    std::mt19937 rng(seed);
+    Map m;
+    std::unordered_map<int, long> ref;
+    bool ok = true;
+    for (int step = 0; step < 30000 && ok; ++step)
+    {
+        const int k = static_cast<int>(rng() % 2000);
+        const long v = static_cast<long>(rng() % 1000);
+        switch (rng() % 12)
+        {
+        case 0:
+            ok = m.insert(mystl::make_pair(KeyMaker::make(k), v)).second == ref.emplace(k, v).second;
+            break;
+        case 1:
+            ok = m.emplace(KeyMaker::make(k), v).second == ref.emplace(k, v).second;
+            break;
+        case 2:
+            ok = m.try_emplace(KeyMaker::make(k), v).second == ref.emplace(k, v).second;
+            break;
+        case 3:
+        {
+            const bool inserted = ref.find(k) == ref.end();
+            ref[k] = v;
+            ok = m.insert_or_assign(KeyMaker::make(k), v).second == inserted;
+            break;
+        }
+        case 4:
+            m[KeyMaker::make(k)] += v;
+            ref[k] += v;
+            break;
+        case 5:
+            ok = m.erase(KeyMaker::make(k)) == ref.erase(k);
+            break;
+        case 6:
+        {
+            auto it = m.find(KeyMaker::make(k));
+            ok = (it != m.end()) == (ref.count(k) != 0);
+            if (it != m.end())
+            {
+                m.erase(it);
+                ref.erase(k);
+            }
+            break;
+        }
+        case 7:
+            ok = m.count(KeyMaker::make(k)) == ref.count(k) && m.contains(KeyMaker::make(k)) == (ref.count(k) != 0);
+            break;
+        case 8:
+            if (rng() % 100 == 0)
+            {
+                m.rehash(rng() % 2 == 0 ? 0 : rng() % 8192);
+            }
+            else if (rng() % 100 == 0)
+            {
+                m.reserve(rng() % 4096);
+            }
+            break;
+        case 9:
+            if (rng() % 200 == 0)
+            {
+                Map copy(m);
+                ok = same_content<Map, KeyMaker>(copy, ref);
+                Map moved(mystl::move(copy));
+                ok = ok && same_content<Map, KeyMaker>(moved, ref) && copy.empty();
+                m.clear();
+                m = moved;
+                ok = ok && m == moved;
+            }
+            break;
+        case 10:
+            if (rng() % 200 == 0)
+            {
+                Map other;
+                other.swap(m);
+                ok = m.empty() && same_content<Map, KeyMaker>(other, ref);
+                m = mystl::move(other);
+            }
+            break;
+        default:
+            if (rng() % 2000 == 0)
+            {
+                m.clear();
+                ref.clear();
+            }
+            break;
+        }
+        ok = ok && m.size() == ref.size();
+        if (step % 1000 == 0)
+        {
+            ok = ok && same_content<Map, KeyMaker>(m, ref);
+        }
+    }
+    return ok && same_content<Map, KeyMaker>(m, ref);
+}
+
+}  // namespace
+
+MYSTL_TEST(flat_hash_map_random_ops)
+{
+    EXPECT_TRUE((check_random_ops<mystl::flat_hash_map<int, long>, int_key>(45)));
+    EXPECT_TRUE((check_random_ops<mystl::flat_hash_map<mystl::basic_string<char>, long>, string_key>(450)));
+}
+
+MYSTL_TEST(flat_hash_map_at_throws)
+{
+    mystl::flat_hash_map<int, long> m = {{1, 10}, {2, 20}};
+    EXPECT_EQ(m.at(2), 20);
+    bool thrown = false;
+    try
+    {
+        m.at(3);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+}
+
+MYSTL_TEST(flat_hash_set_random_ops)
+{
+    std::mt19937 rng(4500);
+    mystl::flat_hash_set<int> s;
+    std::unordered_set<int> ref;
+    bool ok = true;
+    for (int step = 0; step < 30000; ++step)
+    {
+        const int k = static_cast<int>(rng() % 3000);
+        switch (rng() % 3)
+        {
+        case 0:
+            ok = ok && s.insert(k).second == ref.insert(k).second;
+            break;
+        case 1:
+            ok = ok && s.erase(k) == ref.erase(k);
+            break;
+        default:
+            ok = ok && s.contains(k) == (ref.count(k) != 0);
+            break;
+        }
+        ok = ok && s.size() == ref.size();
+    }
+    size_t visited = 0;
+    for (auto it = s.begin(); it != s.end(); ++it)
+    {
+        ok = ok && ref.count(*it) != 0;
+        ++visited;
+    }
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(visited, ref.size());
+}
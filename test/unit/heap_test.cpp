@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "03_algorithms/heap_algo.h"
+#include "unit_test.h"
+
+namespace
+{
+
+// 每个节点都不小于它的 Arity 个子节点
+template <size_t Arity, class Compare>
+bool is_dary_heap(const std::vector<int>& v, size_t len, Compare comp)
+{
+    for (size_t i = 1; i < len; ++i)
+    {
+        if (comp(v[(i - 1) / Arity], v[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <size_t Arity, class Compare>
+bool check_dary_heap(std::mt19937& rng, Compare comp)
+{
+    bool ok = true;
+    for (size_t n = 0; n < 200; ++n)
+    {
+        std::vector<int> v(n);
+        for (auto& x : v)
+        {
+            x = static_cast<int>(rng() % (n + 1));
+        }
+        std::vector<int> sorted = v;
+        std::sort(sorted.begin(), sorted.end(), comp);
+
+        // make_heap 后逐个 pop_heap，依次弹出的是剩余元素中的最大者
+        std::vector<int> h = v;
+        mystl::make_heap<Arity>(h.data(), h.data() + n, comp);
+        ok = ok && is_dary_heap<Arity>(h, n, comp);
+        for (size_t len = n; len > 0; --len)
+        {
+            mystl::pop_heap<Arity>(h.data(), h.data() + len, comp);
+            ok = ok && h[len - 1] == sorted[len - 1] && is_dary_heap<Arity>(h, len - 1, comp);
+        }
+
+        // 逐个 push_heap 建堆，再 sort_heap
+        h = v;
+        for (size_t len = 1; len <= n; ++len)
+        {
+            mystl::push_heap<Arity>(h.data(), h.data() + len, comp);
+            ok = ok && is_dary_heap<Arity>(h, len, comp);
+        }
+        mystl::sort_heap<Arity>(h.data(), h.data() + n, comp);
+        ok = ok && h == sorted;
+    }
+    return ok;
+}
+
+}  // namespace
+
+MYSTL_TEST(dary_heap_matches_sorted_order)
+{
+    std::mt19937 rng(38);
+    EXPECT_TRUE(check_dary_heap<2>(rng, std::less<int>()));
+    EXPECT_TRUE(check_dary_heap<3>(rng, std::less<int>()));
+    EXPECT_TRUE(check_dary_heap<4>(rng, std::less<int>()));
+    EXPECT_TRUE(check_dary_heap<8>(rng, std::less<int>()));
+    EXPECT_TRUE(check_dary_heap<4>(rng, std::greater<int>()));
+}
+
+MYSTL_TEST(dary_heap_default_compare)
+{
+    std::vector<int> v = {5, 1, 9, 3, 7, 2, 8, 6, 4, 0};
+    mystl::make_heap<4>(v.data(), v.data() + v.size());
+    EXPECT_EQ(v[0], 9);
+    mystl::pop_heap<4>(v.data(), v.data() + v.size());
+    EXPECT_EQ(v.back(), 9);
+    EXPECT_EQ(v[0], 8);
+    v.back() = 11;
+    mystl::push_heap<4>(v.data(), v.data() + v.size());
+    EXPECT_EQ(v[0], 11);
+    mystl::sort_heap<4>(v.data(), v.data() + v.size());
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+}
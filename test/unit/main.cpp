@@ -0,0 +1,15 @@
+#include <cstdio>
+
+#include "unit_test.h"
+
+int main()
+{
+    for (const mystl_test::test_entry& t : mystl_test::registry())
+    {
+        const int before = mystl_test::failures();
+        t.fn();
+        std::printf("[%s] %s\n", mystl_test::failures() == before ? "  OK  " : "FAILED", t.name);
+    }
+    std::printf("%zu tests, %d failed checks\n", mystl_test::registry().size(), mystl_test::failures());
+    return mystl_test::failures() == 0 ? 0 : 1;
+}
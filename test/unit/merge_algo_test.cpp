@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "03_algorithms/merge_algo.h"
+#include "unit_test.h"
+
+namespace
+{
+
+// 只按 key 比较；id 记录元素来自哪一路的第几个，用来检查稳定性
+struct item
+{
+    int key;
+    int id;
+};
+
+struct counting_less
+{
+    long* calls;
+    bool operator()(const item& a, const item& b) const
+    {
+        ++*calls;
+        return a.key < b.key;
+    }
+};
+
+int ceil_log2(size_t k)
+{
+    int r = 0;
+    while ((static_cast<size_t>(1) << r) < k)
+    {
+        ++r;
+    }
+    return r;
+}
+
+}  // namespace
+
+// 各路按 key 归并，key 相同时按路号、路内顺序输出，每个输出元素至多 ceil(log2 k) 次比较
+MYSTL_TEST(merge_k_stable_and_comparison_count)
+{
+    std::mt19937 rng(28);
+    for (size_t k : {1, 2, 3, 4, 5, 8, 13, 16})
+    {
+        std::vector<std::vector<item>> runs(k);
+        std::vector<item> expected;
+        for (size_t r = 0; r < k; ++r)
+        {
+            const size_t n = 200 + rng() % 800;
+            for (size_t i = 0; i < n; ++i)
+            {
+                runs[r].push_back(item{static_cast<int>(rng() % 50), static_cast<int>(r * 100000 + i)});
+            }
+            std::stable_sort(runs[r].begin(), runs[r].end(),
+                             [](const item& a, const item& b) { return a.key < b.key; });
+            expected.insert(expected.end(), runs[r].begin(), runs[r].end());
+        }
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const item& a, const item& b) { return a.key < b.key; });
+
+        std::vector<mystl::pair<const item*, const item*>> ranges;
+        for (size_t r = 0; r < k; ++r)
+        {
+            ranges.push_back(mystl::pair<const item*, const item*>(runs[r].data(), runs[r].data() + runs[r].size()));
+        }
+        std::vector<item> out(expected.size());
+        long calls = 0;
+        item* end = mystl::merge_k(ranges.data(), ranges.data() + ranges.size(), out.data(), counting_less{&calls});
+
+        EXPECT_EQ(static_cast<size_t>(end - out.data()), expected.size());
+        bool same = true;
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            same = same && out[i].key == expected[i].key && out[i].id == expected[i].id;
+        }
+        EXPECT_TRUE(same);
+        // build 共 k - 1 场比赛，之后每个元素重赛一次
+        EXPECT_TRUE(calls <= static_cast<long>(k - 1 + expected.size() * ceil_log2(k)));
+    }
+}
+
+MYSTL_TEST(merge_k_empty_runs)
+{
+    std::vector<int> a = {1, 4, 9}, b, c = {2, 3, 10, 11};
+    mystl::pair<const int*, const int*> ranges[3] = {
+        mystl::pair<const int*, const int*>(a.data(), a.data() + a.size()),
+        mystl::pair<const int*, const int*>(b.data(), b.data()),
+        mystl::pair<const int*, const int*>(c.data(), c.data() + c.size())};
+    int out[7];
+    int* end = mystl::merge_k(ranges, ranges + 3, out);
+    EXPECT_EQ(end - out, 7);
+    EXPECT_TRUE(std::is_sorted(out, out + 7));
+}
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "03_algorithms/algo.h"
+#include "unit_test.h"
+
+namespace
+{
+
+struct is_odd
+{
+    template <class T>
+    bool operator()(const T& x) const { return x % 2 != 0; }
+};
+
+struct odd_length
+{
+    bool operator()(const std::string& s) const { return s.size() % 2 != 0; }
+};
+
+}  // namespace
+
+// 平凡可复制的元素走按块压缩的路径，长度覆盖块的边界
+MYSTL_TEST(copy_if_remove_if_match_std)
+{
+    std::mt19937 rng(36);
+    bool ok = true;
+    for (size_t n = 0; n < 300; ++n)
+    {
+        std::vector<int> v(n);
+        for (auto& x : v)
+        {
+            x = static_cast<int>(rng() % 100);
+        }
+        std::vector<int> a(n), b(n);
+        int* ea = mystl::copy_if(v.data(), v.data() + n, a.data(), is_odd());
+        auto eb = std::copy_if(v.begin(), v.end(), b.begin(), is_odd());
+        ok = ok && std::equal(a.data(), ea, b.begin(), eb);
+
+        ea = mystl::remove_copy_if(v.data(), v.data() + n, a.data(), is_odd());
+        eb = std::remove_copy_if(v.begin(), v.end(), b.begin(), is_odd());
+        ok = ok && std::equal(a.data(), ea, b.begin(), eb);
+
+        a = v;
+        b = v;
+        ea = mystl::remove_if(a.data(), a.data() + n, is_odd());
+        eb = std::remove_if(b.begin(), b.end(), is_odd());
+        ok = ok && std::equal(a.data(), ea, b.begin(), eb);
+    }
+    EXPECT_TRUE(ok);
+}
+
+MYSTL_TEST(partition_matches_std)
+{
+    std::mt19937 rng(360);
+    bool ok = true;
+    for (size_t n = 0; n < 300; ++n)
+    {
+        std::vector<int> v(n);
+        for (auto& x : v)
+        {
+            x = static_cast<int>(rng() % 100);
+        }
+        const long odd = std::count_if(v.begin(), v.end(), is_odd());
+
+        std::vector<int> a = v;
+        int* mid = mystl::partition(a.data(), a.data() + n, is_odd());
+        ok = ok && mid - a.data() == odd && std::is_partitioned(a.begin(), a.end(), is_odd());
+        ok = ok && std::is_permutation(a.begin(), a.end(), v.begin());
+
+        a = v;
+        std::vector<int> b = v;
+        mid = mystl::stable_partition(a.data(), a.data() + n, is_odd());
+        std::stable_partition(b.begin(), b.end(), is_odd());
+        ok = ok && mid - a.data() == odd && a == b;
+    }
+    EXPECT_TRUE(ok);
+}
+
+// 不可平凡复制的元素走逐个移动的路径
+MYSTL_TEST(partition_non_trivial_elements)
+{
+    std::mt19937 rng(3600);
+    bool ok = true;
+    for (size_t n = 0; n < 100; ++n)
+    {
+        std::vector<std::string> v(n);
+        for (auto& s : v)
+        {
+            s.assign(rng() % 40, static_cast<char>('a' + rng() % 26));
+        }
+        std::vector<std::string> a = v, b = v;
+        std::string* mid = mystl::stable_partition(a.data(), a.data() + n, odd_length());
+        auto bm = std::stable_partition(b.begin(), b.end(), odd_length());
+        ok = ok && mid - a.data() == bm - b.begin() && a == b;
+
+        a = v;
+        mid = mystl::partition(a.data(), a.data() + n, odd_length());
+        ok = ok && mid - a.data() == bm - b.begin() && std::is_partitioned(a.begin(), a.end(), odd_length());
+        ok = ok && std::is_permutation(a.begin(), a.end(), v.begin());
+    }
+    EXPECT_TRUE(ok);
+}
@@ -0,0 +1,40 @@
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "03_algorithms/algo.h"
+#include "unit_test.h"
+
+// 交换 seed 与 stream 必须得到不同的引擎
+MYSTL_TEST(parallel_shuffle_engine_streams_are_asymmetric)
+{
+    for (uint64_t a = 0; a < 8; ++a)
+    {
+        for (uint64_t b = a + 1; b < 8; ++b)
+        {
+            mystl::xoshiro256ss x = mystl::parallel_shuffle_engine(a, b);
+            mystl::xoshiro256ss y = mystl::parallel_shuffle_engine(b, a);
+            EXPECT_TRUE(x() != y());
+        }
+    }
+}
+
+MYSTL_TEST(parallel_shuffle_is_deterministic_permutation)
+{
+    for (size_t n : {0, 1, 7, 1000, 300000})
+    {
+        std::vector<unsigned> v(n), w;
+        std::iota(v.begin(), v.end(), 0u);
+        w = v;
+        mystl::parallel_shuffle(v.data(), v.data() + n, 33);
+        mystl::parallel_shuffle(w.data(), w.data() + n, 33);
+        EXPECT_TRUE(v == w);
+        std::sort(v.begin(), v.end());
+        bool perm = true;
+        for (size_t i = 0; i < n; ++i)
+        {
+            perm = perm && v[i] == i;
+        }
+        EXPECT_TRUE(perm);
+    }
+}
@@ -0,0 +1,110 @@
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "04_containers/static_map.hpp"
+#include "unit_test.h"
+
+namespace
+{
+
+constexpr mystl::pair<mystl::static_string, int> color_items[] = {
+    {"red", 1}, {"green", 2}, {"blue", 3}, {"cyan", 4}, {"magenta", 5}, {"yellow", 6},
+    {"black", 7}, {"white", 8}, {"", 9}, {"gray", 10}, {"grey", 11}, {"orange", 12},
+};
+
+constexpr auto colors = mystl::make_static_map(color_items);
+
+// 完美哈希在编译期求得，查找也可以在常量表达式中完成
+static_assert(colors.size() == 12, "size");
+static_assert(colors.at("red") == 1 && colors.at("orange") == 12, "at");
+static_assert(colors.at("") == 9, "empty key");
+static_assert(colors.contains("grey") && colors.contains("gray"), "contains");
+static_assert(!colors.contains("purple") && !colors.contains("re") && !colors.contains("redd"), "absent keys");
+static_assert(colors.find("purple") == nullptr && *colors.find("cyan") == 4, "find");
+static_assert(colors.value_or("purple", -1) == -1 && colors.value_or("white", -1) == 8, "value_or");
+static_assert(colors.index("purple") == colors.size(), "index of an absent key");
+
+// 较多的整数键，由 constexpr 函数生成
+const size_t IntKeyCount = 500;
+
+struct int_items
+{
+    mystl::pair<long, int> v[IntKeyCount];
+};
+
+constexpr int_items make_int_items()
+{
+    int_items r{};
+    for (size_t i = 0; i < IntKeyCount; ++i)
+    {
+        r.v[i].first = static_cast<long>(i * i * 7919 + 13);
+        r.v[i].second = static_cast<int>(i);
+    }
+    return r;
+}
+
+constexpr int_items int_source = make_int_items();
+constexpr auto squares = mystl::make_static_map(int_source.v);
+
+static_assert(squares.at(13) == 0 && squares.at(499L * 499 * 7919 + 13) == 499, "integer keys");
+static_assert(!squares.contains(14), "absent integer key");
+
+}  // namespace
+
+// 运行时的结果与常量求值相同，每个键占据 [0, N) 中不同的槽
+MYSTL_TEST(static_map_runtime_lookup)
+{
+    std::map<std::string, int> ref;
+    for (const auto& item : color_items)
+    {
+        ref[std::string(item.first.data(), item.first.size())] = item.second;
+    }
+    std::vector<bool> used(colors.size());
+    bool ok = true;
+    for (const auto& kv : ref)
+    {
+        const mystl::static_string key(kv.first.data(), kv.first.size());
+        const size_t slot = colors.index(key);
+        ok = ok && slot < colors.size() && !used[slot] && colors.at(key) == kv.second;
+        ok = ok && colors.key_at(slot) == key && colors.value_at(slot) == kv.second;
+        used[slot] = true;
+    }
+    EXPECT_TRUE(ok);
+
+    // 运行时拼出的字符串与字面量不共享存储
+    const std::string probes[] = {"purple", "blu", "bluee", "Red", "whitE", std::string(1, '\0')};
+    for (const auto& p : probes)
+    {
+        EXPECT_TRUE(!colors.contains(mystl::static_string(p.data(), p.size())));
+    }
+    const std::string blue = std::string("bl") + "ue";
+    EXPECT_EQ(colors.at(mystl::static_string(blue.data(), blue.size())), 3);
+
+    bool thrown = false;
+    try
+    {
+        colors.at("purple");
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+}
+
+MYSTL_TEST(static_map_integer_keys)
+{
+    std::vector<bool> used(IntKeyCount);
+    bool ok = true;
+    for (size_t i = 0; i < IntKeyCount; ++i)
+    {
+        const long key = static_cast<long>(i * i * 7919 + 13);
+        const size_t slot = squares.index(key);
+        ok = ok && slot < IntKeyCount && !used[slot] && squares.at(key) == static_cast<int>(i);
+        ok = ok && !squares.contains(key + 1);
+        used[slot] = true;
+    }
+    EXPECT_TRUE(ok);
+}
@@ -0,0 +1,47 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "04_containers/static_search_index.hpp"
+#include "unit_test.h"
+
+// 每种大小都覆盖最底层从只有一个叶子到排满的情况，查询值包括重复元素、两端之外与相邻元素之间
+MYSTL_TEST(static_search_index_matches_std_bounds)
+{
+    std::mt19937 rng(26);
+    for (size_t n = 0; n <= 300; ++n)
+    {
+        std::vector<int> v(n);
+        for (auto& x : v)
+        {
+            x = static_cast<int>(rng() % (n + 1)) * 2;
+        }
+        std::sort(v.begin(), v.end());
+        mystl::static_search_index<int> index(v.data(), v.data() + n);
+        EXPECT_EQ(index.size(), n);
+        bool ok = true;
+        for (int q = -1; q <= static_cast<int>(2 * n + 2); ++q)
+        {
+            const size_t lo = static_cast<size_t>(std::lower_bound(v.begin(), v.end(), q) - v.begin());
+            const size_t hi = static_cast<size_t>(std::upper_bound(v.begin(), v.end(), q) - v.begin());
+            ok = ok && index.lower_bound(q) == lo && index.upper_bound(q) == hi;
+            ok = ok && index.contains(q) == (lo != hi);
+            const int* p = index.find(q);
+            ok = ok && (lo == hi ? p == nullptr : p != nullptr && *p == q);
+        }
+        EXPECT_TRUE(ok);
+    }
+}
+
+MYSTL_TEST(static_search_index_move)
+{
+    std::vector<int> v = {1, 3, 5, 7, 9};
+    mystl::static_search_index<int> a(v.data(), v.data() + v.size());
+    mystl::static_search_index<int> b(std::move(a));
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(b.lower_bound(6), 3u);
+    a = std::move(b);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(a.upper_bound(9), 5u);
+    EXPECT_EQ(a.lower_bound(10), 5u);
+}
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "03_algorithms/static_sort.h"
+#include "unit_test.h"
+
+namespace
+{
+
+template <size_t N>
+bool check_static_sort(std::mt19937& rng)
+{
+    bool ok = true;
+
+    // 0-1 原理：排序网络能排好所有 0/1 序列就能排好任意序列，N <= 16 时穷举
+    if (N <= 16)
+    {
+        for (unsigned long bits = 0; bits < (1ul << N); ++bits)
+        {
+            int a[N];
+            for (size_t i = 0; i < N; ++i)
+            {
+                a[i] = static_cast<int>((bits >> i) & 1);
+            }
+            mystl::static_sort<N>(a);
+            ok = ok && std::is_sorted(a, a + N);
+        }
+    }
+
+    for (int trial = 0; trial < 200; ++trial)
+    {
+        std::vector<int> a(N);
+        std::vector<double> d(N);
+        std::vector<std::string> s(N);
+        for (size_t i = 0; i < N; ++i)
+        {
+            a[i] = static_cast<int>(rng() % 16);
+            d[i] = static_cast<double>(rng() % 1000) / 8 - 50;
+            s[i] = std::to_string(rng() % 100);
+        }
+        std::vector<int> ra = a, rg = a;
+        std::vector<double> rd = d;
+        std::vector<std::string> rs = s;
+        std::sort(ra.begin(), ra.end());
+        std::sort(rg.begin(), rg.end(), std::greater<int>());
+        std::sort(rd.begin(), rd.end());
+        std::sort(rs.begin(), rs.end());
+
+        std::vector<int> g = a;
+        mystl::static_sort<N>(a.data());
+        mystl::static_sort<N>(g.data(), mystl::greater<int>());
+        mystl::static_sort<N>(d.data());
+        mystl::static_sort<N>(s.data());
+        ok = ok && a == ra && g == rg && d == rd && s == rs;
+    }
+    return ok;
+}
+
+template <size_t N>
+struct check_up_to
+{
+    static bool run(std::mt19937& rng)
+    {
+        return check_up_to<N - 1>::run(rng) && check_static_sort<N>(rng);
+    }
+};
+
+template <>
+struct check_up_to<0>
+{
+    static bool run(std::mt19937&) { return true; }
+};
+
+}  // namespace
+
+// N = 1 ~ 32：整数、浮点数、反向比较与不可按字节复制的 std::string，结果与 std::sort 相同
+MYSTL_TEST(static_sort_matches_std_sort)
+{
+    std::mt19937 rng(40);
+    EXPECT_TRUE(check_up_to<32>::run(rng));
+}
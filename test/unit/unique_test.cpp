@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "03_algorithms/algo.h"
+#include "unit_test.h"
+
+namespace
+{
+
+// 只能比较大小，不能哈希：distinct 走排序的路径
+struct ordered_key
+{
+    int v;
+    bool operator==(const ordered_key& rhs) const { return v == rhs.v; }
+    bool operator<(const ordered_key& rhs) const { return v < rhs.v; }
+};
+
+// 只能判等：distinct 逐个比较
+struct equal_only_key
+{
+    int v;
+    bool operator==(const equal_only_key& rhs) const { return v == rhs.v; }
+};
+
+// 按第一次出现的次序保留不同的元素
+template <class T>
+std::vector<T> reference_distinct(const std::vector<T>& v)
+{
+    std::vector<T> out;
+    for (const T& x : v)
+    {
+        if (std::find(out.begin(), out.end(), x) == out.end())
+        {
+            out.push_back(x);
+        }
+    }
+    return out;
+}
+
+template <class T>
+bool check_distinct(const std::vector<T>& v)
+{
+    const std::vector<T> expected = reference_distinct(v);
+    std::vector<T> out(v.size());
+    T* end = mystl::distinct(v.data(), v.data() + v.size(), out.data());
+    out.resize(static_cast<size_t>(end - out.data()));
+    return out == expected;
+}
+
+}  // namespace
+
+MYSTL_TEST(unique_matches_std)
+{
+    std::mt19937 rng(37);
+    bool ok = true;
+    for (size_t n = 0; n < 300; ++n)
+    {
+        std::vector<int> v(n);
+        for (auto& x : v)
+        {
+            x = static_cast<int>(rng() % 4);
+        }
+        std::vector<int> a = v, b = v;
+        int* ea = mystl::unique(a.data(), a.data() + n);
+        auto eb = std::unique(b.begin(), b.end());
+        ok = ok && std::equal(a.data(), ea, b.begin(), eb);
+
+        std::vector<int> c(n), d(n);
+        ea = mystl::unique_copy(v.data(), v.data() + n, c.data());
+        eb = std::unique_copy(v.begin(), v.end(), d.begin());
+        ok = ok && std::equal(c.data(), ea, d.begin(), eb);
+
+        a = v;
+        b = v;
+        ea = mystl::sort_unique(a.data(), a.data() + n);
+        std::sort(b.begin(), b.end());
+        eb = std::unique(b.begin(), b.end());
+        ok = ok && std::equal(a.data(), ea, b.begin(), eb);
+    }
+    EXPECT_TRUE(ok);
+}
+
+MYSTL_TEST(unique_with_predicate)
+{
+    std::vector<int> v = {1, 2, 4, 5, 7, 8, 10, 13, 14};
+    // 相邻两数之差为 1 时视为重复
+    int* end = mystl::unique(v.data(), v.data() + v.size(), [](int a, int b) { return b - a == 1; });
+    EXPECT_EQ(end - v.data(), 5);
+    EXPECT_TRUE(std::vector<int>(v.data(), end) == std::vector<int>({1, 4, 7, 10, 13}));
+}
+
+// 长度跨过 DistinctLinearLimit，三种元素类型分别走哈希、排序与逐个比较的路径
+MYSTL_TEST(distinct_keeps_first_occurrence)
+{
+    std::mt19937 rng(370);
+    bool ok = true;
+    for (size_t n = 0; n < 200; ++n)
+    {
+        const unsigned range = 1 + rng() % 64;
+        std::vector<int> a(n);
+        std::vector<ordered_key> b(n);
+        std::vector<equal_only_key> c(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            a[i] = static_cast<int>(rng() % range);
+            b[i].v = a[i];
+            c[i].v = a[i];
+        }
+        ok = ok && check_distinct(a) && check_distinct(b) && check_distinct(c);
+    }
+    EXPECT_TRUE(ok);
+}
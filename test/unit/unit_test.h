@@ -0,0 +1,61 @@
+#ifndef MINIATURE_STL_UNIT_TEST_H
+#define MINIATURE_STL_UNIT_TEST_H
+
+// 单元测试使用的极简框架
+// MYSTL_TEST(name) 定义并注册一个测试函数，EXPECT_TRUE / EXPECT_EQ 失败时打印位置并记录，测试继续执行
+// 测试一般把 mystl 的结果与标准库的对应实现逐项比较
+
+#include <cstdio>
+#include <vector>
+
+namespace mystl_test
+{
+
+typedef void (*test_fn)();
+
+struct test_entry
+{
+    const char* name;
+    test_fn     fn;
+};
+
+inline std::vector<test_entry>& registry()
+{
+    static std::vector<test_entry> tests;
+    return tests;
+}
+
+inline int& failures()
+{
+    static int count = 0;
+    return count;
+}
+
+struct registrar
+{
+    registrar(const char* name, test_fn fn)
+    {
+        registry().push_back(test_entry{name, fn});
+    }
+};
+
+inline void report(const char* file, int line, const char* expr)
+{
+    ++failures();
+    std::printf("  FAILED %s:%d: %s\n", file, line, expr);
+}
+
+}  // namespace mystl_test
+
+#define MYSTL_TEST(name)                                                    \
+    static void name();                                                     \
+    static mystl_test::registrar name##_registrar(#name, &name);            \
+    static void name()
+
+#define EXPECT_TRUE(expr)                                                   \
+    do { if (!(expr)) mystl_test::report(__FILE__, __LINE__, #expr); } while (0)
+
+#define EXPECT_EQ(a, b)                                                     \
+    do { if (!((a) == (b))) mystl_test::report(__FILE__, __LINE__, #a " == " #b); } while (0)
+
+#endif  // MINIATURE_STL_UNIT_TEST_H
@@ -0,0 +1,285 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "04_containers/basic_string.hpp"
+#include "04_containers/unordered_map.hpp"
+#include "unit_test.h"
+
+namespace
+{
+
+struct int_key
+{
+    static int make(int k) { return k; }
+};
+
+// 不可平凡复制的键，覆盖节点的构造与析构
+struct string_key
+{
+    static mystl::basic_string<char> make(int k) { return mystl::basic_string<char>(std::to_string(k).c_str()); }
+};
+
+// 每个元素都能从所在的桶里找到，各桶大小之和等于 size
+template <class Map>
+bool buckets_consistent(const Map& m)
+{
+    size_t total = 0;
+    for (size_t b = 0; b < m.bucket_count(); ++b)
+    {
+        total += m.bucket_size(b);
+        for (auto it = m.begin(b); it != m.end(b); ++it)
+        {
+            if (m.bucket(it->first) != b)
+            {
+                return false;
+            }
+        }
+    }
+    return total == m.size();
+}
+
+template <class Map, class KeyMaker>
+bool same_content(const Map& m, const std::unordered_map<int, long>& ref)
+{
+    if (m.size() != ref.size() || static_cast<size_t>(mystl::distance(m.begin(), m.end())) != ref.size())
+    {
+        return false;
+    }
+    for (const auto& kv : ref)
+    {
+        auto it = m.find(KeyMaker::make(kv.first));
+        if (it == m.end() || it->second != kv.second)
+        {
+            return false;
+        }
+    }
+    return buckets_consistent(m);
+}
+
+// 随机操作，期间穿插 rehash、reserve、拷贝、移动与 swap，与 std::unordered_map 比较
+template <class Map, class KeyMaker>
+bool check_map_random_ops(unsigned seed)
+{
+    std::mt19937 rng(seed);
+    Map m;
+    std::unordered_map<int, long> ref;
+    bool ok = true;
+    for (int step = 0; step < 30000 && ok; ++step)
+    {
+        const int k = static_cast<int>(rng() % 2000);
+        const long v = static_cast<long>(rng() % 1000);
+        switch (rng() % 12)
+        {
+        case 0:
+            ok = m.insert(mystl::make_pair(KeyMaker::make(k), v)).second == ref.emplace(k, v).second;
+            break;
+        case 1:
+            ok = m.emplace(KeyMaker::make(k), v).second == ref.emplace(k, v).second;
+            break;
+        case 2:
+            ok = m.try_emplace(KeyMaker::make(k), v).second == ref.emplace(k, v).second;
+            break;
+        case 3:
+        {
+            const bool inserted = ref.find(k) == ref.end();
+            ref[k] = v;
+            ok = m.insert_or_assign(KeyMaker::make(k), v).second == inserted;
+            break;
+        }
+        case 4:
+            m[KeyMaker::make(k)] += v;
+            ref[k] += v;
+            break;
+        case 5:
+            ok = m.erase(KeyMaker::make(k)) == ref.erase(k);
+            break;
+        case 6:
+        {
+            auto it = m.find(KeyMaker::make(k));
+            ok = (it != m.end()) == (ref.count(k) != 0);
+            if (it != m.end())
+            {
+                m.erase(it);
+                ref.erase(k);
+            }
+            break;
+        }
+        case 7:
+        {
+            auto range = m.equal_range(KeyMaker::make(k));
+            ok = m.count(KeyMaker::make(k)) == ref.count(k) &&
+                 static_cast<size_t>(mystl::distance(range.first, range.second)) == ref.count(k);
+            break;
+        }
+        case 8:
+            if (rng() % 100 == 0)
+            {
+                m.rehash(rng() % 2 == 0 ? 0 : rng() % 8192);
+                ok = buckets_consistent(m);
+            }
+            else if (rng() % 100 == 0)
+            {
+                m.reserve(rng() % 4096);
+            }
+            break;
+        case 9:
+            if (rng() % 200 == 0)
+            {
+                Map copy(m);
+                ok = same_content<Map, KeyMaker>(copy, ref);
+                Map moved(mystl::move(copy));
+                ok = ok && same_content<Map, KeyMaker>(moved, ref) && copy.empty();
+                m.clear();
+                m = moved;
+                ok = ok && m == moved;
+            }
+            break;
+        case 10:
+            if (rng() % 200 == 0)
+            {
+                Map other;
+                other.swap(m);
+                ok = m.empty() && same_content<Map, KeyMaker>(other, ref);
+                m = mystl::move(other);
+            }
+            break;
+        default:
+            if (rng() % 2000 == 0)
+            {
+                m.clear();
+                ref.clear();
+            }
+            break;
+        }
+        ok = ok && m.size() == ref.size();
+        if (step % 1000 == 0)
+        {
+            ok = ok && same_content<Map, KeyMaker>(m, ref);
+        }
+    }
+    return ok && same_content<Map, KeyMaker>(m, ref);
+}
+
+// 键 k 对应的全部映射值，排序后比较
+template <class Map>
+std::vector<long> values_of(const Map& m, int k)
+{
+    std::vector<long> out;
+    auto range = m.equal_range(k);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        out.push_back(it->second);
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+std::vector<long> values_of(const std::unordered_multimap<int, long>& m, int k)
+{
+    std::vector<long> out;
+    auto range = m.equal_range(k);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        out.push_back(it->second);
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+bool same_multi_content(const mystl::unordered_multimap<int, long>& m, const std::unordered_multimap<int, long>& ref)
+{
+    if (m.size() != ref.size() || static_cast<size_t>(mystl::distance(m.begin(), m.end())) != ref.size())
+    {
+        return false;
+    }
+    for (int k = 0; k < 300; ++k)
+    {
+        if (values_of(m, k) != values_of(ref, k) || m.count(k) != ref.count(k))
+        {
+            return false;
+        }
+    }
+    return buckets_consistent(m);
+}
+
+}  // namespace
+
+MYSTL_TEST(unordered_map_random_ops)
+{
+    EXPECT_TRUE((check_map_random_ops<mystl::unordered_map<int, long>, int_key>(46)));
+    EXPECT_TRUE((check_map_random_ops<mystl::unordered_map<mystl::basic_string<char>, long>, string_key>(460)));
+}
+
+// 重复键较多：插入、按键删除、删除单个元素，穿插 rehash、拷贝、移动与 swap
+MYSTL_TEST(unordered_multimap_random_ops)
+{
+    std::mt19937 rng(4600);
+    mystl::unordered_multimap<int, long> m;
+    std::unordered_multimap<int, long> ref;
+    bool ok = true;
+    for (int step = 0; step < 20000 && ok; ++step)
+    {
+        const int k = static_cast<int>(rng() % 300);
+        const long v = static_cast<long>(rng() % 50);
+        switch (rng() % 8)
+        {
+        case 0:
+        case 1:
+        case 2:
+            ok = m.insert(mystl::make_pair(k, v))->first == k;
+            ref.emplace(k, v);
+            break;
+        case 3:
+            if (rng() % 4 == 0)
+            {
+                ok = m.erase(k) == ref.erase(k);
+            }
+            break;
+        case 4:
+        {
+            // 删除键 k 的一个映射值为 it->second 的元素
+            auto it = m.find(k);
+            ok = (it != m.end()) == (ref.count(k) != 0);
+            if (it != m.end())
+            {
+                const long value = it->second;
+                m.erase(it);
+                auto range = ref.equal_range(k);
+                ref.erase(std::find_if(range.first, range.second,
+                                       [value](const std::pair<const int, long>& kv) { return kv.second == value; }));
+            }
+            break;
+        }
+        case 5:
+            if (rng() % 100 == 0)
+            {
+                m.rehash(rng() % 2 == 0 ? 0 : rng() % 4096);
+            }
+            break;
+        case 6:
+            if (rng() % 200 == 0)
+            {
+                mystl::unordered_multimap<int, long> copy(m);
+                mystl::unordered_multimap<int, long> moved(mystl::move(copy));
+                ok = copy.empty() && moved == m && same_multi_content(moved, ref);
+                mystl::unordered_multimap<int, long> other;
+                other.swap(moved);
+                m = other;
+                ok = ok && moved.empty() && same_multi_content(m, ref);
+            }
+            break;
+        default:
+            ok = m.count(k) == ref.count(k);
+            break;
+        }
+        ok = ok && m.size() == ref.size();
+        if (step % 1000 == 0)
+        {
+            ok = ok && same_multi_content(m, ref);
+        }
+    }
+    EXPECT_TRUE(ok && same_multi_content(m, ref));
+}